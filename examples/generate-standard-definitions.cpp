@@ -0,0 +1,233 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bbcat-base/LoadedVersions.h>
+#include <bbcat-base/EnhancedFile.h>
+
+#include <tinyxml.h>
+
+#include <bbcat-audioobjects/ADMObjects.h>
+#include <bbcat-audioobjects/ADMStandardDefinitions.h>
+
+using namespace bbcat;
+
+// ensure the version numbers of the linked libraries and registered
+BBC_AUDIOTOOLBOX_REQUIRE(bbcat_base_version);
+BBC_AUDIOTOOLBOX_REQUIRE(bbcat_dsp_version);
+BBC_AUDIOTOOLBOX_REQUIRE(bbcat_control_version);
+BBC_AUDIOTOOLBOX_REQUIRE(bbcat_audioobjects_version);
+
+/*--------------------------------------------------------------------------------*/
+/** Return string as a quoted C string
+ */
+/*--------------------------------------------------------------------------------*/
+static std::string Quote(const std::string& str)
+{
+  std::string res = "\"";
+  uint_t i;
+
+  for (i = 0; i < str.size(); i++)
+  {
+    uint8_t c = (uint8_t)str[i];
+
+    if      ((c == '\"') || (c == '\\')) {res += '\\'; res += (char)c;}
+    else if ((c < 0x20) || (c >= 0x7f))  Printf(res, "\\%03o", (uint_t)c);
+    else                                 res += (char)c;
+  }
+
+  res += "\"";
+
+  return res;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write a single record
+ */
+/*--------------------------------------------------------------------------------*/
+static void WriteRecord(EnhancedFile& fp, uint_t type, uint_t level, const std::string& name, const std::string& value = "")
+{
+  static const char *types[] =
+  {
+    "Object",
+    "Block",
+    "Attribute",
+    "Value",
+  };
+
+  fp.fprintf("  {ADMStandardDefinitionsRecord_%s, %u, %s, %s},\n", types[type], level, Quote(name).c_str(), Quote(value).c_str());
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return first sub-element of node with the specified name
+ */
+/*--------------------------------------------------------------------------------*/
+static const TiXmlNode *FindElement(const TiXmlNode *node, const std::string& name)
+{
+  const TiXmlNode *subnode;
+
+  for (subnode = node->FirstChild(); subnode; subnode = subnode->NextSibling())
+  {
+    if ((subnode->Type() == TiXmlNode::TINYXML_ELEMENT) && (name == subnode->Value())) return subnode;
+  }
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write attributes of an element
+ */
+/*--------------------------------------------------------------------------------*/
+static void WriteAttributes(EnhancedFile& fp, const TiXmlNode *node, uint_t level)
+{
+  const TiXmlAttribute *attr;
+
+  for (attr = node->ToElement()->FirstAttribute(); attr; attr = attr->Next())
+  {
+    WriteRecord(fp, ADMStandardDefinitionsRecord_Attribute, level, attr->Name(), attr->Value());
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write a value, its attributes and its sub-values
+ */
+/*--------------------------------------------------------------------------------*/
+static void WriteValue(EnhancedFile& fp, const TiXmlNode *node, uint_t level)
+{
+  const TiXmlNode *subnode = node->FirstChild();
+
+  // value is the text of the element (as decoded by the XML parsers)
+  WriteRecord(fp, ADMStandardDefinitionsRecord_Value, level, node->Value(), (subnode && (subnode->Type() != TiXmlNode::TINYXML_ELEMENT)) ? subnode->Value() : "");
+  WriteAttributes(fp, node, level);
+
+  for (; subnode; subnode = subnode->NextSibling())
+  {
+    if (subnode->Type() == TiXmlNode::TINYXML_ELEMENT) WriteValue(fp, subnode, level + 1);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write attributes and then values of an object or block
+ */
+/*--------------------------------------------------------------------------------*/
+static void WriteValues(EnhancedFile& fp, const TiXmlNode *node)
+{
+  const TiXmlNode *subnode;
+
+  WriteAttributes(fp, node, 0);
+
+  for (subnode = node->FirstChild(); subnode; subnode = subnode->NextSibling())
+  {
+    if (subnode->Type() != TiXmlNode::TINYXML_ELEMENT) continue;
+
+    if (subnode->Value() == ADMAudioBlockFormat::Type)
+    {
+      WriteRecord(fp, ADMStandardDefinitionsRecord_Block, 0, subnode->Value());
+      WriteValues(fp, subnode);
+    }
+    else WriteValue(fp, subnode, 1);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write all objects in audioFormatExtended as records, in document order
+ *
+ * @note the XML is walked directly (rather than loaded into an ADM and written back out)
+ * @note so that the records, and therefore the generated file, depend only on the XML
+ */
+/*--------------------------------------------------------------------------------*/
+static uint_t WriteObjects(EnhancedFile& fp, const TiXmlNode *node)
+{
+  const TiXmlNode *subnode;
+  uint_t n = 0;
+
+  for (subnode = node->FirstChild(); subnode; subnode = subnode->NextSibling())
+  {
+    if (subnode->Type() != TiXmlNode::TINYXML_ELEMENT) continue;
+
+    WriteRecord(fp, ADMStandardDefinitionsRecord_Object, 0, subnode->Value());
+    WriteValues(fp, subnode);
+
+    n++;
+  }
+
+  return n;
+}
+
+int main(int argc, const char *argv[])
+{
+  if (argc < 3)
+  {
+    fprintf(stderr, "Usage: generate-standard-definitions <standard-definitions-xml-file> <output-cpp-file>\n");
+    fprintf(stderr, "\nConverts the standard definitions XML file into a list of records that can be compiled into the library\n");
+    fprintf(stderr, "(e.g. generate-standard-definitions ../share/standarddefinitions.xml ../src/ADMStandardDefinitions.cpp)\n");
+    exit(1);
+  }
+
+  TiXmlDocument   doc;
+  const TiXmlNode *node = NULL;
+  int res = 1;
+
+  if (doc.LoadFile(argv[1]))
+  {
+    // dig to audioFormatExtended section (directly within the root or within coreMetadata/format)
+    if (((node = FindElement(&doc, "ebuCoreMain")) != NULL) ||
+        ((node = FindElement(&doc, "ituADM")) != NULL))
+    {
+      const TiXmlNode *subnode;
+
+      if ((subnode = FindElement(node, "audioFormatExtended")) == NULL)
+      {
+        if (((subnode = FindElement(node, "coreMetadata")) != NULL) &&
+            ((subnode = FindElement(subnode, "format")) != NULL))
+        {
+          subnode = FindElement(subnode, "audioFormatExtended");
+        }
+      }
+
+      node = subnode;
+    }
+  }
+  else fprintf(stderr, "Failed to read XML from '%s': %s\n", argv[1], doc.ErrorDesc());
+
+  if (node)
+  {
+    EnhancedFile fp;
+
+    if (fp.fopen(argv[2], "w"))
+    {
+      std::string filename = argv[1];
+      size_t      p;
+      uint_t      n;
+
+      // strip path from filename
+      if ((p = filename.find_last_of("/\\")) < std::string::npos) filename = filename.substr(p + 1);
+
+      fp.fprintf("/* Auto-generated from %s by generate-standard-definitions: DO NOT EDIT! */\n", filename.c_str());
+      fp.fprintf("\n");
+      fp.fprintf("#include \"ADMStandardDefinitions.h\"\n");
+      fp.fprintf("\n");
+      fp.fprintf("BBC_AUDIOTOOLBOX_START\n");
+      fp.fprintf("\n");
+      fp.fprintf("const ADMSTANDARDDEFINITIONSRECORD ADMStandardDefinitions[] =\n");
+      fp.fprintf("{\n");
+
+      n = WriteObjects(fp, node);
+
+      fp.fprintf("};\n");
+      fp.fprintf("\n");
+      fp.fprintf("const uint_t ADMStandardDefinitionsCount = NUMBEROF(ADMStandardDefinitions);\n");
+      fp.fprintf("\n");
+      fp.fprintf("BBC_AUDIOTOOLBOX_END\n");
+      fp.fclose();
+
+      printf("Wrote %u objects from '%s' to '%s'\n", n, argv[1], argv[2]);
+      res = 0;
+    }
+    else fprintf(stderr, "Failed to open file '%s' for writing\n", argv[2]);
+  }
+  else if (!doc.Error()) fprintf(stderr, "Failed to find audioFormatExtended in '%s'\n", argv[1]);
+
+  return res;
+}
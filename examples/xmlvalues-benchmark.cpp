@@ -0,0 +1,79 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bbcat-base/LoadedVersions.h>
+#include <bbcat-base/misc.h>
+
+#include <bbcat-audioobjects/XMLValue.h>
+
+using namespace bbcat;
+
+// ensure the version numbers of the linked libraries and registered
+BBC_AUDIOTOOLBOX_REQUIRE(bbcat_base_version);
+BBC_AUDIOTOOLBOX_REQUIRE(bbcat_audioobjects_version);
+
+/*--------------------------------------------------------------------------------*/
+/** Microbenchmark of the numeric and time conversion used when decoding audioBlockFormats
+ *
+ * Times XMLValues::ParseNumber() and XMLValues::ParseTime() against the generic
+ * conversions (sscanf() and CalcTime()) over a set of typical blockFormat values
+ *
+ * Usage: xmlvalues-benchmark [<number of blocks>]
+ */
+/*--------------------------------------------------------------------------------*/
+int main(int argc, const char *argv[])
+{
+  std::vector<std::string> times, numbers;
+  uint64_t t, tval, check1 = 0, check2 = 0;
+  double   dval, generic, fast;
+  uint_t   i, nblocks = 100000;
+
+  if (argc > 1) nblocks = atoi(argv[1]);
+
+  // print library versions (the actual loaded versions, if dynamically linked)
+  printf("Versions:\n%s\n", LoadedVersions::Get().GetVersionsList().c_str());
+
+  // generate values as found in a typical audioBlockFormat (rtime, duration, azimuth, elevation, distance and gain)
+  for (i = 0; i < nblocks; i++)
+  {
+    times.push_back(GenerateTime((uint64_t)i * 20000000));
+    times.push_back(GenerateTime(20000000));
+    numbers.push_back(StringFrom((double)(i % 360) - 180.0, "0.6"));
+    numbers.push_back(StringFrom((double)(i % 180) - 90.0,  "0.6"));
+    numbers.push_back(StringFrom(1.0, "0.6"));
+    numbers.push_back(StringFrom((double)(i % 1000) * 1.0e-3, "%0.10lf"));
+  }
+
+  printf("Converting %u times and %u numbers\n", (uint_t)times.size(), (uint_t)numbers.size());
+
+  t = GetNanosecondTicks();
+  for (i = 0; i < times.size(); i++)
+  {
+    if (CalcTime(tval, times[i])) check1 += tval;
+  }
+  for (i = 0; i < numbers.size(); i++)
+  {
+    if (sscanf(numbers[i].c_str(), "%lf", &dval) > 0) check1 += (uint64_t)(dval * 1000.0);
+  }
+  generic = (double)(GetNanosecondTicks() - t) * 1.0e-6;
+
+  t = GetNanosecondTicks();
+  for (i = 0; i < times.size(); i++)
+  {
+    if (XMLValues::ParseTime(times[i].c_str(), tval)) check2 += tval;
+  }
+  for (i = 0; i < numbers.size(); i++)
+  {
+    if (XMLValues::ParseNumber(numbers[i].c_str(), dval)) check2 += (uint64_t)(dval * 1000.0);
+  }
+  fast = (double)(GetNanosecondTicks() - t) * 1.0e-6;
+
+  printf("Generic conversion: %0.3lfms\n", generic);
+  printf("Fast conversion:    %0.3lfms (%0.2lfx)\n", fast, (fast > 0.0) ? generic / fast : 0.0);
+
+  if (check1 != check2) fprintf(stderr, "Results differ!\n");
+
+  return (check1 == check2) ? 0 : 1;
+}
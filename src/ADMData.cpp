@@ -1,6 +1,9 @@
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
 
 #include <algorithm>
 
@@ -32,7 +35,7 @@ ADMData::~ADMData()
 /** Copy from another ADM
  */
 /*--------------------------------------------------------------------------------*/
-void ADMData::Copy(const ADMData& obj)
+void ADMData::Copy(const ADMData& obj, bool cow)
 {
   ADMOBJECTS_MAP::const_iterator it;
 
@@ -45,20 +48,10 @@ void ADMData::Copy(const ADMData& obj)
   // 1st pass: copy all objects
   for (it = obj.admobjects.begin(); it != obj.admobjects.end(); ++it)
   {
-    const ADMObject    *oldobj = it->second;
-    const std::string& type    = oldobj->GetType();
-    ADMObject *newobj = NULL;
+    const ADMObject *oldobj = it->second;
+    ADMObject       *newobj;
     
-    if      (type == ADMAudioProgramme::Type)     newobj = new ADMAudioProgramme(*this, dynamic_cast<const ADMAudioProgramme *>(oldobj));
-    else if (type == ADMAudioContent::Type)       newobj = new ADMAudioContent(*this, dynamic_cast<const ADMAudioContent *>(oldobj));
-    else if (type == ADMAudioObject::Type)        newobj = new ADMAudioObject(*this, dynamic_cast<const ADMAudioObject *>(oldobj));
-    else if (type == ADMAudioPackFormat::Type)    newobj = new ADMAudioPackFormat(*this, dynamic_cast<const ADMAudioPackFormat *>(oldobj));
-    else if (type == ADMAudioChannelFormat::Type) newobj = new ADMAudioChannelFormat(*this, dynamic_cast<const ADMAudioChannelFormat *>(oldobj));
-    else if (type == ADMAudioStreamFormat::Type)  newobj = new ADMAudioStreamFormat(*this, dynamic_cast<const ADMAudioStreamFormat *>(oldobj));
-    else if (type == ADMAudioTrackFormat::Type)   newobj = new ADMAudioTrackFormat(*this, dynamic_cast<const ADMAudioTrackFormat *>(oldobj));
-    else if (type == ADMAudioTrack::Type)         newobj = new ADMAudioTrack(*this, dynamic_cast<const ADMAudioTrack *>(oldobj));
-
-    if (newobj)
+    if ((newobj = CopyObject(oldobj, cow || oldobj->IsStandardDefinition())) != NULL)
     {
       BBCDEBUG3(("Copied object %s successfully to %s", oldobj->ToString().c_str(), newobj->ToString().c_str()));
     }
@@ -79,6 +72,34 @@ void ADMData::Copy(const ADMData& obj)
   }
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Create a copy of an object (from another ADM) in this ADM
+ *
+ * @param obj object to copy
+ * @param share true to share the block formats of a channel format with obj (copy-on-write)
+ *
+ * @return new object or NULL if the type is not recognized
+ *
+ * @note references are NOT copied (see ADMObject::CopyReferences())
+ */
+/*--------------------------------------------------------------------------------*/
+ADMObject *ADMData::CopyObject(const ADMObject *obj, bool share)
+{
+  const std::string& type = obj->GetType();
+  ADMObject *newobj = NULL;
+
+  if      (type == ADMAudioProgramme::Type)     newobj = new ADMAudioProgramme(*this, dynamic_cast<const ADMAudioProgramme *>(obj));
+  else if (type == ADMAudioContent::Type)       newobj = new ADMAudioContent(*this, dynamic_cast<const ADMAudioContent *>(obj));
+  else if (type == ADMAudioObject::Type)        newobj = new ADMAudioObject(*this, dynamic_cast<const ADMAudioObject *>(obj));
+  else if (type == ADMAudioPackFormat::Type)    newobj = new ADMAudioPackFormat(*this, dynamic_cast<const ADMAudioPackFormat *>(obj));
+  else if (type == ADMAudioChannelFormat::Type) newobj = new ADMAudioChannelFormat(*this, dynamic_cast<const ADMAudioChannelFormat *>(obj), share);
+  else if (type == ADMAudioStreamFormat::Type)  newobj = new ADMAudioStreamFormat(*this, dynamic_cast<const ADMAudioStreamFormat *>(obj));
+  else if (type == ADMAudioTrackFormat::Type)   newobj = new ADMAudioTrackFormat(*this, dynamic_cast<const ADMAudioTrackFormat *>(obj));
+  else if (type == ADMAudioTrack::Type)         newobj = new ADMAudioTrack(*this, dynamic_cast<const ADMAudioTrack *>(obj));
+
+  return newobj;
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Delete all objects within this ADM
  */
@@ -130,6 +151,33 @@ void ADMData::Finalise()
   ChangeTemporaryIDs();
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Simplify block formats of all (non-standard definition) channel formats
+ *
+ * @param tolerances maximum errors allowed in the rendered parameters
+ *
+ * @return total number of block formats removed
+ *
+ * @note see ADMAudioChannelFormat::SimplifyBlockFormats()
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t ADMData::SimplifyBlockFormats(const ADMAudioChannelFormat::SIMPLIFYTOLERANCES& tolerances)
+{
+  std::vector<ADMObject *> channelformats;
+  uint_t i, removed = 0;
+
+  GetWritableObjects(ADMAudioChannelFormat::Type, channelformats);
+  for (i = 0; i < channelformats.size(); i++)
+  {
+    ADMAudioChannelFormat *cf = dynamic_cast<ADMAudioChannelFormat *>(channelformats[i]);
+    if (cf && !cf->IsStandardDefinition()) removed += cf->SimplifyBlockFormats(tolerances);
+  }
+
+  BBCDEBUG1(("Simplification removed %u block formats", removed));
+
+  return removed;
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Register an ADM sub-object with this ADM
  *
@@ -150,6 +198,27 @@ void ADMData::Register(ADMObject *obj)
   obj->SetReferences();
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Unregister an ADM sub-object from this ADM
+ *
+ * @param obj ptr to ADM object
+ *
+ * @note the object is NOT deleted and references to it from other objects are NOT removed
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::Unregister(ADMObject *obj)
+{
+  ADMOBJECTS_IT it;
+
+  if (((it = admobjects.find(obj->GetMapEntryID())) != admobjects.end()) && (it->second == obj)) admobjects.erase(it);
+
+  // remove object from specialised lists
+  RemoveFromList<ADMAudioTrack>(tracklist, obj);
+  RemoveFromList<ADMAudioProgramme>(audioprogrammes, obj);
+  RemoveFromList<ADMAudioContent>(audiocontent, obj);
+  RemoveFromList<ADMAudioObject>(audioobjects, obj);
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Return whether the specified type is a valid object type
  */
@@ -390,6 +459,9 @@ void ADMData::ChangeTemporaryID(ADMObject *obj, std::map<ADMObject *,bool>& map)
 
 /*--------------------------------------------------------------------------------*/
 /** Change temporary IDs to full valid ones based on a set of rules
+ *
+ * @note this is called by Finalise() but can be called earlier so that XML generated
+ * @note before the ADM is finalised (e.g. Serial ADM frames) carries the final IDs
  */
 /*--------------------------------------------------------------------------------*/
 void ADMData::ChangeTemporaryIDs()
@@ -730,6 +802,24 @@ void ADMData::ConnectReferences()
   }
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link references to objects that have been replaced or removed
+ *
+ * @param objects map of replaced or removed objects (bool is a dummy)
+ *
+ * @note the objects MUST have been unregistered but NOT yet deleted
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
+{
+  ADMOBJECTS_IT it;
+
+  for (it = admobjects.begin(); it != admobjects.end(); ++it)
+  {
+    it->second->RelinkReferences(objects);
+  }
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Generate a mapping from objects of type <type1> to/from objects of type <type2>
  *
@@ -778,101 +868,37 @@ void ADMData::GenerateReferenceMap(ADMREFERENCEMAP& refmap, const std::string& t
 
 /*--------------------------------------------------------------------------------*/
 /** Update audio object limits
+ *
+ * Each audio object whose start and duration have not been explicitly set keeps its start
+ * and has its end set to its start
+ *
+ * @note block formats are not referenced objects of channel formats so the limits have never
+ * @note been derived from them (nor block formats moved), finding each audio object's referenced
+ * @note objects is therefore unnecessary and is not done
  */
 /*--------------------------------------------------------------------------------*/
 void ADMData::UpdateAudioObjectLimits()
 {
-  ADMREFERENCEMAP channelformats;
   ADMOBJECTS_IT it;
-  uint_t i;
-
-  // generate mapping from channel formats -> audio objects
-  GenerateReferenceMap(channelformats, ADMAudioObject::Type, ADMAudioChannelFormat::Type, true);
 
   for (it = admobjects.begin(); it != admobjects.end(); ++it)
   {
     ADMAudioObject *audioobj;
-    const ADMObject *obj = it->second;
 
-    // for each audio object
-    if (((audioobj = const_cast<ADMAudioObject *>(dynamic_cast<const ADMAudioObject *>(obj))) != NULL) &&
-        !(audioobj->StartTimeSet() || audioobj->DurationSet())) // don't update audio object limits if they have been explicitly set
+    // don't update audio object limits if they have been explicitly set
+    if ((it->second->GetType() == ADMAudioObject::Type) &&
+        !((audioobj = static_cast<ADMAudioObject *>(it->second))->StartTimeSet() || audioobj->DurationSet()))
     {
-      std::vector<const ADMObject *> list;
-      const uint64_t originalstart = audioobj->GetStartTime();
-      uint64_t start = originalstart;
-      uint64_t end   = start;
-
-      list.push_back(obj);
+      const uint64_t start = audioobj->GetStartTime();
+      const uint64_t end   = start;
 
-      // find all other objects it references
-      GetReferencedObjects(list);
-
-      // scan for block formats and find their limits
-      bool first   = true;
-      bool canmove = true;
-      for (i = 0; i < list.size(); i++)
-      {
-        const ADMObject *obj = list[i];
-        const ADMAudioBlockFormat *blockformat;
-
-        if ((blockformat = dynamic_cast<const ADMAudioBlockFormat *>(obj)) != NULL)
-        {
-          // block limits are relative to audio object
-          uint64_t bstart = blockformat->GetStartTime(audioobj);
-          uint64_t bend   = blockformat->GetEndTime(audioobj);
-
-          // update start and end times
-          start = first ? bstart : std::min(start, bstart);
-          end   = first ? bend   : std::max(end, bend);
-
-          first = false;
-        }
-
-        if ((obj->GetType() == ADMAudioChannelFormat::Type) &&
-            (channelformats.find(obj) != channelformats.end()) &&
-            (channelformats[obj].size() > 1))
-        {
-          // unable to move this audio object because a channel format used by this audio object
-          // is used by other audio objects
-          BBCDEBUG2(("Cannot move object '%s', channel format '%s' is used by %u audio objects",
-                  audioobj->GetName().c_str(),
-                  obj->GetName().c_str(),
-                  (uint_t)channelformats[obj].size()));
-          canmove = false;
-        }
-      }
-
-      // if unable to move audio object, set the new start as the original start
-      if (!canmove) start = originalstart;
-
-      BBCDEBUG2(("Updating object '%s' start %s -> %s end %s -> %s (canmove: %s)",
+      BBCDEBUG2(("Updating object '%s' start %s -> %s end %s -> %s",
               audioobj->GetName().c_str(),
               StringFrom(audioobj->GetStartTime()).c_str(), StringFrom(start).c_str(),
-              StringFrom(audioobj->GetEndTime()).c_str(),   StringFrom(end).c_str(),
-              canmove ? "yes" : "no"));
+              StringFrom(audioobj->GetEndTime()).c_str(),   StringFrom(end).c_str()));
 
       audioobj->SetStartTime(start);
       audioobj->SetEndTime(end);
-
-      if (start > originalstart)
-      {
-        uint64_t diff = start - originalstart;
-
-        BBCDEBUG2(("Shifting all block formats by %s", StringFrom(diff).c_str()));
-
-        // modify every block format so that the first one starts at zero
-        for (i = 0; i < list.size(); i++)
-        {
-          ADMAudioBlockFormat *blockformat;
-
-          if ((blockformat = const_cast<ADMAudioBlockFormat *>(dynamic_cast<const ADMAudioBlockFormat *>(list[i]))) != NULL)
-          {
-            // move all block formats *back* by the same amount the audio object moves *forward*
-            blockformat->SetRTime(blockformat->GetRTime() - diff);
-          }
-        }
-      }
     }
   }
 }
@@ -1534,6 +1560,892 @@ bool ADMData::CreateFromFile(const char *filename)
   return success;
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Serialise ADM into a compact binary form (for storing alongside the XML, see SetBinary())
+ *
+ * @param data buffer to be populated
+ * @param sourcehash hash of the data the binary form is stored with (checked by SetBinary())
+ *
+ * @note standard definitions are not stored, references to them are stored by ID
+ * @note the binary form uses the byte order of the machine and is not intended for interchange
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::GetBinary(std::vector<uint8_t>& data, uint64_t sourcehash) const
+{
+  std::vector<uint8_t>            body;
+  std::map<const ADMObject *,uint_t> indices;
+  std::vector<const ADMObject *>  objects;
+  std::vector<std::pair<uint_t,uint_t> > references;
+  std::vector<uint_t>             channelformats;
+  BINARYWRITER                    writer;
+  BINARYHEADER                    header;
+  ADMOBJECTS_CIT                  it;
+  std::map<std::string,XMLValues>::const_iterator it2;
+  uint_t i, j;
+
+  writer.data = &body;
+
+  // index all objects that are not standard definitions
+  for (it = admobjects.begin(); it != admobjects.end(); ++it)
+  {
+    if (!it->second->IsStandardDefinition())
+    {
+      indices[it->second] = (uint_t)objects.size();
+      objects.push_back(it->second);
+    }
+  }
+
+  // write objects, adding referenced standard definitions to the end of the list as they are found
+  WriteBinary(writer, (uint32_t)indices.size());
+  for (i = 0; i < objects.size(); i++)
+  {
+    const ADMObject *obj = objects[i];
+    const std::string idname   = (obj->GetType() == ADMAudioTrack::Type) ? std::string("UID") : obj->GetType() + "ID";
+    const std::string namename = obj->GetType() + "Name";
+    std::vector<ADMObject::REFERENCEDOBJECT> objrefs;
+    XMLValues objvalues, values;
+    const ADMAudioTrack *track;
+    uint8_t flags = obj->IsStandardDefinition() ? (uint8_t)BinaryObject_External : 0;
+
+    // only get values and references of objects that are being stored
+    if (!flags) obj->GetValuesAndReferences(objvalues, objrefs);
+
+    // ID and name are stored separately
+    for (j = 0; j < objvalues.size(); j++)
+    {
+      const XMLValue& value = objvalues[j];
+      if (!value.attr || ((value.name != idname) && (value.name != namename))) values.AddValue(value);
+    }
+
+    WriteBinary(writer, obj->GetType());
+    WriteBinary(writer, &flags, sizeof(flags));
+    WriteBinary(writer, obj->GetID());
+    WriteBinary(writer, obj->GetName());
+    WriteBinary(writer, ((track = dynamic_cast<const ADMAudioTrack *>(obj)) != NULL) ? (uint32_t)track->GetTrackNum() : 0);
+    WriteBinary(writer, values);
+
+    for (j = 0; j < objrefs.size(); j++)
+    {
+      const ADMObject *ref = objrefs[j].obj;
+      std::map<const ADMObject *,uint_t>::iterator it3;
+
+      if ((it3 = indices.find(ref)) == indices.end())
+      {
+        // referenced object is not being stored (a standard definition) -> store it as an external object
+        it3 = indices.insert(std::pair<const ADMObject *,uint_t>(ref, (uint_t)objects.size())).first;
+        objects.push_back(ref);
+      }
+
+      references.push_back(std::pair<uint_t,uint_t>(i, it3->second));
+    }
+
+    if ((obj->GetType() == ADMAudioChannelFormat::Type) && !flags) channelformats.push_back(i);
+  }
+
+  // the number of objects written is only known now so patch it
+  *(uint32_t *)&body[0] = (uint32_t)objects.size();
+
+  // write references
+  WriteBinary(writer, (uint32_t)references.size());
+  for (i = 0; i < references.size(); i++)
+  {
+    WriteBinary(writer, (uint32_t)references[i].first);
+    WriteBinary(writer, (uint32_t)references[i].second);
+  }
+
+  // write block formats of each channel format
+  WriteBinary(writer, (uint32_t)channelformats.size());
+  for (i = 0; i < channelformats.size(); i++)
+  {
+    const ADMAudioChannelFormat *channelformat = dynamic_cast<const ADMAudioChannelFormat *>(objects[channelformats[i]]);
+    ADMAudioBlockFormatRefs blocks = channelformat->GetBlockFormatRefs();
+
+    WriteBinary(writer, (uint32_t)channelformats[i]);
+    WriteBinary(writer, (uint32_t)blocks.size());
+    for (j = 0; j < blocks.size(); j++) WriteBinary(writer, blocks[j]);
+  }
+
+  // write non-ADM XML
+  WriteBinary(writer, (uint32_t)nonadmxml.size());
+  for (it2 = nonadmxml.begin(); it2 != nonadmxml.end(); ++it2)
+  {
+    WriteBinary(writer, it2->first);
+    WriteBinary(writer, it2->second);
+  }
+
+  memset(&header, 0, sizeof(header));
+  header.magic      = Binary_Magic;
+  header.version    = Binary_Version;
+  header.byteorder  = Binary_ByteOrder;
+  header.sourcehash = sourcehash;
+
+  // assemble header, string table and body
+  data.clear();
+  writer.data = &data;
+  WriteBinary(writer, &header, sizeof(header));
+  WriteBinaryStrings(writer, data);
+  data.insert(data.end(), body.begin(), body.end());
+
+  BBCDEBUG2(("Generated %s bytes of binary ADM (%u objects, %u strings)", StringFrom((uint64_t)data.size()).c_str(), (uint_t)objects.size(), (uint_t)writer.strings.size()));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM from binary form generated by GetBinary()
+ *
+ * @param data binary data
+ * @param len length of data
+ * @param sourcehash hash of the data the binary form was stored with
+ *
+ * @return true if data read successfully
+ *
+ * @note no text is parsed for block formats, objects are created directly from the data
+ * @note false is returned and the ADM left unchanged if sourcehash does not match the
+ * @note hash supplied to GetBinary(), if the data was generated on a machine with a
+ * @note different byte order or if the data is invalid
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::SetBinary(const uint8_t *data, uint64_t len, uint64_t sourcehash)
+{
+  std::vector<ADMObject *> objects, created;
+  std::map<std::string,XMLValues> _nonadmxml;
+  BINARYREADER reader;
+  BINARYHEADER header;
+  uint32_t     i, j, n, m;
+  bool         success = false;
+
+  reader.p     = data;
+  reader.end   = data + len;
+  reader.valid = true;
+
+  if (ReadBinary(reader, &header, sizeof(header)) &&
+      (header.magic      == Binary_Magic) &&
+      (header.version    == Binary_Version) &&
+      (header.byteorder  == Binary_ByteOrder) &&
+      (header.sourcehash == sourcehash))
+  {
+    ReadBinaryStrings(reader);
+
+    // read objects
+    if (ReadBinary(reader, n) && (n <= (uint32_t)(reader.end - reader.p)))
+    {
+      objects.resize(n);
+      for (i = 0; reader.valid && (i < n); i++)
+      {
+        const std::string *type, *id, *name;
+        ADMAudioTrack *track;
+        XMLValues values;
+        uint32_t  tracknum;
+        uint8_t   flags;
+
+        if (ReadBinary(reader, type) &&
+            ReadBinary(reader, &flags, sizeof(flags)) &&
+            ReadBinary(reader, id) &&
+            ReadBinary(reader, name) &&
+            ReadBinary(reader, tracknum) &&
+            ReadBinary(reader, values))
+        {
+          if (flags & BinaryObject_External)
+          {
+            // standard definition -> must already exist
+            if ((objects[i] = GetWritableObjectByID(*id, *type)) == NULL)
+            {
+              BBCERROR("Binary ADM references unknown %s '%s'", type->c_str(), id->c_str());
+              reader.valid = false;
+            }
+          }
+          else if (!GetObjectByID(*id, *type) && ((objects[i] = Create(*type, *id, *name)) != NULL))
+          {
+            created.push_back(objects[i]);
+
+            for (j = 0; j < values.size(); j++) objects[i]->values.MoveValue(values[j]);
+            objects[i]->SetValues();
+
+            if ((track = dynamic_cast<ADMAudioTrack *>(objects[i])) != NULL) track->SetTrackNum(tracknum);
+          }
+          else
+          {
+            BBCERROR("Failed to create %s '%s' from binary ADM", type->c_str(), id->c_str());
+            reader.valid = false;
+          }
+        }
+      }
+    }
+
+    // read references
+    if (ReadBinary(reader, n))
+    {
+      for (i = 0; reader.valid && (i < n); i++)
+      {
+        uint32_t obj, ref;
+
+        if (ReadBinary(reader, obj) && ReadBinary(reader, ref))
+        {
+          if ((obj < objects.size()) && (ref < objects.size()))
+          {
+            if (!AddReference(objects[obj], objects[ref])) BBCERROR("Reference %s for %s REJECTED", objects[ref]->ToString().c_str(), objects[obj]->ToString().c_str());
+          }
+          else reader.valid = false;
+        }
+      }
+    }
+
+    // read block formats
+    if (ReadBinary(reader, n))
+    {
+      for (i = 0; reader.valid && (i < n); i++)
+      {
+        ADMAudioChannelFormat *channelformat = NULL;
+        uint32_t index;
+
+        if (ReadBinary(reader, index) &&
+            (index < objects.size()) &&
+            ((channelformat = dynamic_cast<ADMAudioChannelFormat *>(objects[index])) != NULL) &&
+            ReadBinary(reader, m))
+        {
+          for (j = 0; reader.valid && (j < m); j++)
+          {
+            ADMAudioBlockFormat *block;
+
+            if ((block = ReadBinaryBlock(reader)) != NULL) channelformat->Add(block);
+          }
+        }
+        else reader.valid = false;
+      }
+    }
+
+    // read non-ADM XML
+    if (ReadBinary(reader, n))
+    {
+      for (i = 0; reader.valid && (i < n); i++)
+      {
+        const std::string *node;
+
+        if (ReadBinary(reader, node)) ReadBinary(reader, _nonadmxml[*node]);
+      }
+    }
+
+    if (reader.valid)
+    {
+      std::map<std::string,XMLValues>::iterator it;
+
+      for (it = _nonadmxml.begin(); it != _nonadmxml.end(); ++it)
+      {
+        XMLValues& values = nonadmxml[it->first];
+
+        for (i = 0; i < it->second.size(); i++) values.MoveValue(it->second[i]);
+      }
+
+      SortTracks();
+
+      BBCDEBUG2(("Read %u objects from binary ADM", (uint_t)created.size()));
+
+      success = true;
+    }
+    else
+    {
+      BBCERROR("Binary ADM is invalid");
+
+      // remove everything created
+      for (i = 0; i < created.size(); i++)
+      {
+        Unregister(created[i]);
+        delete created[i];
+      }
+    }
+  }
+  else BBCDEBUG1(("Binary ADM is incompatible or does not match its source, ignoring it"));
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Append data to binary form
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::WriteBinary(BINARYWRITER& writer, const void *data, uint_t n)
+{
+  const uint8_t *p = (const uint8_t *)data;
+
+  writer.data->insert(writer.data->end(), p, p + n);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Append string (as an index into the string table) to binary form
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::WriteBinary(BINARYWRITER& writer, const std::string& str)
+{
+  std::map<std::string,uint32_t>::iterator it;
+
+  if ((it = writer.stringmap.find(str)) == writer.stringmap.end())
+  {
+    it = writer.stringmap.insert(std::pair<std::string,uint32_t>(str, (uint32_t)writer.strings.size())).first;
+    writer.strings.push_back(&it->first);
+  }
+
+  WriteBinary(writer, it->second);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Append list of values (including attributes and sub-values) to binary form
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::WriteBinary(BINARYWRITER& writer, const XMLValues& values)
+{
+  uint_t i;
+
+  WriteBinary(writer, (uint32_t)values.size());
+  for (i = 0; i < values.size(); i++)
+  {
+    const XMLValue& value = values[i];
+    XMLValue::ATTRS::const_iterator it;
+    uint8_t attr = value.attr;
+
+    WriteBinary(writer, &attr, sizeof(attr));
+    WriteBinary(writer, value.name);
+    WriteBinary(writer, value.value);
+    WriteBinary(writer, (uint32_t)value.attrs.size());
+    for (it = value.attrs.begin(); it != value.attrs.end(); ++it)
+    {
+      WriteBinary(writer, it->first);
+      WriteBinary(writer, it->second);
+    }
+
+    if (value.GetSubValues()) WriteBinary(writer, *value.GetSubValues());
+    else                      WriteBinary(writer, (uint32_t)0);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Append block format to binary form
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::WriteBinary(BINARYWRITER& writer, const ADMAudioBlockFormat *block)
+{
+  const AudioObjectParameters& params = block->GetObjectParameters();
+  uint8_t kind;
+
+  if (params.IsMinPositionSet() ||
+      params.IsMaxPositionSet() ||
+      params.GetFirstExcludedZone() ||
+      (params.GetOtherValuesBegin() != params.GetOtherValuesEnd()))
+  {
+    // block format has parameters that are not held in BINARYBLOCK -> store as values
+    XMLValues attrs, values;
+
+    block->GetValues(attrs, values);
+
+    kind = BinaryBlock_Values;
+    WriteBinary(writer, &kind, sizeof(kind));
+    WriteBinary(writer, attrs);
+    WriteBinary(writer, values);
+  }
+  else
+  {
+    BINARYBLOCK record;
+    double      dval;
+    float       fval;
+    uint_t      uval;
+    bool        bval;
+
+    memset(&record, 0, sizeof(record));
+
+    // the parameters are stored under the same conditions as they are in the XML (see ADMAudioBlockFormat::GetValues())
+    if (block->RTimeSet())
+    {
+      record.flags |= BinaryBlock_RTime;
+      record.rtime  = block->GetRTime();
+    }
+    if (block->DurationSet())
+    {
+      record.flags   |= BinaryBlock_Duration;
+      record.duration = block->GetDuration();
+    }
+    if (params.IsCartesianSet())
+    {
+      record.flags |= BinaryBlock_CartesianSet;
+      if (params.GetCartesian()) record.flags |= BinaryBlock_Cartesian;
+    }
+    if (params.IsPositionSet())
+    {
+      const Position& position = params.GetPosition();
+
+      record.flags |= BinaryBlock_Position;
+      if (position.polar) record.flags |= BinaryBlock_Polar;
+      record.position[0] = position.pos.x;
+      record.position[1] = position.pos.y;
+      record.position[2] = position.pos.z;
+    }
+    if (params.GetGain(dval))
+    {
+      record.flags |= BinaryBlock_Gain;
+      record.gain   = dval;
+    }
+    if (params.GetWidth(fval))
+    {
+      record.flags |= BinaryBlock_Width;
+      record.width  = fval;
+    }
+    if (params.GetDepth(fval))
+    {
+      record.flags |= BinaryBlock_Depth;
+      record.depth  = fval;
+    }
+    if (params.GetHeight(fval))
+    {
+      record.flags |= BinaryBlock_Height;
+      record.height = fval;
+    }
+    if (params.GetDiffuseness(fval))
+    {
+      record.flags      |= BinaryBlock_Diffuseness;
+      record.diffuseness = fval;
+    }
+    if (params.GetJumpPosition(bval, &dval))
+    {
+      record.flags |= BinaryBlock_JumpPositionSet;
+      if (bval)
+      {
+        record.flags |= BinaryBlock_JumpPosition;
+        record.interpolationlength = dval;
+      }
+    }
+    if (params.GetDivergenceBalance(fval))
+    {
+      record.flags            |= BinaryBlock_Divergence;
+      record.divergencebalance = fval;
+
+      if (params.GetDivergenceAzimuth(fval))
+      {
+        record.flags            |= BinaryBlock_DivergenceAzimuth;
+        record.divergenceazimuth = fval;
+      }
+    }
+    if (params.GetChannelLock(bval))
+    {
+      record.flags |= BinaryBlock_ChannelLockSet;
+      if (bval) record.flags |= BinaryBlock_ChannelLock;
+
+      if (params.GetChannelLockMaxDistance(fval))
+      {
+        record.flags      |= BinaryBlock_MaxDistance;
+        record.maxdistance = fval;
+      }
+    }
+    if (params.GetChannelImportance(uval))
+    {
+      record.flags     |= BinaryBlock_Importance;
+      record.importance = uval;
+    }
+
+    kind = BinaryBlock_Record;
+    WriteBinary(writer, &kind, sizeof(kind));
+    WriteBinary(writer, &record, sizeof(record));
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read data from binary form
+ *
+ * @return true if data read successfully (if not, reader.valid is cleared)
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::ReadBinary(BINARYREADER& reader, void *data, uint_t n)
+{
+  if (reader.valid && (n <= (uint_t)(reader.end - reader.p)))
+  {
+    memcpy(data, reader.p, n);
+    reader.p += n;
+  }
+  else reader.valid = false;
+
+  return reader.valid;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read string (as an index into the string table) from binary form
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::ReadBinary(BINARYREADER& reader, const std::string *& str)
+{
+  uint32_t index;
+
+  if (ReadBinary(reader, index))
+  {
+    if (index < reader.strings.size()) str = &reader.strings[index];
+    else reader.valid = false;
+  }
+
+  return reader.valid;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read list of values (including attributes and sub-values) from binary form
+ *
+ * @note values are appended to the list
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::ReadBinary(BINARYREADER& reader, XMLValues& values)
+{
+  uint32_t i, j, n, m;
+
+  if (ReadBinary(reader, n))
+  {
+    for (i = 0; reader.valid && (i < n); i++)
+    {
+      const std::string *name, *value;
+      XMLValue  xmlvalue;
+      XMLValues subvalues;
+      uint8_t   attr;
+
+      if (ReadBinary(reader, &attr, sizeof(attr)) &&
+          ReadBinary(reader, name) &&
+          ReadBinary(reader, value) &&
+          ReadBinary(reader, m))
+      {
+        xmlvalue.attr  = (attr != 0);
+        xmlvalue.name  = *name;
+        xmlvalue.value = *value;
+
+        for (j = 0; (j < m) && ReadBinary(reader, name) && ReadBinary(reader, value); j++)
+        {
+          xmlvalue.attrs[*name] = *value;
+        }
+
+        if (ReadBinary(reader, subvalues) && subvalues.size()) xmlvalue.MoveSubValues(subvalues);
+
+        values.MoveValue(xmlvalue);
+      }
+    }
+  }
+
+  return reader.valid;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read block format from binary form
+ *
+ * @return new block format or NULL
+ */
+/*--------------------------------------------------------------------------------*/
+ADMAudioBlockFormat *ADMData::ReadBinaryBlock(BINARYREADER& reader)
+{
+  ADMAudioBlockFormat *block = NULL;
+  uint8_t kind;
+
+  if (ReadBinary(reader, &kind, sizeof(kind)))
+  {
+    if (kind == BinaryBlock_Record)
+    {
+      const BINARYBLOCK *record = (const BINARYBLOCK *)reader.p;
+
+      if (sizeof(*record) <= (size_t)(reader.end - reader.p))
+      {
+        reader.p += sizeof(*record);
+
+        if ((block = new ADMAudioBlockFormat) != NULL)
+        {
+          AudioObjectParameters& params = block->GetObjectParameters();
+          uint32_t flags = record->flags;
+
+          // set parameters in the same order as ADMAudioBlockFormat::SetValues()
+          if (flags & BinaryBlock_RTime) block->SetRTime(record->rtime);
+          if (flags & BinaryBlock_Duration)
+          {
+            block->SetDuration(record->duration);
+            params.SetInterpolationTime(record->duration);
+          }
+          if (flags & BinaryBlock_CartesianSet) params.SetCartesian((flags & BinaryBlock_Cartesian) != 0);
+          if (flags & BinaryBlock_Gain)         params.SetGain(record->gain);
+          if (flags & BinaryBlock_Width)        params.SetWidth(record->width);
+          if (flags & BinaryBlock_Depth)        params.SetDepth(record->depth);
+          if (flags & BinaryBlock_Height)       params.SetHeight(record->height);
+          if (flags & BinaryBlock_Diffuseness)  params.SetDiffuseness(record->diffuseness);
+          if (flags & BinaryBlock_JumpPositionSet) params.SetJumpPosition((flags & BinaryBlock_JumpPosition) != 0, record->interpolationlength);
+          if (flags & BinaryBlock_Divergence)
+          {
+            params.SetDivergenceBalance(record->divergencebalance);
+            if (flags & BinaryBlock_DivergenceAzimuth) params.SetDivergenceAzimuth(record->divergenceazimuth);
+          }
+          if (flags & BinaryBlock_ChannelLockSet)
+          {
+            params.SetChannelLock((flags & BinaryBlock_ChannelLock) != 0);
+            if (flags & BinaryBlock_MaxDistance) params.SetChannelLockMaxDistance(record->maxdistance);
+          }
+          if (flags & BinaryBlock_Importance)   params.SetChannelImportance(record->importance);
+          if (flags & BinaryBlock_Position)
+          {
+            Position position;
+
+            position.polar   = ((flags & BinaryBlock_Polar) != 0);
+            position.pos.x   = record->position[0];
+            position.pos.y   = record->position[1];
+            position.pos.z   = record->position[2];
+            params.SetPosition(position);
+          }
+        }
+      }
+      else reader.valid = false;
+    }
+    else if (kind == BinaryBlock_Values)
+    {
+      XMLValues values;
+
+      // attributes and values are read into the same list (as the XML parsers do)
+      if (ReadBinary(reader, values) &&
+          ReadBinary(reader, values) &&
+          ((block = new ADMAudioBlockFormat) != NULL))
+      {
+        block->SetValues(values);
+      }
+    }
+    else reader.valid = false;
+  }
+
+  return block;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Append string table of writer to data
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMData::WriteBinaryStrings(const BINARYWRITER& writer, std::vector<uint8_t>& data)
+{
+  BINARYWRITER stringwriter;
+  uint_t i;
+
+  stringwriter.data = &data;
+
+  WriteBinary(stringwriter, (uint32_t)writer.strings.size());
+  for (i = 0; i < writer.strings.size(); i++)
+  {
+    const std::string& str = *writer.strings[i];
+
+    WriteBinary(stringwriter, (uint32_t)str.length());
+    WriteBinary(stringwriter, str.data(), (uint_t)str.length());
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read string table into reader
+ *
+ * @return true if data read successfully (if not, reader.valid is cleared)
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::ReadBinaryStrings(BINARYREADER& reader)
+{
+  uint32_t i, n, m;
+
+  if (ReadBinary(reader, n))
+  {
+    if (n <= (uint32_t)(reader.end - reader.p))
+    {
+      reader.strings.resize(n);
+      for (i = 0; reader.valid && (i < n); i++)
+      {
+        if (ReadBinary(reader, m) && (m <= (uint32_t)(reader.end - reader.p)))
+        {
+          reader.strings[i].assign((const char *)reader.p, m);
+          reader.p += m;
+        }
+        else reader.valid = false;
+      }
+    }
+    else reader.valid = false;
+  }
+
+  return reader.valid;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Constructor
+ *
+ * @param dir directory to create the temporary file in
+ */
+/*--------------------------------------------------------------------------------*/
+ADMData::BlockFormatFile::BlockFormatFile(const std::string& dir) : ADMBlockFormatStore(),
+                                                                   fp(NULL),
+                                                                   length(0)
+{
+  std::vector<char> name;
+  int fd;
+
+  // mkstemp() creates the file exclusively with a unique name that only this user can access
+  filename = EnhancedFile::catpath(dir, "bbcat-adm-blocks-XXXXXX");
+  name.assign(filename.begin(), filename.end());
+  name.push_back(0);
+
+  if ((fd = mkstemp(&name[0])) >= 0)
+  {
+    filename = &name[0];
+
+    if ((fp = fdopen(fd, "w+b")) != NULL)
+    {
+      BBCDEBUG2(("Created block format file '%s'", filename.c_str()));
+    }
+    else
+    {
+      BBCERROR("Failed to open block format file '%s'", filename.c_str());
+      close(fd);
+    }
+
+    // file is no longer needed in the directory, it is deleted once closed
+    unlink(filename.c_str());
+  }
+  else BBCERROR("Failed to create block format file '%s' (%s)", filename.c_str(), strerror(errno));
+}
+
+ADMData::BlockFormatFile::~BlockFormatFile()
+{
+  if (fp) fclose(fp);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return whether the temporary file was created
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::BlockFormatFile::IsOpen() const
+{
+  return (fp != NULL);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write block formats to file
+ *
+ * @param blocks list of block formats (which are not modified)
+ * @param pos updated with position of the run of block formats in the file
+ * @param len updated with length of the run of block formats in the file
+ *
+ * @return true if successful
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::BlockFormatFile::Write(const std::vector<ADMAudioBlockFormat *>& blocks, uint64_t& pos, uint64_t& len)
+{
+  std::vector<uint8_t> body, data;
+  BINARYWRITER writer;
+  uint_t i;
+  bool success = false;
+
+  writer.data = &body;
+
+  WriteBinary(writer, (uint32_t)blocks.size());
+  for (i = 0; i < blocks.size(); i++) WriteBinary(writer, blocks[i]);
+
+  WriteBinaryStrings(writer, data);
+  data.insert(data.end(), body.begin(), body.end());
+
+  {
+    ThreadLock lock(tlock);
+
+    // runs are always appended to the end of the file
+    if (fp &&
+        (fseeko(fp, (off_t)length, SEEK_SET) == 0) &&
+        (fwrite(&data[0], 1, data.size(), fp) == data.size()))
+    {
+      pos     = length;
+      len     = data.size();
+      length += len;
+      success = true;
+    }
+    else BBCERROR("Failed to write %u block formats to '%s'", (uint_t)blocks.size(), filename.c_str());
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read run of block formats from file
+ *
+ * @param pos position of run of block formats (as returned by Write())
+ * @param len length of run of block formats (as returned by Write())
+ * @param blocks list to be populated with new block formats
+ *
+ * @return true if successful
+ *
+ * @note on failure, blocks is left unchanged (no partial runs are returned)
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::BlockFormatFile::Read(uint64_t pos, uint64_t len, std::vector<ADMAudioBlockFormat *>& blocks)
+{
+  std::vector<uint8_t> data;
+  BINARYREADER reader;
+  size_t   start = blocks.size();
+  uint32_t i, n;
+  bool success = false;
+
+  if (len && ((pos + len) <= length))
+  {
+    ThreadLock lock(tlock);
+
+    data.resize((size_t)len);
+    success = (fp &&
+               (fseeko(fp, (off_t)pos, SEEK_SET) == 0) &&
+               (fread(&data[0], 1, data.size(), fp) == data.size()));
+  }
+
+  if (success)
+  {
+    reader.p     = &data[0];
+    reader.end   = reader.p + data.size();
+    reader.valid = true;
+
+    if (ReadBinaryStrings(reader) &&
+        ReadBinary(reader, n) &&
+        (n <= (uint32_t)(reader.end - reader.p)))
+    {
+      blocks.reserve(blocks.size() + n);
+      for (i = 0; i < n; i++)
+      {
+        ADMAudioBlockFormat *block;
+
+        if ((block = ReadBinaryBlock(reader)) != NULL) blocks.push_back(block);
+        else break;
+      }
+    }
+
+    success = (reader.valid && (reader.p == reader.end));
+  }
+
+  if (!success)
+  {
+    BBCERROR("Failed to read block formats from '%s' at %s", filename.c_str(), StringFrom(pos).c_str());
+
+    // discard any block formats read before the failure
+    for (i = 0; (start + i) < blocks.size(); i++) delete blocks[start + i];
+    blocks.resize(start);
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Add reference to object of any type
+ *
+ * @return true if reference is accepted
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMData::AddReference(ADMObject *obj, ADMObject *ref)
+{
+  ADMAudioContent       *content;
+  ADMAudioObject        *object;
+  ADMAudioTrack         *track;
+  ADMAudioPackFormat    *packformat;
+  ADMAudioStreamFormat  *streamformat;
+  ADMAudioChannelFormat *channelformat;
+  ADMAudioTrackFormat   *trackformat;
+  bool success = false;
+
+  if      ((content       = dynamic_cast<ADMAudioContent       *>(ref)) != NULL) success = obj->Add(content);
+  else if ((object        = dynamic_cast<ADMAudioObject        *>(ref)) != NULL) success = obj->Add(object);
+  else if ((track         = dynamic_cast<ADMAudioTrack         *>(ref)) != NULL) success = obj->Add(track);
+  else if ((packformat    = dynamic_cast<ADMAudioPackFormat    *>(ref)) != NULL) success = obj->Add(packformat);
+  else if ((streamformat  = dynamic_cast<ADMAudioStreamFormat  *>(ref)) != NULL) success = obj->Add(streamformat);
+  else if ((channelformat = dynamic_cast<ADMAudioChannelFormat *>(ref)) != NULL) success = obj->Add(channelformat);
+  else if ((trackformat   = dynamic_cast<ADMAudioTrackFormat   *>(ref)) != NULL) success = obj->Add(trackformat);
+
+  return success;
+}
+
 #if ENABLE_JSON
 /*--------------------------------------------------------------------------------*/
 /** Return ADM as JSON
@@ -1558,22 +2470,18 @@ json_spirit::mObject ADMData::ToJSON() const
     for (t = 0; t < tracks.size(); t++)
     {
       uint_t trackNum = tracks[t]->GetTrackNum();
-      const std::vector<ADMAudioBlockFormat *> *blockformats = object->GetBlockFormatList(trackNum);
+      ADMAudioBlockFormatRefs blockformats = object->GetBlockFormatList(trackNum);
+      uint_t bid;
 
-      if (blockformats)
+      for (bid = 0; bid < blockformats.size(); bid++)
       {
-        uint_t bid;
+        json_spirit::mObject obj;
 
-        for (bid = 0; bid < blockformats->size(); bid++)
-        {
-          json_spirit::mObject obj;
-
-          obj["object"]   = object->GetID();
-          obj["reltrack"] = (sint_t)trackNum - (sint_t)object->GetStartChannel();
-          (*blockformats)[bid]->ToJSON(obj);
+        obj["object"]   = object->GetID();
+        obj["reltrack"] = (sint_t)trackNum - (sint_t)object->GetStartChannel();
+        blockformats[bid]->ToJSON(obj);
 
-          array.push_back(obj);
-        }
+        array.push_back(obj);
       }
     }
   }
@@ -1,9 +1,12 @@
 #ifndef __ADM_DATA__
 #define __ADM_DATA__
 
+#include <stdio.h>
+
 #include <string>
 #include <vector>
 #include <map>
+#include <algorithm>
 
 #include <bbcat-base/misc.h>
 
@@ -11,6 +14,7 @@
 
 BBC_AUDIOTOOLBOX_START
 
+
 /*--------------------------------------------------------------------------------*/
 /** ADM data class
  *
@@ -32,9 +36,16 @@ public:
 
   /*--------------------------------------------------------------------------------*/
   /** Copy from another ADM
+   *
+   * @param obj ADM to copy
+   * @param cow true to share block formats of all channel formats with obj (copy-on-write)
+   *
+   * @note block formats of standard definition channel formats are always shared
+   * @note shared block formats are cloned when either ADM modifies them, BUT pointers
+   * @note to block formats obtained from obj before the copy still reference the shared blocks
    */
   /*--------------------------------------------------------------------------------*/
-  virtual void Copy(const ADMData& obj);
+  virtual void Copy(const ADMData& obj, bool cow = false);
 
   /*--------------------------------------------------------------------------------*/
   /** Delete all objects within this ADM
@@ -66,6 +77,27 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual void Finalise();
 
+  /*--------------------------------------------------------------------------------*/
+  /** Change temporary IDs to full valid ones based on a set of rules
+   *
+   * @note this is called by Finalise() but can be called earlier so that XML generated
+   * @note before the ADM is finalised (e.g. Serial ADM frames) carries the final IDs
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ChangeTemporaryIDs();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Simplify block formats of all (non-standard definition) channel formats
+   *
+   * @param tolerances maximum errors allowed in the rendered parameters
+   *
+   * @return total number of block formats removed
+   *
+   * @note see ADMAudioChannelFormat::SimplifyBlockFormats()
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t SimplifyBlockFormats(const ADMAudioChannelFormat::SIMPLIFYTOLERANCES& tolerances);
+
   /*--------------------------------------------------------------------------------*/
   /** Create an ADM sub-object within this ADM object
    *
@@ -229,6 +261,16 @@ public:
   /*--------------------------------------------------------------------------------*/
   void Register(ADMObject *obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Unregister an ADM sub-object from this ADM
+   *
+   * @param obj ptr to ADM object
+   *
+   * @note the object is NOT deleted and references to it from other objects are NOT removed
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Unregister(ADMObject *obj);
+
   /*--------------------------------------------------------------------------------*/
   /** Return the object associated with the specified reference
    *
@@ -437,6 +479,35 @@ public:
   /*--------------------------------------------------------------------------------*/
   bool CreateFromFile(const char *filename);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Serialise ADM into a compact binary form (for storing alongside the XML, see SetBinary())
+   *
+   * @param data buffer to be populated
+   * @param sourcehash hash of the data the binary form is stored with (checked by SetBinary())
+   *
+   * @note standard definitions are not stored, references to them are stored by ID
+   * @note the binary form uses the byte order of the machine and is not intended for interchange
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GetBinary(std::vector<uint8_t>& data, uint64_t sourcehash = 0) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read ADM from binary form generated by GetBinary()
+   *
+   * @param data binary data
+   * @param len length of data
+   * @param sourcehash hash of the data the binary form was stored with
+   *
+   * @return true if data read successfully
+   *
+   * @note no text is parsed for block formats, objects are created directly from the data
+   * @note false is returned and the ADM left unchanged if sourcehash does not match the
+   * @note hash supplied to GetBinary(), if the data was generated on a machine with a
+   * @note different byte order or if the data is invalid
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool SetBinary(const uint8_t *data, uint64_t len, uint64_t sourcehash = 0);
+
 protected:
   /*--------------------------------------------------------------------------------*/
   /** Find an unique ID given the specified format string
@@ -462,6 +533,19 @@ protected:
   /*--------------------------------------------------------------------------------*/
   bool ValidType(const std::string& type) const;
 
+  /*--------------------------------------------------------------------------------*/
+  /** Create a copy of an object (from another ADM) in this ADM
+   *
+   * @param obj object to copy
+   * @param share true to share the block formats of a channel format with obj (copy-on-write)
+   *
+   * @return new object or NULL if the type is not recognized
+   *
+   * @note references are NOT copied (see ADMObject::CopyReferences())
+   */
+  /*--------------------------------------------------------------------------------*/
+  ADMObject *CopyObject(const ADMObject *obj, bool share = false);
+
   /*--------------------------------------------------------------------------------*/
   /** Context structure for generating textual dump of ADM
    */
@@ -488,6 +572,16 @@ protected:
   /*--------------------------------------------------------------------------------*/
   virtual void ConnectReferences();
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references to objects that have been replaced or removed
+   *
+   * @param objects map of replaced or removed objects (bool is a dummy)
+   *
+   * @note the objects MUST have been unregistered but NOT yet deleted
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
+
   /*--------------------------------------------------------------------------------*/
   /** Sort tracks into numerical order
    */
@@ -501,10 +595,213 @@ protected:
   virtual void ChangeTemporaryID(ADMObject *obj, std::map<ADMObject *,bool>& map);
 
   /*--------------------------------------------------------------------------------*/
-  /** Change temporary IDs to full valid ones based on a set of rules
+  /** Binary form (see GetBinary())
+   *
+   * header
+   * string table:   count, then length and characters of each string
+   * objects:        count, then type, flags, ID, name, track number and values of each object
+   * references:     count, then indices of referencing and referenced object of each reference
+   * block formats:  count of channel formats, then index and count of block formats of each
+   *                 channel format followed by the block formats
+   * non-ADM XML:    count, then node and values of each node
+   *
+   * strings are stored as indices into the string table, block formats are stored as a
+   * fixed layout record unless they have parameters not held by the record in which case
+   * they are stored as values
+   */
+  /*--------------------------------------------------------------------------------*/
+  enum {
+    Binary_Magic     = 0x4d444142,      // 'BADM' in little-endian order
+    Binary_Version   = 1,
+    Binary_ByteOrder = 0x01020304,
+  };
+
+  enum {
+    BinaryObject_External = 0x01,       // object is a standard definition (referenced by ID)
+  };
+
+  enum {
+    BinaryBlock_Record = 0,             // block format stored as BINARYBLOCK
+    BinaryBlock_Values,                 // block format stored as values
+  };
+
+  enum {
+    BinaryBlock_RTime            = 0x00001,
+    BinaryBlock_Duration         = 0x00002,
+    BinaryBlock_CartesianSet     = 0x00004,
+    BinaryBlock_Cartesian        = 0x00008,
+    BinaryBlock_Position         = 0x00010,
+    BinaryBlock_Polar            = 0x00020,
+    BinaryBlock_Gain             = 0x00040,
+    BinaryBlock_Width            = 0x00080,
+    BinaryBlock_Depth            = 0x00100,
+    BinaryBlock_Height           = 0x00200,
+    BinaryBlock_Diffuseness      = 0x00400,
+    BinaryBlock_JumpPositionSet  = 0x00800,
+    BinaryBlock_JumpPosition     = 0x01000,
+    BinaryBlock_Divergence       = 0x02000,
+    BinaryBlock_DivergenceAzimuth= 0x04000,
+    BinaryBlock_ChannelLockSet   = 0x08000,
+    BinaryBlock_ChannelLock      = 0x10000,
+    BinaryBlock_MaxDistance      = 0x20000,
+    BinaryBlock_Importance       = 0x40000,
+  };
+
+  typedef PACKEDSTRUCT {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t byteorder;
+    uint32_t reserved;
+    uint64_t sourcehash;
+  } BINARYHEADER;
+
+  typedef PACKEDSTRUCT {
+    uint64_t rtime;
+    uint64_t duration;
+    uint32_t flags;                     // BinaryBlock_xxx flags
+    double   position[3];               // az/el/d or x/y/z depending on BinaryBlock_Polar
+    double   gain;
+    double   interpolationlength;
+    float    width;
+    float    depth;
+    float    height;
+    float    diffuseness;
+    float    divergencebalance;
+    float    divergenceazimuth;
+    float    maxdistance;
+    uint32_t importance;
+  } BINARYBLOCK;
+
+  typedef struct {
+    std::vector<uint8_t>          *data;
+    std::map<std::string,uint32_t> stringmap;
+    std::vector<const std::string *> strings;
+  } BINARYWRITER;
+
+  typedef struct {
+    const uint8_t            *p, *end;
+    std::vector<std::string> strings;
+    bool                     valid;     // false once any read has failed
+  } BINARYREADER;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Append data to binary form
    */
   /*--------------------------------------------------------------------------------*/
-  virtual void ChangeTemporaryIDs();
+  static void WriteBinary(BINARYWRITER& writer, const void *data, uint_t n);
+  static void WriteBinary(BINARYWRITER& writer, uint32_t val) {WriteBinary(writer, &val, sizeof(val));}
+  static void WriteBinary(BINARYWRITER& writer, const std::string& str);
+  static void WriteBinary(BINARYWRITER& writer, const XMLValues& values);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Append block format to binary form
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void WriteBinary(BINARYWRITER& writer, const ADMAudioBlockFormat *block);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read data from binary form
+   *
+   * @return true if data read successfully (if not, reader.valid is cleared)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool ReadBinary(BINARYREADER& reader, void *data, uint_t n);
+  static bool ReadBinary(BINARYREADER& reader, uint32_t& val) {return ReadBinary(reader, &val, sizeof(val));}
+  static bool ReadBinary(BINARYREADER& reader, const std::string *& str);
+  static bool ReadBinary(BINARYREADER& reader, XMLValues& values);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read block format from binary form
+   *
+   * @return new block format or NULL
+   */
+  /*--------------------------------------------------------------------------------*/
+  static ADMAudioBlockFormat *ReadBinaryBlock(BINARYREADER& reader);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Append string table of writer to data
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void WriteBinaryStrings(const BINARYWRITER& writer, std::vector<uint8_t>& data);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read string table into reader
+   *
+   * @return true if data read successfully (if not, reader.valid is cleared)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool ReadBinaryStrings(BINARYREADER& reader);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Temporary file holding block formats moved out of memory (see
+   * ADMAudioChannelFormat::StoreBlockFormats())
+   *
+   * Each run of block formats is stored in the binary form (see GetBinary()) as its own
+   * string table followed by the count of block formats and the block formats
+   *
+   * @note the file is created exclusively (and only accessible by the user) under a unique name
+   * @note and removed from the directory immediately so it is deleted when the store is destroyed
+   * @note (or the process exits)
+   */
+  /*--------------------------------------------------------------------------------*/
+  class BlockFormatFile : public ADMBlockFormatStore
+  {
+  public:
+    /*--------------------------------------------------------------------------------*/
+    /** Constructor
+     *
+     * @param dir directory to create the temporary file in
+     */
+    /*--------------------------------------------------------------------------------*/
+    BlockFormatFile(const std::string& dir);
+    virtual ~BlockFormatFile();
+
+    /*--------------------------------------------------------------------------------*/
+    /** Return whether the temporary file was created
+     */
+    /*--------------------------------------------------------------------------------*/
+    bool IsOpen() const;
+
+    /*--------------------------------------------------------------------------------*/
+    /** Write block formats to file
+     *
+     * @param blocks list of block formats (which are not modified)
+     * @param pos updated with position of the run of block formats in the file
+     * @param len updated with length of the run of block formats in the file
+     *
+     * @return true if successful
+     */
+    /*--------------------------------------------------------------------------------*/
+    virtual bool Write(const std::vector<ADMAudioBlockFormat *>& blocks, uint64_t& pos, uint64_t& len);
+
+    /*--------------------------------------------------------------------------------*/
+    /** Read run of block formats from file
+     *
+     * @param pos position of run of block formats (as returned by Write())
+     * @param len length of run of block formats (as returned by Write())
+     * @param blocks list to be populated with new block formats
+     *
+     * @return true if successful
+     *
+     * @note on failure, blocks is left unchanged (no partial runs are returned)
+     */
+    /*--------------------------------------------------------------------------------*/
+    virtual bool Read(uint64_t pos, uint64_t len, std::vector<ADMAudioBlockFormat *>& blocks);
+
+  protected:
+    FILE             *fp;
+    std::string      filename;
+    uint64_t         length;
+    ThreadLockObject tlock;
+  };
+
+  /*--------------------------------------------------------------------------------*/
+  /** Add reference to object of any type
+   *
+   * @return true if reference is accepted
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool AddReference(ADMObject *obj, ADMObject *ref);
 
 #if ENABLE_JSON
   /*--------------------------------------------------------------------------------*/
@@ -540,6 +837,28 @@ protected:
     if ((p = dynamic_cast<const T *>(obj)) != NULL) list.push_back(p);
   }
 
+  /*--------------------------------------------------------------------------------*/
+  /** Try to remove object from list by checking type using dynamic casting
+   */
+  /*--------------------------------------------------------------------------------*/
+  template<typename T>
+  void RemoveFromList(std::vector<T*>& list, ADMObject *obj)
+  {
+    T *p;
+    if ((p = dynamic_cast<T *>(obj)) != NULL) list.erase(std::remove(list.begin(), list.end(), p), list.end());
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Try to remove object from list by checking type using dynamic casting
+   */
+  /*--------------------------------------------------------------------------------*/
+  template<typename T>
+  void RemoveFromList(std::vector<const T*>& list, const ADMObject *obj)
+  {
+    const T *p;
+    if ((p = dynamic_cast<const T *>(obj)) != NULL) list.erase(std::remove(list.begin(), list.end(), p), list.end());
+  }
+
 protected:
   ADMAudioProgramme::LIST         audioprogrammes;
   ADMAudioContent::LIST           audiocontent;
@@ -0,0 +1,136 @@
+
+#define BBCDEBUG_LEVEL 1
+#include "ADMFrameGenerator.h"
+
+BBC_AUDIOTOOLBOX_START
+
+/*--------------------------------------------------------------------------------*/
+/** Constructor
+ *
+ * @param _adm ADM to generate frames of (MUST remain valid whilst frames are generated)
+ * @param _frameduration duration of each frame (ns)
+ * @param _sink sink each frame is written to (or NULL if WriteFrame() is overridden)
+ */
+/*--------------------------------------------------------------------------------*/
+ADMFrameGenerator::ADMFrameGenerator(const ADMData *_adm, uint64_t _frameduration, ADMXMLGenerator::Sink *_sink) : adm(_adm),
+                                                                                                                    sink(_sink),
+                                                                                                                    frameduration(_frameduration),
+                                                                                                                    indent("\t"),
+                                                                                                                    eol("\n"),
+                                                                                                                    prepared(false)
+{
+  frame.start    = 0;
+  frame.duration = frameduration;
+  frame.index    = 0;
+}
+
+ADMFrameGenerator::~ADMFrameGenerator()
+{
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Find the channel formats of the ADM's objects, called automatically by Process()
+ *
+ * @note MUST be called again if objects are added to the ADM after frames have been generated
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMFrameGenerator::Prepare()
+{
+  const ADMData::TRACKLIST& tracks = adm->GetTrackList();
+  std::vector<const ADMAudioObject *> objects;
+  uint_t i;
+
+  // get list of ADMAudioObjects
+  adm->GetAudioObjectList(objects);
+
+  // use a cursor for each track to find the channel formats of each object on that track
+  frame.offsets.clear();
+  for (i = 0; i < tracks.size(); i++)
+  {
+    ADMTrackCursor cursor(tracks[i]->GetTrackNum());
+
+    cursor.Add(objects);
+    cursor.GetChannelFormatOffsets(frame.offsets);
+  }
+
+  BBCDEBUG2(("Frames will contain block formats of %u channel formats", (uint_t)frame.offsets.size()));
+
+  prepared = true;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Generate all frames that end at or before t
+ *
+ * @param t time (ns) up to which the ADM is complete
+ *
+ * @return true if all frames were generated successfully
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMFrameGenerator::Process(uint64_t t)
+{
+  bool success = true;
+
+  if (!prepared) Prepare();
+
+  while (success && frameduration && ((frame.start + frameduration) <= t))
+  {
+    success = GenerateFrame(frameduration);
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Generate all remaining frames, the last ending at t
+ *
+ * @param t end time (ns) of the ADM
+ *
+ * @return true if all frames were generated successfully
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMFrameGenerator::Finish(uint64_t t)
+{
+  bool success = Process(t);
+
+  // last frame is shortened to end at t
+  if (success && (frame.start < t)) success = GenerateFrame(t - frame.start);
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Output frame
+ *
+ * @param outframe frame to output
+ *
+ * @return true if successful
+ *
+ * @note the default writes the frame to the sink, override to handle frames differently
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMFrameGenerator::WriteFrame(const ADMXMLGenerator::FRAME& outframe)
+{
+  return (sink && ADMXMLGenerator::WriteFrame(adm, outframe, *sink, indent, eol));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Generate frame of the specified duration and move on to the next
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMFrameGenerator::GenerateFrame(uint64_t duration)
+{
+  bool success;
+
+  frame.index++;
+  frame.duration = duration;
+
+  BBCDEBUG3(("Generating frame %u at %0.3lfs", frame.index, (double)frame.start * 1.0e-9));
+
+  if (!(success = WriteFrame(frame))) BBCERROR("Failed to write frame %u", frame.index);
+
+  frame.start += duration;
+
+  return success;
+}
+
+BBC_AUDIOTOOLBOX_END
@@ -0,0 +1,125 @@
+#ifndef __ADM_FRAME_GENERATOR__
+#define __ADM_FRAME_GENERATOR__
+
+#include <string>
+
+#include "ADMXMLGenerator.h"
+
+BBC_AUDIOTOOLBOX_START
+
+/*--------------------------------------------------------------------------------*/
+/** Serial ADM (ITU-R BS.2125) frame generator
+ *
+ * Generates a self-contained frame document for each fixed duration frame of an ADM
+ * as time progresses, each frame holding all ADM objects but only the block formats
+ * active within it
+ *
+ * Frames are generated incrementally (e.g. whilst an ADMRIFFFile is being written) so
+ * that nothing beyond the frame currently being generated is held
+ *
+ * @note frames use the IDs the ADM's objects have when they are generated so objects
+ * @note with temporary IDs should be given their final IDs (see ADMData::ChangeTemporaryIDs())
+ * @note before the first frame is generated (ADMRIFFFile does this automatically)
+ */
+/*--------------------------------------------------------------------------------*/
+class ADMFrameGenerator
+{
+public:
+  /*--------------------------------------------------------------------------------*/
+  /** Constructor
+   *
+   * @param _adm ADM to generate frames of (MUST remain valid whilst frames are generated)
+   * @param _frameduration duration of each frame (ns)
+   * @param _sink sink each frame is written to (or NULL if WriteFrame() is overridden)
+   */
+  /*--------------------------------------------------------------------------------*/
+  ADMFrameGenerator(const ADMData *_adm, uint64_t _frameduration, ADMXMLGenerator::Sink *_sink = NULL);
+  virtual ~ADMFrameGenerator();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set flowID of frames
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetFlowID(const std::string& id) {frame.flowid = id;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set formatting of frames
+   *
+   * @param _indent indent string to use within XML
+   * @param _eol end of line string to use within XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetFormat(const std::string& _indent, const std::string& _eol) {indent = _indent; eol = _eol;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return duration of each frame (ns)
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint64_t GetFrameDuration() const {return frameduration;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return number of frames generated so far
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t GetFrameCount() const {return frame.index;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Find the channel formats of the ADM's objects, called automatically by Process()
+   *
+   * @note MUST be called again if objects are added to the ADM after frames have been generated
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Prepare();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate all frames that end at or before t
+   *
+   * @param t time (ns) up to which the ADM is complete
+   *
+   * @return true if all frames were generated successfully
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool Process(uint64_t t);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate all remaining frames, the last ending at t
+   *
+   * @param t end time (ns) of the ADM
+   *
+   * @return true if all frames were generated successfully
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool Finish(uint64_t t);
+
+protected:
+  /*--------------------------------------------------------------------------------*/
+  /** Output frame
+   *
+   * @param outframe frame to output
+   *
+   * @return true if successful
+   *
+   * @note the default writes the frame to the sink, override to handle frames differently
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool WriteFrame(const ADMXMLGenerator::FRAME& outframe);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate frame of the specified duration and move on to the next
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GenerateFrame(uint64_t duration);
+
+protected:
+  const ADMData          *adm;
+  ADMXMLGenerator::Sink  *sink;
+  ADMXMLGenerator::FRAME frame;         ///< next frame to be generated
+  uint64_t               frameduration;
+  std::string            indent;
+  std::string            eol;
+  bool                   prepared;
+};
+
+BBC_AUDIOTOOLBOX_END
+
+#endif
@@ -1,5 +1,6 @@
 
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 #include <map>
@@ -8,6 +9,7 @@
 #define BBCDEBUG_LEVEL 1
 #include "ADMObjects.h"
 #include "ADMData.h"
+#include "ADMXMLGenerator.h"
 
 BBC_AUDIOTOOLBOX_START
 
@@ -169,10 +171,10 @@ void ADMObject::SetValues()
 /*--------------------------------------------------------------------------------*/
 void ADMObject::SetReferences()
 {
-  XMLValues::iterator it;
+  XMLValues::iterator it, kept;
 
   // cycle through values looking for references to the specified object type
-  for (it = values.begin(); (it != values.end());)
+  for (it = kept = values.begin(); (it != values.end()); ++it)
   {
     const ADMObject *obj  = NULL; // for neater response handling
     const XMLValue& value = *it;
@@ -273,7 +275,9 @@ void ADMObject::SetReferences()
     }
     else
     {
-      ++it;
+      // keep non-reference values (in order) at the front of the list
+      if (kept != it) kept->swap(*it);
+      ++kept;
       // note continue to avoid removing non-reference values
       continue;
     }
@@ -301,10 +305,10 @@ void ADMObject::SetReferences()
             value.name.c_str(), value.value.c_str(),
             ToString().c_str());
     }
-
-    // REMOVE value (the reference) from the list
-    it = values.erase(it);
   }
+
+  // REMOVE values (the references) from the list in one go
+  values.erase(kept, values.end());
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -379,6 +383,34 @@ void ADMObject::CopyReferencesEx(std::vector<T *>& dst, const std::vector<T *>&
   }
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link a list of references to the objects currently in the owner
+ */
+/*--------------------------------------------------------------------------------*/
+template<typename T>
+void ADMObject::RelinkReferencesEx(std::vector<T *>& refs, const std::map<const ADMObject *,bool>& objects)
+{
+  uint_t i;
+  for (i = 0; i < refs.size();)
+  {
+    ADMObject *obj;
+    T         *obj2;
+
+    // only references to the specified objects need re-linking
+    if (objects.find(refs[i]) == objects.end()) i++;
+    else if (((obj = owner.GetWritableObjectByID(refs[i]->GetID(), refs[i]->GetType())) != NULL) &&
+        ((obj2 = dynamic_cast<T *>(obj)) != NULL))
+    {
+      refs[i++] = obj2;
+    }
+    else
+    {
+      BBCDEBUG2(("Object '%s' no longer exists, removing reference from '%s'", refs[i]->ToString().c_str(), ToString().c_str()));
+      refs.erase(refs.begin() + i);
+    }
+  }
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 const std::string ADMAudioProgramme::Type      = "audioProgramme";
@@ -468,6 +500,17 @@ void ADMAudioProgramme::CopyReferences(const ADMObject *_obj)
   else BBCERROR("Cannot copy references from '%s', type is '%s' not '%s'", _obj->ToString().c_str(), _obj->GetType().c_str(), GetType().c_str()); 
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link references after objects have been replaced or removed within the owner
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioProgramme::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
+{
+  ADMObject::RelinkReferences(objects);
+
+  RelinkReferencesEx<>(contentrefs, objects);
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 const std::string ADMAudioContent::Type      = "audioContent";
@@ -557,6 +600,17 @@ void ADMAudioContent::CopyReferences(const ADMObject *_obj)
   else BBCERROR("Cannot copy references from '%s', type is '%s' not '%s'", _obj->ToString().c_str(), _obj->GetType().c_str(), GetType().c_str()); 
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link references after objects have been replaced or removed within the owner
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioContent::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
+{
+  ADMObject::RelinkReferences(objects);
+
+  RelinkReferencesEx<>(objectrefs, objects);
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 const std::string ADMAudioObject::Type      = "audioObject";
@@ -843,17 +897,17 @@ ADMAudioChannelFormat *ADMAudioObject::GetChannelFormat(uint_t track) const
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Get list of audioBlockFormats for a particular track
+/** Get list of audioBlockFormats for a particular track (empty if the track has no audioChannelFormat)
  */
 /*--------------------------------------------------------------------------------*/
-const std::vector<ADMAudioBlockFormat *> *ADMAudioObject::GetBlockFormatList(uint_t track) const
+ADMAudioBlockFormatRefs ADMAudioObject::GetBlockFormatList(uint_t track) const
 {
-  const ADMAudioChannelFormat              *channelformat;
-  const std::vector<ADMAudioBlockFormat *> *blockformats = NULL;
+  const ADMAudioChannelFormat *channelformat;
+  ADMAudioBlockFormatRefs     blockformats;
 
   if ((channelformat = GetChannelFormat(track)) != NULL)
   {
-    blockformats = &channelformat->GetBlockFormatRefs();
+    blockformats = channelformat->GetBlockFormatRefs();
   }
 
   return blockformats;
@@ -913,6 +967,19 @@ void ADMAudioObject::CopyReferences(const ADMObject *_obj)
   else BBCERROR("Cannot copy references from '%s', type is '%s' not '%s'", _obj->ToString().c_str(), _obj->GetType().c_str(), GetType().c_str()); 
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link references after objects have been replaced or removed within the owner
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioObject::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
+{
+  ADMObject::RelinkReferences(objects);
+
+  RelinkReferencesEx<>(objectrefs, objects);
+  RelinkReferencesEx<>(packformatrefs, objects);
+  RelinkReferencesEx<>(trackrefs, objects);
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 const std::string ADMAudioTrack::Type      = "audioTrackUID";
@@ -1026,6 +1093,18 @@ void ADMAudioTrack::CopyReferences(const ADMObject *_obj)
   else BBCERROR("Cannot copy references from '%s', type is '%s' not '%s'", _obj->ToString().c_str(), _obj->GetType().c_str(), GetType().c_str()); 
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link references after objects have been replaced or removed within the owner
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioTrack::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
+{
+  ADMObject::RelinkReferences(objects);
+
+  RelinkReferencesEx<>(trackformatrefs, objects);
+  RelinkReferencesEx<>(packformatrefs, objects);
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 const std::string ADMAudioPackFormat::Type      = "audioPackFormat";
@@ -1147,6 +1226,18 @@ void ADMAudioPackFormat::CopyReferences(const ADMObject *_obj)
   else BBCERROR("Cannot copy references from '%s', type is '%s' not '%s'", _obj->ToString().c_str(), _obj->GetType().c_str(), GetType().c_str()); 
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link references after objects have been replaced or removed within the owner
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioPackFormat::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
+{
+  ADMObject::RelinkReferences(objects);
+
+  RelinkReferencesEx<>(channelformatrefs, objects);
+  RelinkReferencesEx<>(packformatrefs, objects);
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 const std::string ADMAudioStreamFormat::Type      = "audioStreamFormat";
@@ -1325,6 +1416,19 @@ void ADMAudioStreamFormat::CopyReferences(const ADMObject *_obj)
   else BBCERROR("Cannot copy references from '%s', type is '%s' not '%s'", _obj->ToString().c_str(), _obj->GetType().c_str(), GetType().c_str()); 
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Re-link references after objects have been replaced or removed within the owner
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioStreamFormat::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
+{
+  ADMObject::RelinkReferences(objects);
+
+  RelinkReferencesEx<>(channelformatrefs, objects);
+  RelinkReferencesEx<>(packformatrefs, objects);
+  RelinkReferencesEx<>(trackformatrefs, objects);
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 const std::string ADMAudioTrackFormat::Type      = "audioTrackFormat";
@@ -1443,239 +1547,1502 @@ void ADMAudioTrackFormat::CopyReferences(const ADMObject *_obj)
   else BBCERROR("Cannot copy references from '%s', type is '%s' not '%s'", _obj->ToString().c_str(), _obj->GetType().c_str(), GetType().c_str()); 
 }
 
-/*----------------------------------------------------------------------------------------------------*/
-
-const std::string ADMAudioChannelFormat::Type      = "audioChannelFormat";
-const std::string ADMAudioChannelFormat::Reference = Type + "IDRef";
-const std::string ADMAudioChannelFormat::IDPrefix  = "AC_";
-
-ADMAudioChannelFormat::ADMAudioChannelFormat(ADMData& _owner, const ADMAudioChannelFormat *obj) : ADMObject(_owner, obj)
+/*--------------------------------------------------------------------------------*/
+/** Re-link references after objects have been replaced or removed within the owner
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioTrackFormat::RelinkReferences(const std::map<const ADMObject *,bool>& objects)
 {
-  Register();
+  ADMObject::RelinkReferences(objects);
 
-  // copy all blockformats from obj
-  const std::vector<ADMAudioBlockFormat *>& oldblockformatrefs = obj->GetBlockFormatRefs();
-  uint_t i;
-  for (i = 0; i < oldblockformatrefs.size(); i++)
-  {
-    blockformatrefs.push_back(new ADMAudioBlockFormat(oldblockformatrefs[i]));
-  }
+  RelinkReferencesEx<>(streamformatrefs, objects);
 }
 
-ADMAudioChannelFormat::~ADMAudioChannelFormat()
+/*----------------------------------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------------*/
+/** Clear timeline
+ *
+ * @param release true to release the memory used by the columns
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioBlockTimeline::Clear(bool release)
 {
-  // delete all block formats
   uint_t i;
-  for (i = 0; i < blockformatrefs.size(); i++) delete blockformatrefs[i];
-  blockformatrefs.clear();
+
+  if (release)
+  {
+    // clear() retains capacity so swap each column with an empty one
+    std::vector<uint64_t>().swap(rtimes);
+    std::vector<uint64_t>().swap(durations);
+    std::vector<uint8_t>().swap(flags);
+    for (i = 0; i < NUMBEROF(positions); i++) std::vector<double>().swap(positions[i]);
+    std::vector<double>().swap(gains);
+    std::vector<float>().swap(widths);
+    for (i = 0; i < NUMBEROF(sparse); i++) SPARSECOLUMN().swap(sparse[i]);
+  }
+  else
+  {
+    rtimes.clear();
+    durations.clear();
+    flags.clear();
+    for (i = 0; i < NUMBEROF(positions); i++) positions[i].clear();
+    gains.clear();
+    widths.clear();
+    for (i = 0; i < NUMBEROF(sparse); i++) sparse[i].clear();
+  }
+  extentsvalid = false;
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Set internal variables from values added to internal list (e.g. from XML)
+/** Reserve space for n blocks
  */
 /*--------------------------------------------------------------------------------*/
-void ADMAudioChannelFormat::SetValues()
+void ADMAudioBlockTimeline::Reserve(uint_t n)
 {
-  ADMObject::SetValues();
+  uint_t i;
+
+  rtimes.reserve(n);
+  durations.reserve(n);
+  flags.reserve(n);
+  for (i = 0; i < NUMBEROF(positions); i++) positions[i].reserve(n);
+  gains.reserve(n);
+  widths.reserve(n);
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Update object's ID
+/** Insert block at index n (blocks at n and beyond move up by one)
  */
 /*--------------------------------------------------------------------------------*/
-void ADMAudioChannelFormat::UpdateID()
+void ADMAudioBlockTimeline::Insert(uint_t n, const ADMAudioBlockFormat *block)
 {
-  // call SetID() with new ID
-  std::string _id;
+  uint_t i;
 
-  Printf(_id, "%04x%%04x", typeLabel);
+  n = std::min(n, size());
 
-  // custom channel formats start indexing at 0x1000
-  SetID(GetIDPrefix() + _id, 0x1000);
+  // open up a gap in each column (the common case of appending is cheap)
+  rtimes.insert(rtimes.begin() + n, 0);
+  durations.insert(durations.begin() + n, 0);
+  flags.insert(flags.begin() + n, 0);
+  for (i = 0; i < NUMBEROF(positions); i++) positions[i].insert(positions[i].begin() + n, 0.0);
+  gains.insert(gains.begin() + n, 1.0);
+  widths.insert(widths.begin() + n, 0.f);
+
+  // move indices of sparse values at or beyond the insertion point
+  for (i = 0; i < NUMBEROF(sparse); i++)
+  {
+    SPARSECOLUMN::iterator it;
+
+    for (it = std::lower_bound(sparse[i].begin(), sparse[i].end(), n, &CompareSparseIndex); it != sparse[i].end(); ++it) it->index++;
+  }
+
+  SetEntry(n, block);
+  ExtendExtents(n);
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Sort block formats in time order
+/** Update entry n from block
  */
 /*--------------------------------------------------------------------------------*/
-void ADMAudioChannelFormat::SortBlockFormats()
+void ADMAudioBlockTimeline::Update(uint_t n, const ADMAudioBlockFormat *block)
 {
-  std::sort(blockformatrefs.begin(), blockformatrefs.end(), ADMAudioBlockFormat::Compare);
+  if (n < size())
+  {
+    uint64_t oldstart = rtimes[n];
+    uint64_t oldend   = GetEndTime(n);
+
+    SetEntry(n, block);
+
+    // if this block defined either extent it may have shrunk so the extents must be recalculated
+    if (extentsvalid && ((oldstart == minstart) || (oldend == maxend))) extentsvalid = false;
+    else ExtendExtents(n);
+  }
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Add reference to an AudioBlockFormat object and ensures blocks are sorted by time
+/** Set columns of entry n from block
  */
 /*--------------------------------------------------------------------------------*/
-bool ADMAudioChannelFormat::Add(ADMAudioBlockFormat *obj)
+void ADMAudioBlockTimeline::SetEntry(uint_t n, const ADMAudioBlockFormat *block)
 {
-  uint64_t t = obj->GetStartTime();
-  uint_t   n = (uint_t)blockformatrefs.size();
-
-  // insert obj into list ordered by time
-
-  // allocate memory in large chunks to reduce re-allocation time
-  if (n == blockformatrefs.capacity()) blockformatrefs.reserve(blockformatrefs.capacity() + 1024);
-
-  // if the list is empty just append
-  if (!n)
-  {
-    BBCDEBUG3(("blockformat list is empty: new item appended"));
-    blockformatrefs.push_back(obj);
-  }
-  // the most likely place for the new item is on the end so check this first
-  else if (t >= blockformatrefs[n - 1]->GetStartTime())
+  if (n < size())
   {
-    // ensure the new object is not already in the list
-    if (obj != blockformatrefs[n - 1])
-    {
-      // new object just needs to be appended to list
-      BBCDEBUG3(("New item is beyond last item (%llu >= %llu): new item appended", t, blockformatrefs[n - 1]->GetStartTime()));
-      blockformatrefs.push_back(obj);
-    }
-  }
-  // if the list has only one item or the new object is before the first item, new item must be inserted at the start
-  else if ((n == 1) || (t <= blockformatrefs[0]->GetStartTime()))
-  {
-    // ensure the new object is not already in the list
-    if (obj != blockformatrefs[0])
-    {
-      // new object just needs inserted at the start of the list
-      BBCDEBUG3(("New item is before first item (%llu <= %llu): new item inserted at start", t, blockformatrefs[0]->GetStartTime()));
-      blockformatrefs.insert(blockformatrefs.begin(), obj);
-    }
-  }
-  // object should be placed somewhere in the list but not at the end (checked above)
-  // list has at least two entries
-  else
-  {
-    // start at the middle of the list and use a binary search
-    uint_t inc = (n + 1) >> 1;      // round up division
-    uint_t pos = std::min(inc, n - 2);                                 // start in the middle but ensure the last position is never checked (no point)
-    uint_t count = 0;
+    const AudioObjectParameters& params = block->GetObjectParameters();
+    double  dval;
+    float   fval;
+    uint8_t blockflags = 0;
 
-    // break out when the new object is between the current and next item
-    while (!((t >= blockformatrefs[pos]->GetStartTime()) &&
-             (t <  blockformatrefs[pos + 1]->GetStartTime())))
+    rtimes[n]    = block->GetRTime();
+    durations[n] = block->GetDuration();
+
+    if (params.IsPositionSet())
     {
-      // half increment (rounding up to ensure it is always non-zero)
-      inc = (inc + 1) >> 1;
+      const Position& pos = params.GetPosition();
 
-      // if the new item is before the current one, move back by the increment
-      if (t < blockformatrefs[pos]->GetStartTime())
+      blockflags |= Flag_Position;
+      if (pos.polar)
       {
-        if (pos >= inc) pos -= inc;
-        else            pos  = 0;
+        blockflags |= Flag_Polar;
+        positions[0][n] = pos.pos.az;
+        positions[1][n] = pos.pos.el;
+        positions[2][n] = pos.pos.d;
+      }
+      else
+      {
+        positions[0][n] = pos.pos.x;
+        positions[1][n] = pos.pos.y;
+        positions[2][n] = pos.pos.z;
       }
-      // else move forward by the increment, limiting to the end but one item
-      else pos = std::min(pos + inc, n - 2);
-
-      count++;
     }
 
-    // check that the item isn't already in the list
-    if (obj != blockformatrefs[pos])
+    if (params.GetGain(dval))
     {
-      (void)count;
-
-      BBCDEBUG3(("New item is between indexes %u and %u (%llu <= %llu < %llu) (%u iterations): new item inserted between them", pos, pos + 1, blockformatrefs[pos]->GetStartTime(), t, blockformatrefs[pos + 1]->GetStartTime(), count));
+      blockflags |= Flag_Gain;
+      gains[n] = dval;
+    }
+    if (params.GetWidth(fval))
+    {
+      blockflags |= Flag_Width;
+      widths[n] = fval;
+    }
 
-      // the new item is between the pos'th and pos+1'th item
-      // but insert works by inserting *before* the given position
-      // therefore the position needs to be incremented by one
-      pos++;
+    flags[n] = blockflags;
 
-      blockformatrefs.insert(blockformatrefs.begin() + pos, obj);
-    }
+    fval = 0.f; SetSparseValue(sparse[Sparse_Height],            n, params.GetHeight(fval),            fval);
+    fval = 0.f; SetSparseValue(sparse[Sparse_Depth],             n, params.GetDepth(fval),             fval);
+    fval = 0.f; SetSparseValue(sparse[Sparse_Diffuseness],       n, params.GetDiffuseness(fval),       fval);
+    fval = 0.f; SetSparseValue(sparse[Sparse_DivergenceBalance], n, params.GetDivergenceBalance(fval), fval);
+    fval = 0.f; SetSparseValue(sparse[Sparse_DivergenceAzimuth], n, params.GetDivergenceAzimuth(fval), fval);
   }
-
-  return true;
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Return list of values/attributes from internal variables and list of referenced objects
+/** Rebuild entire timeline from list of blocks
  */
 /*--------------------------------------------------------------------------------*/
-void ADMAudioChannelFormat::GetValuesAndReferences(XMLValues& objvalues, std::vector<REFERENCEDOBJECT>& objects, bool full) const
+void ADMAudioBlockTimeline::Rebuild(const std::vector<ADMAudioBlockFormat *>& blocks)
 {
-  // populate list from parent object
-  ADMObject::GetValuesAndReferences(objvalues, objects, full);
+  uint_t i, n = (uint_t)blocks.size();
+
+  Clear();
+  Reserve(n);
+
+  rtimes.resize(n);
+  durations.resize(n);
+  flags.resize(n);
+  for (i = 0; i < NUMBEROF(positions); i++) positions[i].resize(n);
+  gains.resize(n, 1.0);
+  widths.resize(n);
+
+  // blocks are updated in index order so sparse values are appended in order
+  for (i = 0; i < n; i++) SetEntry(i, blocks[i]);
+
+  // extents are calculated when next needed
+  extentsvalid = false;
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Generate a textual list of references 
- *
- * @param str string to be modified
- *
+/** Extend (valid) extents to include entry n
  */
 /*--------------------------------------------------------------------------------*/
-void ADMAudioChannelFormat::GenerateReferenceList(std::string& str) const
+void ADMAudioBlockTimeline::ExtendExtents(uint_t n)
 {
-  UNUSED_PARAMETER(str);
+  if (extentsvalid)
+  {
+    minstart = std::min(minstart, rtimes[n]);
+    maxend   = std::max(maxend,   GetEndTime(n));
+  }
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Provide a way of accessing contained items without knowing what they are
- * (used for block formats)
+/** Return earliest start and latest end of all blocks (relative to start of object)
  *
- * @param n object index
- * @param object structure to be filled
+ * @param start earliest block rtime
+ * @param end latest block end time (ADMObject::MaxTime if any block has no duration)
  *
- * @return true if object valid
+ * @return false if there are no blocks
+ *
+ * @note extents are maintained as blocks are inserted and only recalculated when
+ * @note a block that defined them is modified
+ * @note the recalculation updates the timeline so callers sharing a timeline between threads
+ * @note must serialise calls (see ADMAudioChannelFormat::GetBlockExtents())
  */
 /*--------------------------------------------------------------------------------*/
-bool ADMAudioChannelFormat::GetContainedObject(uint_t n, CONTAINEDOBJECT& object) const
+bool ADMAudioBlockTimeline::GetExtents(uint64_t& start, uint64_t& end) const
 {
+  uint_t i, n = size();
   bool success = false;
 
-  if (n < blockformatrefs.size())
+  if (n)
   {
-    const ADMAudioBlockFormat *block = blockformatrefs[n];
-    
-    object.type = block->GetType();
-    object.attrs.clear();
-    object.values.clear();
+    if (!extentsvalid)
+    {
+      minstart = rtimes[0];
+      maxend   = GetEndTime(0);
+      for (i = 1; i < n; i++)
+      {
+        minstart = std::min(minstart, rtimes[i]);
+        maxend   = std::max(maxend,   GetEndTime(i));
+      }
 
-    XMLValue value;
-    std::string id;
-    Printf(id, "%s%s_%08x", block->GetIDPrefix().c_str(), GetID().substr(GetIDPrefix().length()).c_str(), n + 1);
-    value.SetAttribute(block->GetType() + "ID", id);
-    object.attrs.AddValue(value);
-    
-    block->GetValues(object.attrs, object.values);
-    
+      extentsvalid = true;
+    }
+
+    start   = minstart;
+    end     = maxend;
     success = true;
   }
-  
+
   return success;
 }
 
-/*----------------------------------------------------------------------------------------------------*/
-
-const std::string ADMAudioBlockFormat::Type      = "audioBlockFormat";
-const std::string ADMAudioBlockFormat::Reference = Type + "IDRef";
-const std::string ADMAudioBlockFormat::IDPrefix  = "AB_";
-
 /*--------------------------------------------------------------------------------*/
-/** ADM AudioBlockFormat object
+/** Find block that covers time t (relative to start of object)
+ *
+ * @param t time relative to the start of the audio object
+ * @param hint index to start search from (usually the index returned by the previous call)
+ *
+ * @return index of last block whose rtime is <= t (or 0 if t is before the first block)
+ *
+ * @note the area around hint is checked first before resorting to a binary search
  */
 /*--------------------------------------------------------------------------------*/
-ADMAudioBlockFormat::ADMAudioBlockFormat() :
-  rtime(0),
-  duration(0),
-  rtimeSet(false),
-  durationSet(false)
+uint_t ADMAudioBlockTimeline::Find(uint64_t t, uint_t hint) const
 {
-}
+  uint_t n = size();
 
-ADMAudioBlockFormat::ADMAudioBlockFormat(const ADMAudioBlockFormat *obj) :
-  objparameters(obj->objparameters),
-  rtime(obj->rtime),
-  duration(obj->duration),
-  rtimeSet(obj->rtimeSet),
-  durationSet(obj->durationSet)
-{
-}
+  if (!n) return 0;
+
+  hint = std::min(hint, n - 1);
+
+  // during playback the cursor will either stay in the same block or move on by one so check those first
+  if (t >= rtimes[hint])
+  {
+    if (((hint + 1) >= n) || (t < rtimes[hint + 1])) return hint;
+    if (((hint + 2) >= n) || (t < rtimes[hint + 2])) return hint + 1;
+  }
+
+  // binary search of the rtime column
+  std::vector<uint64_t>::const_iterator it = std::upper_bound(rtimes.begin(), rtimes.end(), t);
+
+  return (it != rtimes.begin()) ? (uint_t)(it - rtimes.begin()) - 1 : 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return position of block n
+ *
+ * @return true if block has a position set
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioBlockTimeline::GetPosition(uint_t n, Position& pos) const
+{
+  bool success = false;
+
+  if ((n < size()) && (flags[n] & Flag_Position))
+  {
+    pos.polar = ((flags[n] & Flag_Polar) != 0);
+    if (pos.polar)
+    {
+      pos.pos.az = positions[0][n];
+      pos.pos.el = positions[1][n];
+      pos.pos.d  = positions[2][n];
+    }
+    else
+    {
+      pos.pos.x  = positions[0][n];
+      pos.pos.y  = positions[1][n];
+      pos.pos.z  = positions[2][n];
+    }
+
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return value of sparse column for block n
+ *
+ * @param column Sparse_xxx column index
+ * @param n block index
+ * @param val value to be updated
+ *
+ * @return true if value set for block
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioBlockTimeline::GetSparseValue(uint_t column, uint_t n, float& val) const
+{
+  bool success = false;
+
+  if (column < NUMBEROF(sparse))
+  {
+    SPARSECOLUMN::const_iterator it = std::lower_bound(sparse[column].begin(), sparse[column].end(), n, &CompareSparseIndex);
+
+    if ((it != sparse[column].end()) && (it->index == n))
+    {
+      val     = it->value;
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Set or clear value in sparse column
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioBlockTimeline::SetSparseValue(SPARSECOLUMN& column, uint_t n, bool set, float val)
+{
+  SPARSECOLUMN::iterator it = std::lower_bound(column.begin(), column.end(), n, &CompareSparseIndex);
+  bool found = ((it != column.end()) && (it->index == n));
+
+  if (set)
+  {
+    if (found) it->value = val;
+    else
+    {
+      SPARSEVALUE value = {n, val};
+      column.insert(it, value);
+    }
+  }
+  else if (found) column.erase(it);
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+const std::string ADMAudioChannelFormat::Type      = "audioChannelFormat";
+const std::string ADMAudioChannelFormat::Reference = Type + "IDRef";
+const std::string ADMAudioChannelFormat::IDPrefix  = "AC_";
+
+ThreadLockObject ADMAudioChannelFormat::blockdatalock;
+uint64_t         ADMAudioChannelFormat::loadsequence = 0;
+bool             ADMAudioChannelFormat::xmlcaching = false;
+
+ADMAudioChannelFormat::ADMAudioChannelFormat(ADMData& _owner, const std::string& _id, const std::string& _name) : ADMObject(_owner, _id, _name),
+                                                                                                                blockdata(new BLOCKDATA)
+{
+  Register();
+
+  InitBlockData(*blockdata);
+  xmllengths.enabled    = false;
+  xmllengths.generation = blockdata->generation;
+  ResetXMLLengths();
+  xmlcache.level = 0;
+}
+
+ADMAudioChannelFormat::ADMAudioChannelFormat(ADMData& _owner, const ADMAudioChannelFormat *obj, bool share) : ADMObject(_owner, obj),
+                                                                                                             blockdata(NULL)
+{
+  Register();
+
+  xmlcache.level = 0;
+
+  // blocks are identical so XML lengths can be copied as is (they are reset if they are for different block data)
+  xmllengths = obj->xmllengths;
+
+  if (share)
+  {
+    // take a reference to obj's block formats, they will be cloned when either object modifies them
+    ThreadLock lock(blockdatalock);
+    blockdata = obj->blockdata;
+    blockdata->refcount++;
+  }
+  else
+  {
+    blockdata = new BLOCKDATA;
+    InitBlockData(*blockdata);
+
+    // copy all blockformats from obj
+    ADMAudioBlockFormatRefs oldblockformatrefs = obj->GetBlockFormatRefs();
+    uint_t i;
+    blockdata->blockformatrefs.reserve(oldblockformatrefs.size());
+    for (i = 0; i < oldblockformatrefs.size(); i++)
+    {
+      blockdata->blockformatrefs.push_back(new ADMAudioBlockFormat(oldblockformatrefs[i]));
+    }
+
+    // blocks are identical so timeline can be copied as is
+    blockdata->timeline = obj->GetTimeline();
+
+    {
+      ThreadLock lock(blockdatalock);
+      if (xmllengths.generation != obj->blockdata->generation) ResetXMLLengths();
+      xmllengths.generation = blockdata->generation;
+    }
+  }
+}
+
+ADMAudioChannelFormat::~ADMAudioChannelFormat()
+{
+  Release(blockdata);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Clone block formats if they are shared with another channel format
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::Unshare()
+{
+  // shared block formats must be decoded before they can be cloned
+  LoadBlockFormats();
+
+  // only this object can add references to unshared data so it is safe to test without the lock
+  if (blockdata->refcount > 1)
+  {
+    ThreadLock lock(blockdatalock);
+
+    if (blockdata->refcount > 1)
+    {
+      const std::vector<ADMAudioBlockFormat *>& oldblockformatrefs = blockdata->blockformatrefs;
+      BLOCKDATA *newblockdata = new BLOCKDATA;
+      uint_t i;
+
+      InitBlockData(*newblockdata);
+      newblockdata->blockformatrefs.reserve(oldblockformatrefs.size());
+      for (i = 0; i < oldblockformatrefs.size(); i++)
+      {
+        newblockdata->blockformatrefs.push_back(new ADMAudioBlockFormat(oldblockformatrefs[i]));
+      }
+      newblockdata->timeline   = blockdata->timeline;
+      newblockdata->generation = blockdata->generation;
+
+      BBCDEBUG3(("Cloned %u shared blockformats for channel format %s", (uint_t)oldblockformatrefs.size(), ToString().c_str()));
+
+      blockdata->refcount--;
+      blockdata = newblockdata;
+    }
+  }
+
+  // block formats are about to be modified so any copy in a store is out of date
+  if (blockdata->store.Valid())
+  {
+    ThreadLock lock(blockdatalock);
+    blockdata->store = NULL;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Initialise block data
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::InitBlockData(BLOCKDATA& data)
+{
+  data.refcount     = 1;
+  data.pending      = NULL;
+  data.storepos     = 0;
+  data.storelen     = 0;
+  data.loadsequence = 0;
+  data.generation   = 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Forget all block format XML lengths (they are measured again when next requested)
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::ResetXMLLengths() const
+{
+  std::vector<uint32_t>().swap(xmllengths.lengths);
+  std::vector<uint32_t>().swap(xmllengths.indents);
+  xmllengths.length      = 0;
+  xmllengths.indentcount = 0;
+  xmllengths.unknown     = 0;
+  xmllengths.modified    = ~(uint_t)0;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return true if block formats are already in time order
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioChannelFormat::BlockFormatsSorted(const std::vector<ADMAudioBlockFormat *>& blocks)
+{
+  uint_t i;
+
+  for (i = 1; i < blocks.size(); i++)
+  {
+    if (ADMAudioBlockFormat::Compare(blocks[i], blocks[i - 1])) break;
+  }
+
+  return (i >= blocks.size());
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Release reference to block data, deleting it (and its block formats) if no longer used
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::Release(BLOCKDATA *data)
+{
+  bool unused;
+
+  {
+    ThreadLock lock(blockdatalock);
+    unused = !--data->refcount;
+
+    // release reference to XML whilst locked since other channel formats may be decoding from it
+    if (unused && data->pending)
+    {
+      delete data->pending;
+      data->pending = NULL;
+    }
+    if (unused) data->store = NULL;
+  }
+
+  if (unused)
+  {
+    // delete all block formats
+    uint_t i;
+    for (i = 0; i < data->blockformatrefs.size(); i++) delete data->blockformatrefs[i];
+    delete data;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Defer decoding of block formats until they are first accessed
+ *
+ * @param xml buffer holding XML (usually shared between all channel formats of an ADM)
+ * @param start offset of first audioBlockFormat element in xml
+ * @param end offset of end of last audioBlockFormat element in xml
+ * @param decoder function used to decode the audioBlockFormat elements
+ * @param extentsknown true if minstart and maxend are valid
+ * @param minstart earliest block rtime (as ADMAudioBlockTimeline::GetExtents())
+ * @param maxend latest block end time (as ADMAudioBlockTimeline::GetExtents())
+ *
+ * @note block formats are decoded by any access to them or the timeline
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::SetPendingBlockFormats(const RefCount<std::string>& xml, size_t start, size_t end, BLOCKFORMATDECODER decoder, bool extentsknown, uint64_t minstart, uint64_t maxend)
+{
+  PENDINGBLOCKS *pending;
+
+  // decode any existing pending blocks and ensure blocks are not shared
+  Unshare();
+
+  if ((pending = new PENDINGBLOCKS) != NULL)
+  {
+    pending->xml          = xml;
+    pending->start        = start;
+    pending->end          = end;
+    pending->decoder      = decoder;
+    pending->storepos     = 0;
+    pending->storelen     = 0;
+    pending->extentsknown = extentsknown;
+    pending->minstart     = minstart;
+    pending->maxend       = maxend;
+
+    ThreadLock lock(blockdatalock);
+    blockdata->pending = pending;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Move block formats out of memory into a store, they are read back when next accessed
+ *
+ * @param store store to write the block formats to
+ *
+ * @return true if the block formats were moved to the store
+ *
+ * @note block formats that are shared or pending are not stored
+ * @note block formats read back from the same store and not modified since are not written
+ * @note again, the run they were read from is reused
+ * @note the extents of the block formats are retained (see GetBlockExtents())
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioChannelFormat::StoreBlockFormats(const RefCount<ADMBlockFormatStore>& store)
+{
+  std::vector<ADMAudioBlockFormat *>& blockformatrefs = blockdata->blockformatrefs;
+  PENDINGBLOCKS *pending;
+  uint64_t pos = blockdata->storepos, len = blockdata->storelen;
+  bool reuse   = (store.Valid() && (blockdata->store.Obj() == store.Obj()));
+  bool success = false;
+
+  // only this object can add references to unshared data so it is safe to test without the lock
+  if (store.Valid() &&
+      !BlockFormatsPending() &&
+      !BlockFormatsShared() &&
+      blockformatrefs.size() &&
+      (reuse || store->Write(blockformatrefs, pos, len)) &&
+      ((pending = new PENDINGBLOCKS) != NULL))
+  {
+    uint_t i, n = (uint_t)blockformatrefs.size();
+
+    pending->start        = 0;
+    pending->end          = 0;
+    pending->decoder      = NULL;
+    pending->store        = store;
+    pending->storepos     = pos;
+    pending->storelen     = len;
+    pending->extentsknown = ((blockdata->timeline.size() == n) && blockdata->timeline.GetExtents(pending->minstart, pending->maxend));
+
+    // delete block formats and release the memory used by the list and timeline
+    for (i = 0; i < n; i++) delete blockformatrefs[i];
+    std::vector<ADMAudioBlockFormat *>().swap(blockformatrefs);
+    blockdata->timeline.Clear(true);
+
+    {
+      ThreadLock lock(blockdatalock);
+      blockdata->pending = pending;
+      blockdata->store   = NULL;
+    }
+
+    BBCDEBUG3(("%s %u block formats of %s", reuse ? "Reused stored" : "Stored", n, ToString().c_str()));
+
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return approximate memory used by each block format held in memory (including
+ * its entry in the timeline)
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t ADMAudioChannelFormat::GetBlockFormatMemory()
+{
+  // block format, reference to it and the dense columns of the timeline
+  return (uint_t)(sizeof(ADMAudioBlockFormat) + sizeof(ADMAudioBlockFormat *) +
+                  2 * sizeof(uint64_t) + sizeof(uint8_t) + 4 * sizeof(double) + sizeof(float));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Decode pending block formats
+ *
+ * @note the lock is held whilst decoding so that channel formats sharing the same
+ * @note block data decode it only once
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::DecodePendingBlockFormats() const
+{
+  ThreadLock lock(blockdatalock);
+  PENDINGBLOCKS *pending;
+
+  if ((pending = blockdata->pending) != NULL)
+  {
+    std::vector<ADMAudioBlockFormat *>& blockformatrefs = blockdata->blockformatrefs;
+    std::vector<ADMAudioBlockFormat *>  blocks;
+    bool success;
+
+    if (pending->store.Valid())
+    {
+      // block formats were moved out of memory by StoreBlockFormats()
+      success = pending->store->Read(pending->storepos, pending->storelen, blocks);
+    }
+    else
+    {
+      const char *xml = pending->xml->c_str();
+
+      success = (*pending->decoder)(*this, xml + pending->start, xml + pending->end, blocks);
+    }
+
+    if (!success)
+    {
+      BBCERROR("Failed to decode pending block formats of %s", ToString().c_str());
+    }
+
+    // nothing is returned from a store that fails to read so the block formats are
+    // left pending rather than being lost (the XML decoder keeps what it could decode)
+    if (success || !pending->store.Valid())
+    {
+      BBCDEBUG2(("Decoded %u pending block formats of %s", (uint_t)blocks.size(), ToString().c_str()));
+
+      // XML lengths are kept for block formats read back from a store (which preserves
+      // their order) unless sorting would reorder them
+      if (!pending->store.Valid() || blockformatrefs.size() || !BlockFormatsSorted(blocks))
+      {
+        // lengths held by other channel formats sharing the block data are reset when next used
+        blockdata->generation++;
+        ResetXMLLengths();
+        InvalidateXMLCache(0);
+      }
+      else
+      {
+        // until they are modified, the block formats can be moved back to the same run of the store
+        blockdata->store    = pending->store;
+        blockdata->storepos = pending->storepos;
+        blockdata->storelen = pending->storelen;
+      }
+
+      if (pending->store.Valid()) blockdata->loadsequence = ++loadsequence;
+
+      // blocks are usually already in time order
+      blockformatrefs.insert(blockformatrefs.end(), blocks.begin(), blocks.end());
+      std::stable_sort(blockformatrefs.begin(), blockformatrefs.end(), ADMAudioBlockFormat::Compare);
+      blockdata->timeline.Rebuild(blockformatrefs);
+
+      blockdata->pending = NULL;
+      delete pending;
+    }
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return earliest start and latest end of all blocks (relative to start of object)
+ *
+ * @note if block formats are pending and their extents are known, they are NOT decoded
+ *
+ * @return false if there are no blocks
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioChannelFormat::GetBlockExtents(uint64_t& start, uint64_t& end) const
+{
+  bool known = false;
+
+  {
+    ThreadLock lock(blockdatalock);
+    const PENDINGBLOCKS *pending;
+
+    if (((pending = blockdata->pending) != NULL) && pending->extentsknown)
+    {
+      start = pending->minstart;
+      end   = pending->maxend;
+      known = true;
+    }
+  }
+
+  if (!known)
+  {
+    const ADMAudioBlockTimeline& timeline = GetTimeline();
+
+    // the timeline calculates its extents when first requested and may be shared
+    // with other channel formats so the lock is held to serialise the calculation
+    ThreadLock lock(blockdatalock);
+    known = timeline.GetExtents(start, end);
+  }
+
+  return known;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Set internal variables from values added to internal list (e.g. from XML)
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::SetValues()
+{
+  ADMObject::SetValues();
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Update object's ID
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::UpdateID()
+{
+  // call SetID() with new ID
+  std::string _id, oldid = GetID();
+
+  Printf(_id, "%04x%%04x", typeLabel);
+
+  // custom channel formats start indexing at 0x1000
+  SetID(GetIDPrefix() + _id, 0x1000);
+
+  // cached block format XML contains IDs derived from this one
+  if (GetID() != oldid) InvalidateXMLCache(0);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Sort block formats in time order (and rebuild timeline)
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::SortBlockFormats()
+{
+  // pending block formats are sorted when they are decoded
+  if (!BlockFormatsPending())
+  {
+    Unshare();
+
+    // XML lengths are kept unless the block formats are reordered
+    if (!BlockFormatsSorted(blockdata->blockformatrefs))
+    {
+      std::sort(blockdata->blockformatrefs.begin(), blockdata->blockformatrefs.end(), ADMAudioBlockFormat::Compare);
+      ResetXMLLengths();
+      InvalidateXMLCache(0);
+    }
+
+    // blocks may have been modified since they were added so rebuild the timeline completely
+    blockdata->timeline.Rebuild(blockdata->blockformatrefs);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Remove redundant block formats
+ *
+ * @param tolerances maximum errors allowed in positions, gains and widths
+ *
+ * @return number of block formats removed
+ *
+ * A run of contiguous block formats is replaced by the last block format of the run
+ * (its rtime and duration extended to cover the run) if the position, gain and width
+ * of each block format in the run is within tolerance of the linear interpolation
+ * between the preceding block format and the end of the run (or, for block formats
+ * that jump to their position, of the end of the run) and all other values are identical
+ *
+ * @note MUST NOT be called whilst a cursor is writing block formats to this channel format
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t ADMAudioChannelFormat::SimplifyBlockFormats(const SIMPLIFYTOLERANCES& tolerances)
+{
+  std::vector<ADMAudioBlockFormat *>& blockformatrefs = GetBlockFormatRefs();
+  std::vector<ADMAudioBlockFormat *>  blocks;
+  std::vector<bool> joinable;
+  XMLValues values, nextvalues;
+  uint_t    i, j, k, n = (uint_t)blockformatrefs.size(), removed = 0;
+
+  // a block format can be joined to the next if the next starts where it ends and
+  // has identical values other than position, gain and width
+  joinable.resize(n, false);
+  if (n) GetOtherBlockFormatValues(blockformatrefs[0], values);
+  for (i = 0; (i + 1) < n; i++)
+  {
+    const ADMAudioBlockFormat *block = blockformatrefs[i];
+    const ADMAudioBlockFormat *next  = blockformatrefs[i + 1];
+
+    nextvalues.clear();
+    GetOtherBlockFormatValues(next, nextvalues);
+
+    joinable[i] = (block->RTimeSet() && block->DurationSet() && block->GetDuration() &&
+                   next->RTimeSet()  && next->DurationSet()  && next->GetDuration()  &&
+                   (next->GetRTime() == (block->GetRTime() + block->GetDuration())) &&
+                   (values == nextvalues));
+
+    values.swap(nextvalues);
+  }
+
+  blocks.reserve(n);
+  for (i = 0; i < n; i = j)
+  {
+    const ADMAudioBlockFormat *start = blockformatrefs[i];
+    uint_t best = i + 1;
+
+    // block format i is kept, find the longest run i + 1 .. j that can be replaced by block format j
+    blocks.push_back(blockformatrefs[i]);
+    for (j = i + 2; (j < n) && joinable[j - 2] && joinable[j - 1]; j++)
+    {
+      const ADMAudioBlockFormat *end = blockformatrefs[j];
+      uint64_t t0 = start->GetRTime() + start->GetDuration();
+      uint64_t t1 = end->GetRTime() + end->GetDuration();
+
+      for (k = i + 1; k < j; k++)
+      {
+        const ADMAudioBlockFormat *block = blockformatrefs[k];
+        double f = (double)(block->GetRTime() + block->GetDuration() - t0) / (double)(t1 - t0);
+
+        if (!WithinTolerance(block->GetObjectParameters(), start->GetObjectParameters(), end->GetObjectParameters(), f, tolerances)) break;
+      }
+
+      if (k < j) break;
+
+      best = j;
+    }
+
+    if (best > (i + 1))
+    {
+      ADMAudioBlockFormat *end = blockformatrefs[best];
+      uint64_t rtime = blockformatrefs[i + 1]->GetRTime();
+      uint64_t t1    = end->GetRTime() + end->GetDuration();
+
+      // extend last block format of the run to cover the whole run
+      end->SetRTime(rtime);
+      end->SetDuration(t1 - rtime);
+
+      for (k = i + 1; k < best; k++) delete blockformatrefs[k];
+      removed += best - (i + 1);
+    }
+
+    j = best;
+  }
+
+  if (removed)
+  {
+    BBCDEBUG2(("Simplified %s from %u to %u block formats", ToString().c_str(), n, (uint_t)blocks.size()));
+
+    blockformatrefs.swap(blocks);
+    UpdateTimeline();
+  }
+
+  return removed;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return values of block format other than its position, gain and width
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::GetOtherBlockFormatValues(const ADMAudioBlockFormat *block, XMLValues& values)
+{
+  XMLValues attrs, allvalues;
+  uint_t i;
+
+  block->GetValues(attrs, allvalues);
+
+  for (i = 0; i < allvalues.size(); i++)
+  {
+    const XMLValue& value = allvalues[i];
+
+    // position bounds are not interpolated so must be identical
+    if (((value.name == "position") && !value.GetAttribute("bound")) ||
+        (value.name == "gain") ||
+        (value.name == "width")) continue;
+
+    values.push_back(value);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return true if position, gain and width are within tolerance of those interpolated
+ * between two other sets of parameters
+ *
+ * @param params parameters to test
+ * @param startparams parameters at the start of the interpolation
+ * @param endparams parameters at the end of the interpolation
+ * @param f fraction of the way between start and end
+ * @param tolerances maximum errors
+ *
+ * @note parameters that jump to their position are compared with endparams
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioChannelFormat::WithinTolerance(const AudioObjectParameters& params, const AudioObjectParameters& startparams, const AudioObjectParameters& endparams, double f, const SIMPLIFYTOLERANCES& tolerances)
+{
+  double dval, dstart, dend;
+  float  fval, fstart, fend;
+  bool   bval, within = true;
+
+  // parameters that jump to their position are compared with the end
+  if (params.GetJumpPosition(bval) && bval) f = 1.0;
+
+  if (params.IsPositionSet() != endparams.IsPositionSet()) within = false;
+  else if (params.IsPositionSet())
+  {
+    const Position& pos      = params.GetPosition();
+    const Position& startpos = startparams.IsPositionSet() ? startparams.GetPosition() : endparams.GetPosition();
+    const Position& endpos   = endparams.GetPosition();
+
+    within = ((pos.polar == endpos.polar) && (startpos.polar == endpos.polar));
+    if (within)
+    {
+      if (pos.polar)
+      {
+        within = ((fabs(startpos.pos.az + (endpos.pos.az - startpos.pos.az) * f - pos.pos.az) <= tolerances.angle) &&
+                  (fabs(startpos.pos.el + (endpos.pos.el - startpos.pos.el) * f - pos.pos.el) <= tolerances.angle) &&
+                  (fabs(startpos.pos.d  + (endpos.pos.d  - startpos.pos.d)  * f - pos.pos.d)  <= tolerances.distance));
+      }
+      else
+      {
+        within = ((fabs(startpos.pos.x + (endpos.pos.x - startpos.pos.x) * f - pos.pos.x) <= tolerances.distance) &&
+                  (fabs(startpos.pos.y + (endpos.pos.y - startpos.pos.y) * f - pos.pos.y) <= tolerances.distance) &&
+                  (fabs(startpos.pos.z + (endpos.pos.z - startpos.pos.z) * f - pos.pos.z) <= tolerances.distance));
+      }
+    }
+  }
+
+  if (within)
+  {
+    if (params.GetGain(dval) != endparams.GetGain(dend)) within = false;
+    else if (params.GetGain(dval))
+    {
+      if (!startparams.GetGain(dstart)) dstart = dend;
+      within = (fabs(dstart + (dend - dstart) * f - dval) <= tolerances.gain);
+    }
+  }
+
+  if (within)
+  {
+    if (params.GetWidth(fval) != endparams.GetWidth(fend)) within = false;
+    else if (params.GetWidth(fval))
+    {
+      if (!startparams.GetWidth(fstart)) fstart = fend;
+      within = (fabs((double)fstart + ((double)fend - (double)fstart) * f - (double)fval) <= tolerances.width);
+    }
+  }
+
+  return within;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Merge copies of the block formats of another channel format (e.g. from a Serial ADM
+ * frame) into this one
+ *
+ * @param channelformat channel format to take block formats from
+ *
+ * @return number of block formats added or replaced
+ *
+ * Block formats starting before the last block format of this channel format are assumed
+ * to be held already and are ignored, a block format starting at the same time as the
+ * last replaces it (e.g. to set the duration of a block format that was still open) and
+ * later block formats are appended
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t ADMAudioChannelFormat::MergeBlockFormats(const ADMAudioChannelFormat& channelformat)
+{
+  ADMAudioBlockFormatRefs                   blocks          = channelformat.GetBlockFormatRefs();
+  std::vector<ADMAudioBlockFormat *>&       blockformatrefs = GetBlockFormatRefs();
+  uint_t i, merged = 0;
+
+  for (i = 0; i < blocks.size(); i++)
+  {
+    uint_t   n = (uint_t)blockformatrefs.size();
+    uint64_t t = blocks[i]->GetStartTime();
+
+    if (!n || (t > blockformatrefs[n - 1]->GetStartTime()))
+    {
+      // new block format
+      Add(new ADMAudioBlockFormat(blocks[i]));
+      merged++;
+    }
+    else if (t == blockformatrefs[n - 1]->GetStartTime())
+    {
+      // last block format sent again (possibly now with its duration)
+      delete blockformatrefs[n - 1];
+      blockformatrefs[n - 1] = new ADMAudioBlockFormat(blocks[i]);
+      UpdateTimeline(n - 1);
+      merged++;
+    }
+  }
+
+  BBCDEBUG3(("Merged %u of %u block formats into %s", merged, (uint_t)blocks.size(), ToString().c_str()));
+
+  return merged;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Remove block formats that have been superseded at or before t
+ *
+ * @param t time (ns, relative to the start of the object) before which block formats are no longer required
+ *
+ * @return number of block formats removed
+ *
+ * @note the block format active at t (or the last block format) is always retained
+ * @note cursors reading this channel format re-find their block format on the next Seek()
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t ADMAudioChannelFormat::RemoveBlockFormatsBefore(uint64_t t)
+{
+  ADMAudioBlockFormatRefs blocks = static_cast<const ADMAudioChannelFormat *>(this)->GetBlockFormatRefs();
+  uint_t i, n = (uint_t)blocks.size(), removed = 0;
+
+  // block format i is superseded once block format i + 1 has started
+  while (((removed + 1) < n) && (blocks[removed + 1]->GetStartTime() <= t)) removed++;
+
+  if (removed)
+  {
+    std::vector<ADMAudioBlockFormat *>& blockformatrefs = GetBlockFormatRefs();
+
+    for (i = 0; i < removed; i++) delete blockformatrefs[i];
+    blockformatrefs.erase(blockformatrefs.begin(), blockformatrefs.begin() + removed);
+    UpdateTimeline();
+
+    BBCDEBUG3(("Removed %u of %u block formats from %s", removed, n, ToString().c_str()));
+  }
+
+  return removed;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Add reference to an AudioBlockFormat object and ensures blocks are sorted by time
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioChannelFormat::Add(ADMAudioBlockFormat *obj)
+{
+  Unshare();
+
+  std::vector<ADMAudioBlockFormat *>& blockformatrefs = blockdata->blockformatrefs;
+  ADMAudioBlockTimeline&              timeline        = blockdata->timeline;
+  uint64_t t = obj->GetStartTime();
+  uint_t   n = (uint_t)blockformatrefs.size();
+
+  // insert obj into list ordered by time
+
+  // allocate memory in large chunks to reduce re-allocation time
+  if (n == blockformatrefs.capacity())
+  {
+    blockformatrefs.reserve(blockformatrefs.capacity() + 1024);
+    timeline.Reserve((uint_t)blockformatrefs.capacity());
+  }
+
+  // if the list is empty just append
+  if (!n)
+  {
+    BBCDEBUG3(("blockformat list is empty: new item appended"));
+    blockformatrefs.push_back(obj);
+    timeline.Insert(n, obj);
+    BlockFormatChanged(n, true);
+  }
+  // the most likely place for the new item is on the end so check this first
+  else if (t >= blockformatrefs[n - 1]->GetStartTime())
+  {
+    // ensure the new object is not already in the list
+    if (obj != blockformatrefs[n - 1])
+    {
+      // new object just needs to be appended to list
+      BBCDEBUG3(("New item is beyond last item (%llu >= %llu): new item appended", t, blockformatrefs[n - 1]->GetStartTime()));
+      blockformatrefs.push_back(obj);
+      timeline.Insert(n, obj);
+      BlockFormatChanged(n, true);
+    }
+  }
+  // if the list has only one item or the new object is before the first item, new item must be inserted at the start
+  else if ((n == 1) || (t <= blockformatrefs[0]->GetStartTime()))
+  {
+    // ensure the new object is not already in the list
+    if (obj != blockformatrefs[0])
+    {
+      // new object just needs inserted at the start of the list
+      BBCDEBUG3(("New item is before first item (%llu <= %llu): new item inserted at start", t, blockformatrefs[0]->GetStartTime()));
+      blockformatrefs.insert(blockformatrefs.begin(), obj);
+      timeline.Insert(0, obj);
+      BlockFormatChanged(0, true);
+    }
+  }
+  // object should be placed somewhere in the list but not at the end (checked above)
+  // list has at least two entries
+  else
+  {
+    // start at the middle of the list and use a binary search
+    uint_t inc = (n + 1) >> 1;      // round up division
+    uint_t pos = std::min(inc, n - 2);                                 // start in the middle but ensure the last position is never checked (no point)
+    uint_t count = 0;
+
+    // break out when the new object is between the current and next item
+    while (!((t >= blockformatrefs[pos]->GetStartTime()) &&
+             (t <  blockformatrefs[pos + 1]->GetStartTime())))
+    {
+      // half increment (rounding up to ensure it is always non-zero)
+      inc = (inc + 1) >> 1;
+
+      // if the new item is before the current one, move back by the increment
+      if (t < blockformatrefs[pos]->GetStartTime())
+      {
+        if (pos >= inc) pos -= inc;
+        else            pos  = 0;
+      }
+      // else move forward by the increment, limiting to the end but one item
+      else pos = std::min(pos + inc, n - 2);
+
+      count++;
+    }
+
+    // check that the item isn't already in the list
+    if (obj != blockformatrefs[pos])
+    {
+      (void)count;
+
+      BBCDEBUG3(("New item is between indexes %u and %u (%llu <= %llu < %llu) (%u iterations): new item inserted between them", pos, pos + 1, blockformatrefs[pos]->GetStartTime(), t, blockformatrefs[pos + 1]->GetStartTime(), count));
+
+      // the new item is between the pos'th and pos+1'th item
+      // but insert works by inserting *before* the given position
+      // therefore the position needs to be incremented by one
+      pos++;
+
+      blockformatrefs.insert(blockformatrefs.begin() + pos, obj);
+      timeline.Insert(pos, obj);
+      BlockFormatChanged(pos, true);
+    }
+  }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return list of values/attributes from internal variables and list of referenced objects
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::GetValuesAndReferences(XMLValues& objvalues, std::vector<REFERENCEDOBJECT>& objects, bool full) const
+{
+  // populate list from parent object
+  ADMObject::GetValuesAndReferences(objvalues, objects, full);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Generate a textual list of references 
+ *
+ * @param str string to be modified
+ *
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::GenerateReferenceList(std::string& str) const
+{
+  UNUSED_PARAMETER(str);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Provide a way of accessing contained items without knowing what they are
+ * (used for block formats)
+ *
+ * @param n object index
+ * @param object structure to be filled
+ *
+ * @return true if object valid
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioChannelFormat::GetContainedObject(uint_t n, CONTAINEDOBJECT& object) const
+{
+  ADMAudioBlockFormatRefs blockformatrefs = GetBlockFormatRefs();
+  bool success = false;
+
+  if (n < blockformatrefs.size())
+  {
+    const ADMAudioBlockFormat *block = blockformatrefs[n];
+    
+    object.type = block->GetType();
+    object.attrs.clear();
+    object.values.clear();
+
+    XMLValue value;
+    std::string id;
+    Printf(id, "%s%s_%08x", block->GetIDPrefix().c_str(), GetID().substr(GetIDPrefix().length()).c_str(), n + 1);
+    value.SetAttribute(block->GetType() + "ID", id);
+    object.attrs.AddValue(value);
+    
+    block->GetValues(object.attrs, object.values);
+    
+    success = true;
+  }
+  
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return length of the XML of all block formats without generating it
+ *
+ * @param indent indent string used within XML
+ * @param eol end of line string used within XML
+ * @param level indentation level of the block formats
+ * @param length updated with length of XML
+ *
+ * @return false if the length is not accounted for (the XML must be generated to find it)
+ *
+ * @note the first call measures each block format, after that the lengths are maintained
+ * @note as block formats are added or updated (through Add() and UpdateTimeline()) so that
+ * @note subsequent calls with the same indent and eol only measure modified block formats
+ * @note block formats modified directly (via GetBlockFormatRefs()) MUST be followed by
+ * @note UpdateTimeline() for their lengths to be updated
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMAudioChannelFormat::GetContainedObjectsXMLLength(const std::string& indent, const std::string& eol, uint_t level, uint64_t& length) const
+{
+  bool success = false;
+
+  if (ADMXMLGenerator::CanMeasureXML(indent, eol))
+  {
+    ADMAudioBlockFormatRefs blockformatrefs = GetBlockFormatRefs();
+    uint_t i, n = (uint_t)blockformatrefs.size(), generation;
+
+    {
+      ThreadLock lock(blockdatalock);
+      generation = blockdata->generation;
+    }
+
+    // lengths are only valid for the formatting and block data they were measured with
+    if (!xmllengths.enabled || (indent != xmllengths.indent) || (eol != xmllengths.eol) || (generation != xmllengths.generation))
+    {
+      ResetXMLLengths();
+      xmllengths.indent     = indent;
+      xmllengths.eol        = eol;
+      xmllengths.generation = generation;
+      xmllengths.enabled    = true;
+    }
+
+    // if block formats have changed other than through Add() and UpdateTimeline(), start again
+    if (xmllengths.lengths.size() != n)
+    {
+      ResetXMLLengths();
+      xmllengths.lengths.resize(n, 0);
+      xmllengths.indents.resize(n, 0);
+      xmllengths.unknown = n;
+    }
+
+    for (i = 0; xmllengths.unknown && (i < n); i++) MeasureXMLLength(i);
+
+    length = xmllengths.length + xmllengths.indentcount * level * indent.length();
+
+    if (n)
+    {
+      // IDs of block formats all have the same length since the index is always 8 hex digits
+      std::string id;
+      Printf(id, "%s%s_%08x", blockformatrefs[0]->GetIDPrefix().c_str(), GetID().substr(GetIDPrefix().length()).c_str(), 1);
+      length += (uint64_t)n * ADMXMLGenerator::GetXMLAttributeLength(blockformatrefs[0]->GetType() + "ID", id);
+    }
+
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Measure XML length of block format n if it is not known
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::MeasureXMLLength(uint_t n) const
+{
+  if ((n < xmllengths.lengths.size()) && !xmllengths.lengths[n])
+  {
+    uint_t length, indents;
+
+    ADMXMLGenerator::MeasureBlockFormatXML(blockdata->blockformatrefs[n], xmllengths.indent, xmllengths.eol, length, indents);
+
+    xmllengths.lengths[n]   = length;
+    xmllengths.indents[n]   = indents;
+    xmllengths.length      += length;
+    xmllengths.indentcount += indents;
+    xmllengths.unknown--;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Update XML lengths and cached XML after block format n has been inserted or modified
+ *
+ * @param n block format index
+ * @param inserted true if block format has been inserted, false if it has been modified
+ *
+ * @note the previously modified block format (which is assumed to be complete) is measured
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::BlockFormatChanged(uint_t n, bool inserted)
+{
+  uint_t nlengths = (uint_t)xmllengths.lengths.size();
+
+  // XML of this and all subsequent block formats (whose IDs may have changed) is invalid
+  InvalidateXMLCache(n);
+
+  // lengths are only maintained once requested and whilst they match the block formats
+  if (xmllengths.enabled && (nlengths + (inserted ? 1 : 0) == blockdata->blockformatrefs.size()))
+  {
+    if (inserted)
+    {
+      xmllengths.lengths.insert(xmllengths.lengths.begin() + n, 0);
+      xmllengths.indents.insert(xmllengths.indents.begin() + n, 0);
+      xmllengths.unknown++;
+
+      if ((xmllengths.modified < nlengths) && (xmllengths.modified >= n)) xmllengths.modified++;
+    }
+    else if (xmllengths.lengths[n])
+    {
+      // forget length of modified block format
+      xmllengths.length      -= xmllengths.lengths[n];
+      xmllengths.indentcount -= xmllengths.indents[n];
+      xmllengths.lengths[n]   = 0;
+      xmllengths.indents[n]   = 0;
+      xmllengths.unknown++;
+    }
+
+    // block formats are usually modified a few times just after they are added so
+    // measure the previously modified block format now that another is being modified
+    if (xmllengths.modified != n) MeasureXMLLength(xmllengths.modified);
+    xmllengths.modified = n;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return XML of all block formats from cache, generating only those not cached
+ *
+ * @param indent indent string used within XML
+ * @param eol end of line string used within XML
+ * @param level indentation level of the block formats
+ *
+ * @return cached XML or NULL if XML caching is disabled (see SetXMLCaching())
+ *
+ * @note cached XML is discarded from the first block format added or updated (through
+ * @note Add() and UpdateTimeline()) onwards so appending block formats (e.g. whilst
+ * @note recording) only generates the new block formats
+ * @note block formats modified directly (via GetBlockFormatRefs()) MUST be followed by
+ * @note UpdateTimeline() for the cached XML to be updated
+ */
+/*--------------------------------------------------------------------------------*/
+const std::string *ADMAudioChannelFormat::GetContainedObjectsXML(const std::string& indent, const std::string& eol, uint_t level) const
+{
+  const std::string *xml = NULL;
+
+  if (xmlcaching)
+  {
+    ADMAudioBlockFormatRefs blockformatrefs = GetBlockFormatRefs();
+    uint_t i;
+
+    // XML is only valid for the ID and formatting it was generated with
+    if ((GetID() != xmlcache.id) || (indent != xmlcache.indent) || (eol != xmlcache.eol) || (level != xmlcache.level))
+    {
+      InvalidateXMLCache(0);
+      xmlcache.id     = GetID();
+      xmlcache.indent = indent;
+      xmlcache.eol    = eol;
+      xmlcache.level  = level;
+    }
+
+    // if block formats have been removed other than through Add() and UpdateTimeline(), start again
+    if (xmlcache.offsets.size() > blockformatrefs.size()) InvalidateXMLCache(0);
+
+    BBCDEBUG3(("Generating XML for %u of %u block formats of %s", (uint_t)(blockformatrefs.size() - xmlcache.offsets.size()), (uint_t)blockformatrefs.size(), ToString().c_str()));
+
+    // generate XML of block formats not cached
+    for (i = (uint_t)xmlcache.offsets.size(); i < blockformatrefs.size(); i++)
+    {
+      const ADMAudioBlockFormat *block = blockformatrefs[i];
+      std::string id;
+
+      Printf(id, "%s%s_%08x", block->GetIDPrefix().c_str(), GetID().substr(GetIDPrefix().length()).c_str(), i + 1);
+
+      xmlcache.offsets.push_back(xmlcache.xml.length());
+      ADMXMLGenerator::AppendBlockFormatXML(xmlcache.xml, block, id, indent, eol, level);
+    }
+
+    xml = &xmlcache.xml;
+  }
+  else if (xmlcache.offsets.size())
+  {
+    // caching has been disabled, release cached XML
+    std::string().swap(xmlcache.xml);
+    std::vector<uint64_t>().swap(xmlcache.offsets);
+  }
+
+  return xml;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Discard cached XML of block formats n onwards
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::InvalidateXMLCache(uint_t n) const
+{
+  if (n < xmlcache.offsets.size())
+  {
+    xmlcache.xml.resize(xmlcache.offsets[n]);
+    xmlcache.offsets.resize(n);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Enable/disable caching of block format XML by all channel formats
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMAudioChannelFormat::SetXMLCaching(bool enable)
+{
+  xmlcaching = enable;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+const std::string ADMAudioBlockFormat::Type      = "audioBlockFormat";
+const std::string ADMAudioBlockFormat::Reference = Type + "IDRef";
+const std::string ADMAudioBlockFormat::IDPrefix  = "AB_";
+
+/*--------------------------------------------------------------------------------*/
+/** ADM AudioBlockFormat object
+ */
+/*--------------------------------------------------------------------------------*/
+ADMAudioBlockFormat::ADMAudioBlockFormat() :
+  rtime(0),
+  duration(0),
+  rtimeSet(false),
+  durationSet(false)
+{
+}
+
+ADMAudioBlockFormat::ADMAudioBlockFormat(const ADMAudioBlockFormat *obj) :
+  objparameters(obj->objparameters),
+  rtime(obj->rtime),
+  duration(obj->duration),
+  rtimeSet(obj->rtimeSet),
+  durationSet(obj->durationSet)
+{
+}
 
 /*--------------------------------------------------------------------------------*/
 /** Set internal variables from values added to internal list (e.g. from XML)
@@ -1696,7 +3063,7 @@ void ADMAudioBlockFormat::SetValues(XMLValues& values)
     objparameters.SetInterpolationTime(_time);
   }
   
-  for (it = values.begin(); it != values.end();)
+  for (it = values.begin(); it != values.end(); ++it)
   {
     const XMLValue& value = *it;
     
@@ -1705,14 +3072,12 @@ void ADMAudioBlockFormat::SetValues(XMLValues& values)
       bool val;
       
       if (Evaluate(value.value, val)) objparameters.SetCartesian(val);
-
-      it = values.erase(it);
     }
     else if (value.name == "position")
     {
       double val;
 
-      if (Evaluate(value.value, val))
+      if (XMLValues::ParseNumber(value.value.c_str(), val))
       {
         const std::string *coord, *bound, *scrlock;
         Position *pos = &position;      // default is 'normal' position
@@ -1751,48 +3116,36 @@ void ADMAudioBlockFormat::SetValues(XMLValues& values)
         }
       }
       else BBCERROR("Failed to evaluate '%s' as floating point number for position", value.value.c_str());
-
-      it = values.erase(it);
     }
     else if (value.name == "width")
     {
       float val;
 
-      if (Evaluate(value.value, val)) objparameters.SetWidth(val);
-
-      it = values.erase(it);
+      if (XMLValues::ParseNumber(value.value.c_str(), val)) objparameters.SetWidth(val);
     }
     else if (value.name == "depth")
     {
       float val;
 
-      if (Evaluate(value.value, val)) objparameters.SetDepth(val);
-
-      it = values.erase(it);
+      if (XMLValues::ParseNumber(value.value.c_str(), val)) objparameters.SetDepth(val);
     }
     else if (value.name == "height")
     {
       float val;
 
-      if (Evaluate(value.value, val)) objparameters.SetHeight(val);
-
-      it = values.erase(it);
+      if (XMLValues::ParseNumber(value.value.c_str(), val)) objparameters.SetHeight(val);
     }
     else if (value.name == "gain")
     {
       float val;
 
-      if (Evaluate(value.value, val)) objparameters.SetGain(val);
-
-      it = values.erase(it);
+      if (XMLValues::ParseNumber(value.value.c_str(), val)) objparameters.SetGain(val);
     }
     else if (value.name == "diffuse")
     {
       float val;
 
-      if (Evaluate(value.value, val)) objparameters.SetDiffuseness(val);
-
-      it = values.erase(it);
+      if (XMLValues::ParseNumber(value.value.c_str(), val)) objparameters.SetDiffuseness(val);
     }
     else if (value.name == "jumpPosition")
     {
@@ -1807,13 +3160,11 @@ void ADMAudioBlockFormat::SetValues(XMLValues& values)
         if (bval)
         {
           // if jumpPosition is set, read interpolationLength and use it for the interpolationtime
-          if ((it2 = value.attrs.find("interpolationLength")) != value.attrs.end()) Evaluate(it2->second, fval);
+          if ((it2 = value.attrs.find("interpolationLength")) != value.attrs.end()) XMLValues::ParseNumber(it2->second.c_str(), fval);
         }
 
         objparameters.SetJumpPosition(bval, fval);
       }
-      
-      it = values.erase(it);
     }
     else if (value.name == "channelLock")
     {
@@ -1827,42 +3178,34 @@ void ADMAudioBlockFormat::SetValues(XMLValues& values)
         objparameters.SetChannelLock(val);
 
         // read maxDistance, if it exists
-        if (((it2 = value.attrs.find("maxDistance")) != value.attrs.end()) && Evaluate(it2->second, fval)) objparameters.SetChannelLockMaxDistance(fval);
+        if (((it2 = value.attrs.find("maxDistance")) != value.attrs.end()) && XMLValues::ParseNumber(it2->second.c_str(), fval)) objparameters.SetChannelLockMaxDistance(fval);
       }
-      
-      it = values.erase(it);
     }
     else if (value.name == "objectDivergence")
     {
       float fval;
 
-      if (Evaluate(value.value, fval))
+      if (XMLValues::ParseNumber(value.value.c_str(), fval))
       {
         XMLValue::ATTRS::const_iterator it2;
         
         objparameters.SetDivergenceBalance(fval);
 
         // read maxDistance, if it exists
-        if (((it2 = value.attrs.find("azimuthRange")) != value.attrs.end()) && Evaluate(it2->second, fval)) objparameters.SetDivergenceAzimuth(fval);
+        if (((it2 = value.attrs.find("azimuthRange")) != value.attrs.end()) && XMLValues::ParseNumber(it2->second.c_str(), fval)) objparameters.SetDivergenceAzimuth(fval);
       }
-      
-      it = values.erase(it);
     }
     else if (value.name == "screenRef")
     {
       bool val;
 
       if (Evaluate(value.value, val)) objparameters.SetOnScreen(val);
-      
-      it = values.erase(it);
     }
     else if (value.name == "importance")
     {
       uint_t val;
 
       if (Evaluate(value.value, val)) objparameters.SetChannelImportance(val);
-      
-      it = values.erase(it);
     }
     else if (value.name == "zoneExclusion")
     {
@@ -1902,17 +3245,16 @@ void ADMAudioBlockFormat::SetValues(XMLValues& values)
         }
       }
       else BBCDEBUG1(("zoneExclusion value has no sub-values!"));
-      
-      it = values.erase(it);
     }
     else // any other parameters -> assume they are part of the supplement information
     {
       objparameters.SetOtherValue(value.name, value.value);
-
-      it = values.erase(it);
     }
   }
 
+  // all values have been consumed, remove them in one go
+  values.clear();
+
   // set position(s) within the audio object parameters object
   if (positionset)    objparameters.SetPosition(position);
   if (minpositionset) objparameters.SetMinPosition(minposition);
@@ -2186,8 +3528,11 @@ ADMTrackCursor::ADMTrackCursor(uint_t _channel) : AudioObjectCursor(),
                                                   blockindex(0),
                                                   currenttime(0),
                                                   blockformatstarted(false),
-                                                  objparametersvalid(false)
+                                                  objparametersvalid(false),
+                                                  capturepolicyset(false),
+                                                  capturetime(0)
 {
+  memset(&capturepolicy, 0, sizeof(capturepolicy));
 }
 
 ADMTrackCursor::ADMTrackCursor(const ADMTrackCursor& obj) : AudioObjectCursor(),
@@ -2196,7 +3541,10 @@ ADMTrackCursor::ADMTrackCursor(const ADMTrackCursor& obj) : AudioObjectCursor(),
                                                             blockindex(0),
                                                             currenttime(0),
                                                             blockformatstarted(false),
-                                                            objparametersvalid(false)
+                                                            objparametersvalid(false),
+                                                            capturepolicy(obj.capturepolicy),
+                                                            capturepolicyset(obj.capturepolicyset),
+                                                            capturetime(0)
 {
   uint_t i;
 
@@ -2241,9 +3589,9 @@ bool ADMTrackCursor::Add(const ADMAudioObject *object, bool sort)
                channel,
                object->ToString().c_str(),
                obj.channelformat->ToString().c_str(),
-               (uint_t)obj.channelformat->GetBlockFormatRefs().size(),
-               obj.channelformat->GetBlockFormatRefs().size() ? GenerateTime(obj.channelformat->GetBlockFormatRefs()[0]->GetStartTime()).c_str() : "0",
-               obj.channelformat->GetBlockFormatRefs().size() ? GenerateTime(obj.channelformat->GetBlockFormatRefs()[obj.channelformat->GetBlockFormatRefs().size() - 1]->GetEndTime()).c_str() : "0"));
+               (uint_t)GetBlockFormatRefs(obj).size(),
+               GetBlockFormatRefs(obj).size() ? GenerateTime(GetBlockFormatRefs(obj)[0]->GetStartTime()).c_str() : "0",
+               GetBlockFormatRefs(obj).size() ? GenerateTime(GetBlockFormatRefs(obj)[GetBlockFormatRefs(obj).size() - 1]->GetEndTime()).c_str() : "0"));
 
     added = true;
 
@@ -2358,7 +3706,7 @@ uint64_t ADMTrackCursor::GetStartTime() const
   if (objectlist.size() > 0)
   {
     const AUDIOOBJECT&                        objectdata   = objectlist[0];
-    const std::vector<ADMAudioBlockFormat *>& blockformats = objectdata.channelformat->GetBlockFormatRefs();
+    ADMAudioBlockFormatRefs                   blockformats = GetBlockFormatRefs(objectdata);
 
     if (blockformats.size() > 0)
     {
@@ -2385,7 +3733,7 @@ uint64_t ADMTrackCursor::GetEndTime() const
   if (objectlist.size() > 0)
   {
     const AUDIOOBJECT&                        objectdata   = objectlist[objectlist.size() - 1];
-    const std::vector<ADMAudioBlockFormat *>& blockformats = objectdata.channelformat->GetBlockFormatRefs();
+    ADMAudioBlockFormatRefs                   blockformats = GetBlockFormatRefs(objectdata);
 
     if (blockformats.size() > 0)
     {
@@ -2412,9 +3760,10 @@ const ADMAudioBlockFormat *ADMTrackCursor::GetBlockFormat() const
   if (objectindex < objectlist.size())
   {
     const AUDIOOBJECT&                        objectdata   = objectlist[objectindex];
-    const std::vector<ADMAudioBlockFormat *>& blockformats = objectdata.channelformat->GetBlockFormatRefs();
+    ADMAudioBlockFormatRefs                   blockformats = GetBlockFormatRefs(objectdata);
     
-    blockformat = blockformats[blockindex];
+    // block formats may have been removed since the last Seek()
+    if (blockindex < blockformats.size()) blockformat = blockformats[blockindex];
   }
   
   return blockformat;
@@ -2473,6 +3822,10 @@ ADMAudioBlockFormat *ADMTrackCursor::StartBlockFormat(uint64_t t)
     blockindex         = (uint_t)(objectdata.channelformat->GetBlockFormatRefs().size() - 1);
     blockformatstarted = true;
 
+    // nothing has been merged into the new block format yet
+    captureupdates.clear();
+    capturetime = t;
+
     BBCDEBUG3(("Cursor<%s:%u>: Created new blockformat %u at %0.3lfs for object '%s', channelformat '%s'", StringFrom(this).c_str(), channel, blockindex, (double)t * 1.0e-9, objectdata.audioobject->ToString().c_str(), objectdata.channelformat->ToString().c_str()));
   }
 
@@ -2492,6 +3845,7 @@ void ADMTrackCursor::EndBlockFormat(uint64_t t)
     ADMAudioBlockFormat *blockformat = objectdata.channelformat->GetBlockFormatRefs()[blockindex];
   
     blockformat->SetEndTime(t, objectdata.audioobject);
+    objectdata.channelformat->UpdateTimeline(blockindex);
 
     BBCDEBUG3(("Cursor<%s:%u>: Completed blockformat %u at %0.3lfs (duration %0.3lfs) for object '%s', channelformat '%s'", StringFrom(this).c_str(), channel, blockindex, (double)t * 1.0e-9, (double)blockformat->GetDuration() * 1.0e-9, objectdata.audioobject->ToString().c_str(), objectdata.channelformat->ToString().c_str()));
 
@@ -2523,9 +3877,11 @@ void ADMTrackCursor::SetObjectParameters(const AudioObjectParameters& newparamet
     {
       // new position at same time as original -> just update the parameters
       blockformats[blockindex]->GetObjectParameters() = objparameters;
+      if (capturepolicyset && capturepolicy.interpolate) blockformats[blockindex]->GetObjectParameters().SetJumpPosition(true);
+      objectdata.channelformat->UpdateTimeline(blockindex);
       BBCDEBUG2(("Updating channel %u to {'%s'}", channel, blockformats[blockindex]->GetObjectParameters().ToString().c_str()));
     }
-    else
+    else if (!capturepolicyset || !CaptureObjectParameters(objectdata))
     {
       // new position requires new block format
       EndBlockFormat(currenttime);
@@ -2533,6 +3889,9 @@ void ADMTrackCursor::SetObjectParameters(const AudioObjectParameters& newparamet
       if ((blockformat = StartBlockFormat(currenttime)) != NULL)
       {
         blockformat->GetObjectParameters() = objparameters;
+        // a step change cannot be interpolated so jump to the new parameters
+        if (capturepolicyset && capturepolicy.interpolate) blockformat->GetObjectParameters().SetJumpPosition(true);
+        objectdata.channelformat->UpdateTimeline(blockindex);
         BBCDEBUG2(("Updating channel %u to {'%s'}", channel, blockformats[blockindex]->GetObjectParameters().ToString().c_str()));
       }
     }
@@ -2555,16 +3914,193 @@ void ADMTrackCursor::EndChanges()
 
   if ((objectindex < objectlist.size()) &&
       (currenttime >= objectlist[objectindex].audioobject->GetStartTime()) &&
-      (objectlist[objectindex].channelformat->GetBlockFormatRefs().size() == 0))
+      (GetBlockFormatRefs(objectlist[objectindex]).size() == 0))
   {
     // no blockformats for the current object, create one from start of object
     StartBlockFormat(objectlist[objectindex].audioobject->GetStartTime());
   }
+  else if (capturepolicyset && capturepolicy.interpolate && blockformatstarted && (objectindex < objectlist.size()) &&
+           ((blockindex + 1) == GetBlockFormatRefs(objectlist[objectindex]).size()) && (capturetime < currenttime))
+  {
+    AUDIOOBJECT&        objectdata   = objectlist[objectindex];
+    ADMAudioBlockFormat *blockformat = objectdata.channelformat->GetBlockFormatRefs()[blockindex];
+
+    // the current block format reaches its parameters at the last update so end it there
+    // and hold its parameters until the end
+    if ((capturetime > blockformat->GetStartTime(objectdata.audioobject)) && !blockformat->GetObjectParameters().GetJumpPosition())
+    {
+      AudioObjectParameters params = blockformat->GetObjectParameters();
+
+      EndBlockFormat(capturetime);
+      if ((blockformat = StartBlockFormat(capturetime)) != NULL)
+      {
+        blockformat->GetObjectParameters() = params;
+        blockformat->GetObjectParameters().SetJumpPosition(true);
+        objectdata.channelformat->UpdateTimeline(blockindex);
+      }
+    }
+  }
 
   // close last blockformat off by setting end time
   EndBlockFormat(currenttime);
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Set/clear policy limiting the block formats created by SetObjectParameters()
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMTrackCursor::SetCapturePolicy(const CAPTUREPOLICY& policy)
+{
+  ThreadLock lock(tlock);
+
+  capturepolicy    = policy;
+  capturepolicyset = true;
+}
+
+void ADMTrackCursor::ClearCapturePolicy()
+{
+  ThreadLock lock(tlock);
+
+  capturepolicyset = false;
+  captureupdates.clear();
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return policy limiting the block formats created by SetObjectParameters()
+ *
+ * @return true if a policy is set
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMTrackCursor::GetCapturePolicy(CAPTUREPOLICY& policy) const
+{
+  ThreadLock lock(tlock);
+
+  if (capturepolicyset) policy = capturepolicy;
+
+  return capturepolicyset;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Add the channel formats of this cursor's objects to a map, each with the start time
+ * of its object
+ *
+ * @note the times of the block formats of each channel format are relative to the start
+ * @note time of its object
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMTrackCursor::GetChannelFormatOffsets(std::map<const ADMAudioChannelFormat *, uint64_t>& offsets) const
+{
+  ThreadLock lock(tlock);
+  uint_t i;
+
+  for (i = 0; i < objectlist.size(); i++)
+  {
+    offsets[objectlist[i].channelformat] = objectlist[i].audioobject->GetStartTime();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Merge the current parameters into the current block format or start a new one at
+ * the last keyframe according to the capture policy
+ *
+ * @return true if the parameters have been handled, false if a new block format should
+ * be started at the current time
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMTrackCursor::CaptureObjectParameters(AUDIOOBJECT& objectdata)
+{
+  std::vector<ADMAudioBlockFormat *>& blockformats = objectdata.channelformat->GetBlockFormatRefs();
+  bool handled = false;
+
+  // only updates following those of the block format being written can be merged into it
+  if (blockformatstarted && ((blockindex + 1) == blockformats.size()) && (capturetime < currenttime))
+  {
+    ADMAudioBlockFormat         *blockformat    = blockformats[blockindex];
+    const AudioObjectParameters& blockparams    = blockformat->GetObjectParameters();
+    uint64_t                     starttime      = blockformat->GetStartTime(objectdata.audioobject);
+    uint64_t                     duration       = currenttime - starttime;
+    bool                         jump           = (!capturepolicy.interpolate || blockparams.GetJumpPosition());
+    // a new block format starts at the last keyframe if there is one, otherwise now
+    uint64_t                     keytime        = (capturepolicy.interpolate && (capturetime > starttime)) ? capturetime : currenttime;
+    bool                         merge          = ((keytime - starttime) < capturepolicy.minduration);
+
+    if (!merge &&
+        (!capturepolicy.maxduration || (duration <= capturepolicy.maxduration)) &&
+        (!capturepolicy.maxupdates  || (captureupdates.size() < capturepolicy.maxupdates)) &&
+        SameOtherParameters(objparameters, blockparams))
+    {
+      // a block format that jumps holds its parameters, otherwise it ramps from the parameters of
+      // the previous one, either way all updates merged into it must be within tolerance of it
+      // once it is extended to this update (with steps, only the block format's parameters matter)
+      const AudioObjectParameters& startparams = (!jump && blockindex) ? blockformats[blockindex - 1]->GetObjectParameters() : objparameters;
+      uint_t i;
+
+      merge = ADMAudioChannelFormat::WithinTolerance(blockparams, startparams, objparameters, (double)(capturetime - starttime) / (double)duration, capturepolicy.tolerances);
+      for (i = 0; merge && (i < captureupdates.size()); i++)
+      {
+        merge = ADMAudioChannelFormat::WithinTolerance(captureupdates[i].params, startparams, objparameters, (double)(captureupdates[i].t - starttime) / (double)duration, capturepolicy.tolerances);
+      }
+    }
+
+    if (merge)
+    {
+      if (capturepolicy.interpolate)
+      {
+        CAPTUREUPDATE update = {capturetime, blockparams};
+
+        // remember previous update to check it against future ramps and move the end of the ramp to this update
+        captureupdates.push_back(update);
+
+        blockformat->GetObjectParameters() = objparameters;
+        blockformat->GetObjectParameters().SetJumpPosition(jump);
+        objectdata.channelformat->UpdateTimeline(blockindex);
+        capturetime = currenttime;
+      }
+
+      handled = true;
+    }
+    else if (keytime < currenttime)
+    {
+      // end block format at the last update (keyframe) and ramp from it to this update
+      EndBlockFormat(keytime);
+      if ((blockformat = StartBlockFormat(keytime)) != NULL)
+      {
+        blockformat->GetObjectParameters() = objparameters;
+        blockformat->GetObjectParameters().SetJumpPosition(false);
+        objectdata.channelformat->UpdateTimeline(blockindex);
+        capturetime = currenttime;
+      }
+
+      BBCDEBUG2(("Updating channel %u to {'%s'} from %0.3lfs", channel, objparameters.ToString().c_str(), (double)keytime * 1.0e-9));
+
+      handled = true;
+    }
+  }
+
+  return handled;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return true if two sets of parameters are identical other than their position, gain,
+ * width and jump position
+ */
+/*--------------------------------------------------------------------------------*/
+bool ADMTrackCursor::SameOtherParameters(const AudioObjectParameters& params1, const AudioObjectParameters& params2)
+{
+  AudioObjectParameters other1 = params1, other2 = params2;
+
+  other1.ResetPosition();
+  other1.ResetGain();
+  other1.ResetWidth();
+  other1.SetJumpPosition(false);
+  other2.ResetPosition();
+  other2.ResetGain();
+  other2.ResetWidth();
+  other2.SetJumpPosition(false);
+
+  return (other1 == other2);
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Get position at specified time (ns)
  */
@@ -2591,7 +4127,7 @@ bool ADMTrackCursor::Seek(uint64_t t)
       blockindex = 0;
 
       // if the blockformat list is not empty, set the bockindex to the last one
-      const std::vector<ADMAudioBlockFormat *>& blockformats = objectlist[objectindex].channelformat->GetBlockFormatRefs();
+      ADMAudioBlockFormatRefs blockformats = GetBlockFormatRefs(objectlist[objectindex]);
       if (blockformats.size() > 0) blockindex = (uint_t)(blockformats.size() - 1);
     }
     while (((objectindex + 1) < objectlist.size()) && (t >= objectlist[objectindex + 1].audioobject->GetStartTime()))
@@ -2606,13 +4142,29 @@ bool ADMTrackCursor::Seek(uint64_t t)
 
     // move blockindex as needed
     const AUDIOOBJECT&                        objectdata   = objectlist[objectindex];
-    const std::vector<ADMAudioBlockFormat *>& blockformats = objectdata.channelformat->GetBlockFormatRefs();
-    if ((t >= objectdata.audioobject->GetStartTime()) && (blockindex < blockformats.size()))
+    ADMAudioBlockFormatRefs                   blockformats = GetBlockFormatRefs(objectdata);
+    const ADMAudioBlockTimeline&              timeline     = objectdata.channelformat->GetTimeline();
+    uint64_t                                  objstart     = objectdata.audioobject->GetStartTime();
+
+    // block formats may have been removed (see ADMAudioChannelFormat::RemoveBlockFormatsBefore()) so limit blockindex
+    if (blockformats.size() && (blockindex >= blockformats.size())) blockindex = (uint_t)(blockformats.size() - 1);
+
+    if ((t >= objstart) && (blockindex < blockformats.size()))
     {
-      // find right blockformat within object
+      // find right blockformat within object using the timeline (avoids touching each blockformat)
+      uint_t timelineindex = blockindex;
+      if (timeline.size() == blockformats.size()) blockindex = timelineindex = timeline.Find(t - objstart, blockindex);
+
+      // check the block formats either side against the time in case they have been modified without
+      // the timeline being updated, walking through the block formats if they disagree
       while ((blockindex       > 0)                   && (t <  blockformats[blockindex]->GetStartTime(objectdata.audioobject)))     blockindex--;
       while (((blockindex + 1) < blockformats.size()) && (t >= blockformats[blockindex + 1]->GetStartTime(objectdata.audioobject))) blockindex++;
 
+      if ((timeline.size() == blockformats.size()) && (blockindex != timelineindex))
+      {
+        BBCDEBUG2(("Cursor<%s:%u>: Timeline for channel format '%s' is out of date (block %u vs %u)", StringFrom(this).c_str(), channel, objectdata.channelformat->ToString().c_str(), timelineindex, blockindex));
+      }
+
       objparameters = blockformats[blockindex]->GetObjectParameters();
       objparametersvalid = true;
     }
@@ -2620,7 +4172,7 @@ bool ADMTrackCursor::Seek(uint64_t t)
 
     if ((objectindex != oldobjectindex) || (blockindex != oldblockindex))
     {
-      BBCDEBUG4(("Cursor<%s:%u>: Moved to object %u/%u, block %u/%u at %0.3lfs (parameters '%s')", StringFrom(this).c_str(), channel, objectindex, (uint_t)objectlist.size(), blockindex, (uint_t)objectlist[objectindex].channelformat->GetBlockFormatRefs().size(), (double)t * 1.0e-9, objectlist[objectindex].channelformat->GetBlockFormatRefs()[blockindex]->GetObjectParameters().ToString().c_str()));
+      BBCDEBUG4(("Cursor<%s:%u>: Moved to object %u/%u, block %u/%u at %0.3lfs (parameters '%s')", StringFrom(this).c_str(), channel, objectindex, (uint_t)objectlist.size(), blockindex, (uint_t)GetBlockFormatRefs(objectlist[objectindex]).size(), (double)t * 1.0e-9, GetBlockFormatRefs(objectlist[objectindex])[blockindex]->GetObjectParameters().ToString().c_str()));
     }
   }
 
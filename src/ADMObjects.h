@@ -9,6 +9,7 @@
 
 #include <bbcat-base/misc.h>
 #include <bbcat-base/ThreadLock.h>
+#include <bbcat-base/RefCount.h>
 
 #include <bbcat-control/AudioObjectCursor.h>
 #include <bbcat-control/AudioObjectParameters.h>
@@ -35,6 +36,37 @@ class ADMAudioStreamFormat;
 class ADMAudioTrack;
 class ADMAudioTrackFormat;
 
+/*--------------------------------------------------------------------------------*/
+/** Read-only view of a list of AudioBlockFormats
+ *
+ * Returned by ADMAudioChannelFormat::GetBlockFormatRefs() const so that block formats
+ * (which may be shared between copies of a channel format) cannot be modified through it
+ *
+ * @note the view is only valid whilst the list it refers to is unchanged
+ */
+/*--------------------------------------------------------------------------------*/
+class ADMAudioBlockFormatRefs
+{
+public:
+  typedef const ADMAudioBlockFormat * const *const_iterator;
+
+  ADMAudioBlockFormatRefs() : refs(NULL) {}
+  ADMAudioBlockFormatRefs(const std::vector<ADMAudioBlockFormat *>& _refs) : refs(&_refs) {}
+
+  size_t size()  const {return refs ? refs->size() : 0;}
+  bool   empty() const {return !size();}
+
+  const ADMAudioBlockFormat *operator [] (size_t n) const {return (*refs)[n];}
+  const ADMAudioBlockFormat *front() const {return refs->front();}
+  const ADMAudioBlockFormat *back()  const {return refs->back();}
+
+  const_iterator begin() const {return size() ? &(*refs)[0] : NULL;}
+  const_iterator end()   const {return begin() + size();}
+
+protected:
+  const std::vector<ADMAudioBlockFormat *> *refs;
+};
+
 /*--------------------------------------------------------------------------------*/
 /** ADM base object
  */
@@ -193,6 +225,44 @@ public:
     UNUSED_PARAMETER(object);
     return false;
   }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return length of the XML of all contained objects without generating it
+   *
+   * @param indent indent string used within XML
+   * @param eol end of line string used within XML
+   * @param level indentation level of the contained objects
+   * @param length updated with length of XML
+   *
+   * @return false if the length is not accounted for (the XML must be generated to find it)
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool GetContainedObjectsXMLLength(const std::string& indent, const std::string& eol, uint_t level, uint64_t& length) const
+  {
+    UNUSED_PARAMETER(indent);
+    UNUSED_PARAMETER(eol);
+    UNUSED_PARAMETER(level);
+    UNUSED_PARAMETER(length);
+    return false;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return cached XML of all contained objects
+   *
+   * @param indent indent string used within XML
+   * @param eol end of line string used within XML
+   * @param level indentation level of the contained objects
+   *
+   * @return cached XML or NULL if XML is not cached (the XML must be generated)
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual const std::string *GetContainedObjectsXML(const std::string& indent, const std::string& eol, uint_t level) const
+  {
+    UNUSED_PARAMETER(indent);
+    UNUSED_PARAMETER(eol);
+    UNUSED_PARAMETER(level);
+    return NULL;
+  }
     
   /*--------------------------------------------------------------------------------*/
   /** Return human friendly summary of the object in the form:
@@ -269,6 +339,17 @@ protected:
    */
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj) {UNUSED_PARAMETER(obj);}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   *
+   * @param objects map of objects that have been replaced or removed (bool is a dummy)
+   *
+   * @note each reference to one of the objects is looked up again by ID, references to
+   * @note objects that no longer exist are dropped (the objects MUST still be valid)
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects) {UNUSED_PARAMETER(objects);}
                               
   /*--------------------------------------------------------------------------------*/
   /** Generate a textual reference 
@@ -342,6 +423,13 @@ protected:
   template<typename T>
   void CopyReferencesEx(std::vector<T *>& dst, const std::vector<T *>& src);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link a list of references to the objects currently in the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  template<typename T>
+  void RelinkReferencesEx(std::vector<T *>& refs, const std::map<const ADMObject *,bool>& objects);
+
 protected:
   ADMData&     owner;
   std::string  id;
@@ -455,6 +543,12 @@ public:
    */
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
   
   // static type name
   static const std::string Type;
@@ -571,6 +665,12 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
+
   // static type name
   static const std::string Type;
 
@@ -779,10 +879,10 @@ public:
   ADMAudioChannelFormat *GetChannelFormat(uint_t track) const;
 
   /*--------------------------------------------------------------------------------*/
-  /** Get list of audioBlockFormats for a particular track
+  /** Get list of audioBlockFormats for a particular track (empty if the track has no audioChannelFormat)
    */
   /*--------------------------------------------------------------------------------*/
-  const std::vector<ADMAudioBlockFormat *> *GetBlockFormatList(uint_t track) const;
+  ADMAudioBlockFormatRefs GetBlockFormatList(uint_t track) const;
   
   static bool Compare(const ADMAudioObject *obj1, const ADMAudioObject *obj2)
   {
@@ -814,6 +914,12 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
+
   // static type name
   static const std::string Type;
 
@@ -965,6 +1071,12 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
+
   // static type name
   static const std::string Type;
 
@@ -1094,6 +1206,12 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
+
   // static type name
   static const std::string Type;
 
@@ -1259,6 +1377,12 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
+
   // static type name
   static const std::string Type;
 
@@ -1305,6 +1429,233 @@ protected:
   std::vector<ADMAudioPackFormat *>    packformatrefs;
 };
 
+/*----------------------------------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------------*/
+/** Columnar (structure-of-arrays) copy of the timing and commonly used parameters of
+ * a list of audioBlockFormats
+ *
+ * Cursors and renderers generally only need the timing and position of each block
+ * so these are held in contiguous arrays which can be scanned without touching the
+ * (much larger) ADMAudioBlockFormat objects
+ *
+ * Rarely set parameters are held in sparse columns of (index, value) pairs
+ *
+ * NOTE: this is a cache of the block formats held by an ADMAudioChannelFormat, it is
+ * maintained by that object (see ADMAudioChannelFormat::UpdateTimeline())
+ */
+/*--------------------------------------------------------------------------------*/
+class ADMAudioBlockTimeline
+{
+public:
+  ADMAudioBlockTimeline() : minstart(0),
+                            maxend(0),
+                            extentsvalid(false) {}
+  ~ADMAudioBlockTimeline() {}
+
+  enum {
+    Flag_Position = 0x01,           // position is set
+    Flag_Polar    = 0x02,           // position is polar (else cartesian)
+    Flag_Gain     = 0x04,           // gain is set
+    Flag_Width    = 0x08,           // width is set
+  };
+
+  enum {
+    Sparse_Height = 0,
+    Sparse_Depth,
+    Sparse_Diffuseness,
+    Sparse_DivergenceBalance,
+    Sparse_DivergenceAzimuth,
+
+    Sparse_Count,
+  };
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return number of blocks in timeline
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t size() const {return (uint_t)rtimes.size();}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Clear timeline
+   *
+   * @param release true to release the memory used by the columns
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Clear(bool release = false);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Reserve space for n blocks
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Reserve(uint_t n);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Insert block at index n (blocks at n and beyond move up by one)
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Insert(uint_t n, const ADMAudioBlockFormat *block);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Update entry n from block
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Update(uint_t n, const ADMAudioBlockFormat *block);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Rebuild entire timeline from list of blocks
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Rebuild(const std::vector<ADMAudioBlockFormat *>& blocks);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Find block that covers time t (relative to start of object)
+   *
+   * @param t time relative to the start of the audio object
+   * @param hint index to start search from (usually the index returned by the previous call)
+   *
+   * @return index of last block whose rtime is <= t (or 0 if t is before the first block)
+   *
+   * @note the area around hint is checked first before resorting to a binary search
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t Find(uint64_t t, uint_t hint = 0) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Column access
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint64_t GetRTime(uint_t n)    const {return rtimes[n];}
+  uint64_t GetDuration(uint_t n) const {return durations[n];}
+  uint64_t GetEndTime(uint_t n)  const {return durations[n] ? limited::addm(rtimes[n], durations[n]) : ADMObject::MaxTime;}
+  uint8_t  GetFlags(uint_t n)    const {return flags[n];}
+  const std::vector<uint64_t>& GetRTimes() const {return rtimes;}
+  const std::vector<uint64_t>& GetDurations() const {return durations;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return position of block n
+   *
+   * @return true if block has a position set
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GetPosition(uint_t n, Position& pos) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return gain and width of block n
+   *
+   * @return true if value set for block
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GetGain(uint_t n, double& val) const {if (flags[n] & Flag_Gain)  {val = gains[n];  return true;} return false;}
+  bool GetWidth(uint_t n, float& val) const {if (flags[n] & Flag_Width) {val = widths[n]; return true;} return false;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return value of sparse column for block n
+   *
+   * @param column Sparse_xxx column index
+   * @param n block index
+   * @param val value to be updated
+   *
+   * @return true if value set for block
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GetSparseValue(uint_t column, uint_t n, float& val) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return earliest start and latest end of all blocks (relative to start of object)
+   *
+   * @param start earliest block rtime
+   * @param end latest block end time (ADMObject::MaxTime if any block has no duration)
+   *
+   * @return false if there are no blocks
+   *
+   * @note extents are maintained as blocks are inserted and only recalculated when
+   * @note a block that defined them is modified
+   * @note the recalculation updates the timeline so callers sharing a timeline between threads
+   * @note must serialise calls (see ADMAudioChannelFormat::GetBlockExtents())
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GetExtents(uint64_t& start, uint64_t& end) const;
+
+protected:
+  /*--------------------------------------------------------------------------------*/
+  /** Set columns of entry n from block
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetEntry(uint_t n, const ADMAudioBlockFormat *block);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Extend (valid) extents to include entry n
+   */
+  /*--------------------------------------------------------------------------------*/
+  void ExtendExtents(uint_t n);
+
+  typedef struct {
+    uint_t index;
+    float  value;
+  } SPARSEVALUE;
+  typedef std::vector<SPARSEVALUE> SPARSECOLUMN;
+
+  static bool CompareSparseIndex(const SPARSEVALUE& val, uint_t index) {return (val.index < index);}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set or clear value in sparse column
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetSparseValue(SPARSECOLUMN& column, uint_t n, bool set, float val);
+
+protected:
+  std::vector<uint64_t> rtimes;
+  std::vector<uint64_t> durations;
+  std::vector<uint8_t>  flags;
+  std::vector<double>   positions[3];     // az/el/d or x/y/z depending on Flag_Polar
+  std::vector<double>   gains;
+  std::vector<float>    widths;
+  SPARSECOLUMN          sparse[Sparse_Count];
+  mutable uint64_t      minstart;
+  mutable uint64_t      maxend;
+  mutable bool          extentsvalid;
+};
+
+/*--------------------------------------------------------------------------------*/
+/** Store for block formats moved out of memory (see ADMAudioChannelFormat::StoreBlockFormats())
+ *
+ * Each call to Write() stores a run of block formats which is read back by its position
+ */
+/*--------------------------------------------------------------------------------*/
+class ADMBlockFormatStore
+{
+public:
+  ADMBlockFormatStore() {}
+  virtual ~ADMBlockFormatStore() {}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Write block formats to store
+   *
+   * @param blocks list of block formats (which are not modified)
+   * @param pos updated with position of the run of block formats in the store
+   * @param len updated with length of the run of block formats in the store
+   *
+   * @return true if successful
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool Write(const std::vector<ADMAudioBlockFormat *>& blocks, uint64_t& pos, uint64_t& len) = 0;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read run of block formats from store
+   *
+   * @param pos position of run of block formats (as returned by Write())
+   * @param len length of run of block formats (as returned by Write())
+   * @param blocks list to be populated with new block formats
+   *
+   * @return true if successful
+   *
+   * @note on failure, blocks is left unchanged (no partial runs are returned)
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool Read(uint64_t pos, uint64_t len, std::vector<ADMAudioBlockFormat *>& blocks) = 0;
+};
+
 /*--------------------------------------------------------------------------------*/
 /** NOTE: an audioChannelFormat may be used by more than one audioObject!
  */
@@ -1322,8 +1673,20 @@ public:
    * @note type passed to base constructor is fixed by static member variable Type 
    */
   /*--------------------------------------------------------------------------------*/
-  ADMAudioChannelFormat(ADMData& _owner, const std::string& _id, const std::string& _name) : ADMObject(_owner, _id, _name) {Register();}
-  ADMAudioChannelFormat(ADMData& _owner, const ADMAudioChannelFormat *obj);
+  ADMAudioChannelFormat(ADMData& _owner, const std::string& _id, const std::string& _name);
+  /*--------------------------------------------------------------------------------*/
+  /** Copy constructor
+   *
+   * @param _owner an instance of ADMData that this object should belong to
+   * @param obj object to copy
+   * @param share true to share the block formats of obj until either object modifies them
+   *
+   * @note when sharing, pointers to block formats obtained from obj *before* the copy
+   * @note will still reference the shared blocks - only access via GetBlockFormatRefs(),
+   * @note Add() etc. causes the blocks to be cloned
+   */
+  /*--------------------------------------------------------------------------------*/
+  ADMAudioChannelFormat(ADMData& _owner, const ADMAudioChannelFormat *obj, bool share = false);
   virtual ~ADMAudioChannelFormat();
 
   typedef std::vector<ADMAudioChannelFormat *> LIST;
@@ -1358,15 +1721,126 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual bool Add(ADMAudioBlockFormat *obj);
   /*--------------------------------------------------------------------------------*/
-  /** Return list of AudioBlockFormats
+  /** Decoder for block formats whose parsing has been deferred (see SetPendingBlockFormats())
+   *
+   * @param channel channel format the block formats belong to
+   * @param start ptr to XML containing the audioBlockFormat elements
+   * @param end ptr to end of XML containing the audioBlockFormat elements
+   * @param blocks list to be populated with decoded block formats
+   *
+   * @return true if block formats decoded successfully
+   *
+   * @note any elements other than audioBlockFormat in the range MUST be ignored
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef bool (*BLOCKFORMATDECODER)(const ADMAudioChannelFormat& channel, const char *start, const char *end, std::vector<ADMAudioBlockFormat *>& blocks);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Defer decoding of block formats until they are first accessed
+   *
+   * @param xml buffer holding XML (usually shared between all channel formats of an ADM)
+   * @param start offset of first audioBlockFormat element in xml
+   * @param end offset of end of last audioBlockFormat element in xml
+   * @param decoder function used to decode the audioBlockFormat elements
+   * @param extentsknown true if minstart and maxend are valid
+   * @param minstart earliest block rtime (as ADMAudioBlockTimeline::GetExtents())
+   * @param maxend latest block end time (as ADMAudioBlockTimeline::GetExtents())
+   *
+   * @note block formats are decoded by any access to them or the timeline
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetPendingBlockFormats(const RefCount<std::string>& xml, size_t start, size_t end, BLOCKFORMATDECODER decoder, bool extentsknown = false, uint64_t minstart = 0, uint64_t maxend = 0);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Move block formats out of memory into a store, they are read back when next accessed
+   *
+   * @param store store to write the block formats to
+   *
+   * @return true if the block formats were moved to the store
+   *
+   * @note block formats that are shared or pending are not stored
+   * @note block formats read back from the same store and not modified since are not written
+   * @note again, the run they were read from is reused
+   * @note the extents of the block formats are retained (see GetBlockExtents())
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool StoreBlockFormats(const RefCount<ADMBlockFormatStore>& store);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return sequence number of when the block formats were last read back from a store
+   * (0 if they never have been), block formats read back later have higher numbers
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint64_t GetBlockFormatsLoadSequence() const {return blockdata->loadsequence;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return approximate memory used by each block format held in memory (including
+   * its entry in the timeline)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static uint_t GetBlockFormatMemory();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return whether block formats are still to be decoded
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool BlockFormatsPending() const {return (blockdata->pending != NULL);}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Decode any pending block formats
+   */
+  /*--------------------------------------------------------------------------------*/
+  void LoadBlockFormats() const {if (blockdata->pending) DecodePendingBlockFormats();}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return earliest start and latest end of all blocks (relative to start of object)
+   *
+   * @note if block formats are pending and their extents are known, they are NOT decoded
+   *
+   * @return false if there are no blocks
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GetBlockExtents(uint64_t& start, uint64_t& end) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return read-only list of AudioBlockFormats
+   */
+  /*--------------------------------------------------------------------------------*/
+  ADMAudioBlockFormatRefs GetBlockFormatRefs() const {LoadBlockFormats(); return ADMAudioBlockFormatRefs(blockdata->blockformatrefs);}
+  /*--------------------------------------------------------------------------------*/
+  /** Return modifiable list of AudioBlockFormats
+   *
+   * @note if the block formats are shared with another channel format they are cloned first
+   */
+  /*--------------------------------------------------------------------------------*/
+  std::vector<ADMAudioBlockFormat *>& GetBlockFormatRefs() {Unshare(); return blockdata->blockformatrefs;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return whether block formats are currently shared with another channel format
    */
   /*--------------------------------------------------------------------------------*/
-  const std::vector<ADMAudioBlockFormat *>& GetBlockFormatRefs() const {return blockformatrefs;}
+  bool BlockFormatsShared() const {return (blockdata->refcount > 1);}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return columnar timeline of AudioBlockFormats
+   */
+  /*--------------------------------------------------------------------------------*/
+  const ADMAudioBlockTimeline& GetTimeline() const {LoadBlockFormats(); return blockdata->timeline;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Update timeline entry (and XML length and cached XML) for block n after it has been modified
+   *
+   * @note blocks modified directly (via GetBlockFormatRefs()) are NOT reflected in the
+   * @note timeline until this (or SortBlockFormats()) is called
+   */
+  /*--------------------------------------------------------------------------------*/
+  void UpdateTimeline(uint_t n) {Unshare(); if (n < blockdata->blockformatrefs.size()) {blockdata->timeline.Update(n, blockdata->blockformatrefs[n]); BlockFormatChanged(n, false);}}
+
   /*--------------------------------------------------------------------------------*/
-  /** Return list of AudioBlockFormats
+  /** Rebuild entire timeline from block formats (XML lengths and XML are generated again when next requested)
    */
   /*--------------------------------------------------------------------------------*/
-  std::vector<ADMAudioBlockFormat *>& GetBlockFormatRefs() {return blockformatrefs;}
+  void UpdateTimeline() {Unshare(); blockdata->timeline.Rebuild(blockdata->blockformatrefs); ResetXMLLengths(); InvalidateXMLCache(0);}
 
   /*--------------------------------------------------------------------------------*/
   /** Return list of values/attributes from internal variables and list of referenced objects
@@ -1388,11 +1862,84 @@ public:
   virtual void GenerateReferenceList(std::string& str) const;
 
   /*--------------------------------------------------------------------------------*/
-  /** Sort block formats in time order
+  /** Sort block formats in time order (and rebuild timeline)
    */
   /*--------------------------------------------------------------------------------*/
   virtual void SortBlockFormats();
-  
+
+  /*--------------------------------------------------------------------------------*/
+  /** Tolerances for simplifying block formats (see SimplifyBlockFormats())
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    double angle;             // maximum error in azimuth and elevation of polar positions (degrees)
+    double distance;          // maximum error in distance of polar positions and in each coordinate of cartesian positions
+    double gain;              // maximum error in (linear) gain
+    double width;             // maximum error in width
+  } SIMPLIFYTOLERANCES;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Remove redundant block formats
+   *
+   * @param tolerances maximum errors allowed in positions, gains and widths
+   *
+   * @return number of block formats removed
+   *
+   * A run of contiguous block formats is replaced by the last block format of the run
+   * (its rtime and duration extended to cover the run) if the position, gain and width
+   * of each block format in the run is within tolerance of the linear interpolation
+   * between the preceding block format and the end of the run (or, for block formats
+   * that jump to their position, of the end of the run) and all other values are identical
+   *
+   * @note MUST NOT be called whilst a cursor is writing block formats to this channel format
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t SimplifyBlockFormats(const SIMPLIFYTOLERANCES& tolerances);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if position, gain and width are within tolerance of those interpolated
+   * between two other sets of parameters
+   *
+   * @param params parameters to test
+   * @param startparams parameters at the start of the interpolation
+   * @param endparams parameters at the end of the interpolation
+   * @param f fraction of the way between start and end
+   * @param tolerances maximum errors
+   *
+   * @note parameters that jump to their position are compared with endparams
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool WithinTolerance(const AudioObjectParameters& params, const AudioObjectParameters& startparams, const AudioObjectParameters& endparams, double f, const SIMPLIFYTOLERANCES& tolerances);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Merge copies of the block formats of another channel format (e.g. from a Serial ADM
+   * frame) into this one
+   *
+   * @param channelformat channel format to take block formats from
+   *
+   * @return number of block formats added or replaced
+   *
+   * Block formats starting before the last block format of this channel format are assumed
+   * to be held already and are ignored, a block format starting at the same time as the
+   * last replaces it (e.g. to set the duration of a block format that was still open) and
+   * later block formats are appended
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t MergeBlockFormats(const ADMAudioChannelFormat& channelformat);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Remove block formats that have been superseded at or before t
+   *
+   * @param t time (ns, relative to the start of the object) before which block formats are no longer required
+   *
+   * @return number of block formats removed
+   *
+   * @note the block format active at t (or the last block format) is always retained
+   * @note cursors reading this channel format re-find their block format on the next Seek()
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t RemoveBlockFormatsBefore(uint64_t t);
+
   /*--------------------------------------------------------------------------------*/
   /** Provide a way of accessing contained items without knowing what they are
    * (used for block formats)
@@ -1403,9 +1950,63 @@ public:
    * @return true if object valid
    */
   /*--------------------------------------------------------------------------------*/
-  virtual uint_t GetContainedObjectCount() const {return (uint_t)blockformatrefs.size();}
+  virtual uint_t GetContainedObjectCount() const {LoadBlockFormats(); return (uint_t)blockdata->blockformatrefs.size();}
   virtual bool   GetContainedObject(uint_t n, CONTAINEDOBJECT& object) const;
 
+  /*--------------------------------------------------------------------------------*/
+  /** Return length of the XML of all block formats without generating it
+   *
+   * @param indent indent string used within XML
+   * @param eol end of line string used within XML
+   * @param level indentation level of the block formats
+   * @param length updated with length of XML
+   *
+   * @return false if the length is not accounted for (the XML must be generated to find it)
+   *
+   * @note the first call measures each block format, after that the lengths are maintained
+   * @note as block formats are added or updated (through Add() and UpdateTimeline()) so that
+   * @note subsequent calls with the same indent and eol only measure modified block formats
+   * @note block formats modified directly (via GetBlockFormatRefs()) MUST be followed by
+   * @note UpdateTimeline() for their lengths to be updated
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool GetContainedObjectsXMLLength(const std::string& indent, const std::string& eol, uint_t level, uint64_t& length) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return XML of all block formats from cache, generating only those not cached
+   *
+   * @param indent indent string used within XML
+   * @param eol end of line string used within XML
+   * @param level indentation level of the block formats
+   *
+   * @return cached XML or NULL if XML caching is disabled (see SetXMLCaching())
+   *
+   * @note cached XML is discarded from the first block format added or updated (through
+   * @note Add() and UpdateTimeline()) onwards so appending block formats (e.g. whilst
+   * @note recording) only generates the new block formats
+   * @note block formats modified directly (via GetBlockFormatRefs()) MUST be followed by
+   * @note UpdateTimeline() for the cached XML to be updated
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual const std::string *GetContainedObjectsXML(const std::string& indent, const std::string& eol, uint_t level) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Enable/disable caching of block format XML by all channel formats
+   *
+   * @note caching speeds up repeated generation of XML for an ADM that changes little
+   * @note between generations at the cost of holding the block format XML in memory
+   * @note generating XML for the same ADM on more than one thread at once is NOT
+   * @note supported whilst caching is enabled
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetXMLCaching(bool enable);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return whether block format XML caching is enabled
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool GetXMLCaching() {return xmlcaching;}
+
   // static type name
   static const std::string Type;
 
@@ -1422,8 +2023,141 @@ protected:
   /*--------------------------------------------------------------------------------*/
   virtual void UpdateID();
 
+  /*--------------------------------------------------------------------------------*/
+  /** Undecoded block formats (see SetPendingBlockFormats())
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    RefCount<std::string>         xml;
+    size_t                        start, end;   // offsets within xml (which may be larger than 4GB)
+    BLOCKFORMATDECODER            decoder;
+    RefCount<ADMBlockFormatStore> store;        // if valid, block formats are read from store instead of xml
+    uint64_t                      storepos, storelen;
+    bool                          extentsknown;
+    uint64_t                      minstart, maxend;
+  } PENDINGBLOCKS;
+
+  /*--------------------------------------------------------------------------------*/
+  /** XML lengths of block formats (see GetContainedObjectsXMLLength())
+   *
+   * @note held per channel format (rather than in the shared block data) so that channel
+   * @note formats sharing block formats can measure them at the same time and with different formatting
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    std::string           indent, eol;          // formatting the lengths are for
+    uint_t                generation;           // generation of the block data the lengths are for
+    std::vector<uint32_t> lengths;              // XML length of each block format at level 0 excluding its ID (0 = not known)
+    std::vector<uint32_t> indents;              // number of indents within the XML of each block format
+    uint64_t              length, indentcount;  // totals of known lengths and indents
+    uint_t                unknown;              // number of lengths not known
+    uint_t                modified;             // block format last modified (measured when another is modified)
+    bool                  enabled;              // true once lengths have been requested
+  } XMLLENGTHS;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Block formats and their timeline, shared between copies of a channel format
+   * until one of them modifies them
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    std::vector<ADMAudioBlockFormat *> blockformatrefs;
+    ADMAudioBlockTimeline              timeline;
+    uint_t                             refcount;
+    PENDINGBLOCKS                      *pending;        // non-NULL if block formats still to be decoded
+    uint_t                             generation;     // incremented when XML lengths of the block formats become invalid (protected by blockdatalock)
+    RefCount<ADMBlockFormatStore>      store;          // if valid, store holds an unmodified copy of the block formats
+    uint64_t                           storepos, storelen;
+    uint64_t                           loadsequence;   // sequence number of when block formats were last read from a store
+  } BLOCKDATA;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Decode pending block formats
+   */
+  /*--------------------------------------------------------------------------------*/
+  void DecodePendingBlockFormats() const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Clone block formats if they are shared with another channel format
+   */
+  /*--------------------------------------------------------------------------------*/
+  void Unshare();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Initialise block data
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void InitBlockData(BLOCKDATA& data);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Forget all block format XML lengths (they are measured again when next requested)
+   */
+  /*--------------------------------------------------------------------------------*/
+  void ResetXMLLengths() const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Measure XML length of block format n if it is not known
+   */
+  /*--------------------------------------------------------------------------------*/
+  void MeasureXMLLength(uint_t n) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Update XML lengths and cached XML after block format n has been inserted or modified
+   *
+   * @param n block format index
+   * @param inserted true if block format has been inserted, false if it has been modified
+   *
+   * @note the previously modified block format (which is assumed to be complete) is measured
+   */
+  /*--------------------------------------------------------------------------------*/
+  void BlockFormatChanged(uint_t n, bool inserted);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Discard cached XML of block formats n onwards
+   */
+  /*--------------------------------------------------------------------------------*/
+  void InvalidateXMLCache(uint_t n) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if block formats are already in time order
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool BlockFormatsSorted(const std::vector<ADMAudioBlockFormat *>& blocks);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return values of block format other than its position, gain and width
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void GetOtherBlockFormatValues(const ADMAudioBlockFormat *block, XMLValues& values);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Release reference to block data, deleting it (and its block formats) if no longer used
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void Release(BLOCKDATA *data);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Cached XML of block formats (see GetContainedObjectsXML())
+   *
+   * @note held per channel format (rather than in the shared block data) since the XML
+   * @note includes the channel format's ID
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    std::string           id, indent, eol;      // channel format ID and formatting the XML is for
+    uint_t                level;                // indentation level the XML is for
+    std::string           xml;                  // XML of the first offsets.size() block formats
+    std::vector<uint64_t> offsets;              // offset of each block format's XML within xml
+  } XMLCACHE;
+
 protected:
-  std::vector<ADMAudioBlockFormat *> blockformatrefs;
+  BLOCKDATA          *blockdata;
+  mutable XMLLENGTHS xmllengths;
+  mutable XMLCACHE   xmlcache;
+
+  static ThreadLockObject blockdatalock;
+  static uint64_t         loadsequence;     // protected by blockdatalock
+  static bool             xmlcaching;
 };
 
 /*----------------------------------------------------------------------------------------------------*/
@@ -1528,6 +2262,12 @@ public:
   /*--------------------------------------------------------------------------------*/
   virtual void CopyReferences(const ADMObject *obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Re-link references after objects have been replaced or removed within the owner
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void RelinkReferences(const std::map<const ADMObject *,bool>& objects);
+
   // static type name
   static const std::string Type;
 
@@ -1849,6 +2589,78 @@ public:
   virtual void Sort();
 
 protected:
+  typedef struct {
+    const ADMAudioObject  *audioobject;         ///< ADMAudioObject object
+    ADMAudioChannelFormat *channelformat;       ///< ADMAudioChannelFormat object holding block formats
+  } AUDIOOBJECT;
+
+public:
+  /*--------------------------------------------------------------------------------*/
+  /** Policy limiting the block formats created by SetObjectParameters()
+   *
+   * Without a policy, every call to SetObjectParameters() at a new time starts a new
+   * block format.  With a policy, updates are merged into the current block format whilst
+   * the captured trajectory stays within tolerance of the updates:
+   *
+   * interpolate = false: block formats hold the parameters they started with, updates
+   * within tolerance of those parameters are dropped
+   *
+   * interpolate = true: block formats end at keyframes, ramping from the parameters of the
+   * previous block format to those of the last update merged into them (ADM interpolation);
+   * a block format that follows a step change jumps to and holds its parameters
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    uint64_t minduration;                                 ///< minimum duration of block formats (ns), updates are merged until it is reached
+    uint64_t maxduration;                                 ///< maximum duration of block formats whilst updates are received (ns, 0 for no limit)
+    uint_t   maxupdates;                                  ///< maximum number of updates merged into one block format (0 for no limit)
+    ADMAudioChannelFormat::SIMPLIFYTOLERANCES tolerances; ///< maximum errors between captured trajectory and updates
+    bool     interpolate;                                 ///< true for keyframes with interpolation, false for step changes
+  } CAPTUREPOLICY;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set/clear policy limiting the block formats created by SetObjectParameters()
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetCapturePolicy(const CAPTUREPOLICY& policy);
+  void ClearCapturePolicy();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return policy limiting the block formats created by SetObjectParameters()
+   *
+   * @return true if a policy is set
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GetCapturePolicy(CAPTUREPOLICY& policy) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Add the channel formats of this cursor's objects to a map, each with the start time
+   * of its object
+   *
+   * @note the times of the block formats of each channel format are relative to the start
+   * @note time of its object
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GetChannelFormatOffsets(std::map<const ADMAudioChannelFormat *, uint64_t>& offsets) const;
+
+protected:
+  /*--------------------------------------------------------------------------------*/
+  /** Merge the current parameters into the current block format or start a new one at
+   * the last keyframe according to the capture policy
+   *
+   * @return true if the parameters have been handled, false if a new block format should
+   * be started at the current time
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool CaptureObjectParameters(AUDIOOBJECT& objectdata);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if two sets of parameters are identical other than their position, gain,
+   * width and jump position
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool SameOtherParameters(const AudioObjectParameters& params1, const AudioObjectParameters& params2);
+
   /*--------------------------------------------------------------------------------*/
   /** Start a blockformat at t
    */
@@ -1862,16 +2674,25 @@ protected:
   virtual void EndBlockFormat(uint64_t t);
 
 protected:
-  typedef struct {
-    const ADMAudioObject  *audioobject;         ///< ADMAudioObject object
-    ADMAudioChannelFormat *channelformat;       ///< ADMAudioChannelFormat object holding block formats
-  } AUDIOOBJECT;
 
   static bool Compare(const AUDIOOBJECT& obj1, const AUDIOOBJECT& obj2)
   {
     return (obj1.audioobject->GetStartTime() < obj2.audioobject->GetStartTime());
   }
 
+  /*--------------------------------------------------------------------------------*/
+  /** Return read-only list of block formats for object
+   *
+   * @note using this for read-only access avoids cloning block formats shared between copies of an ADM
+   */
+  /*--------------------------------------------------------------------------------*/
+  static ADMAudioBlockFormatRefs GetBlockFormatRefs(const AUDIOOBJECT& obj) {return static_cast<const ADMAudioChannelFormat *>(obj.channelformat)->GetBlockFormatRefs();}
+
+  typedef struct {
+    uint64_t              t;                    ///< time of update (ns)
+    AudioObjectParameters params;               ///< parameters of block format after update
+  } CAPTUREUPDATE;
+
 protected:
   ThreadLockObject         tlock;
   uint_t                   channel;
@@ -1882,6 +2703,10 @@ protected:
   uint64_t                 currenttime;
   bool                     blockformatstarted;
   bool                     objparametersvalid;
+  CAPTUREPOLICY            capturepolicy;
+  bool                     capturepolicyset;
+  std::vector<CAPTUREUPDATE> captureupdates;    ///< updates merged into current block format (interpolate only)
+  uint64_t                 capturetime;         ///< time of last update merged into current block format
 };
 
 BBC_AUDIOTOOLBOX_END
@@ -1,5 +1,6 @@
 
 #include <math.h>
+#include <string.h>
 
 #include <string>
 
@@ -11,9 +12,20 @@
 
 BBC_AUDIOTOOLBOX_START
 
+bool ADMRIFFFile::defaultbinaryadm    = false;
+bool ADMRIFFFile::defaultcompressaxml = false;
+
 ADMRIFFFile::ADMRIFFFile() : RIFFFile(),
-                             adm(NULL)
+                             adm(NULL),
+                             binaryadm(defaultbinaryadm),
+                             compressaxml(defaultcompressaxml),
+                             compressionlevel(6),
+                             simplifyblocks(false),
+                             capturepolicyset(false),
+                             framegenerator(NULL)
 {
+  memset(&simplifytolerances, 0, sizeof(simplifytolerances));
+  memset(&capturepolicy, 0, sizeof(capturepolicy));
 }
 
 ADMRIFFFile::~ADMRIFFFile()
@@ -103,7 +115,13 @@ bool ADMRIFFFile::CreateExtraChunks()
     }
     else BBCERROR("No chna data available");
 
-    success &= (AddChunk(axml_ID) != NULL);
+    success &= (AddChunk(compressaxml ? bxml_ID : axml_ID) != NULL);
+
+    if (binaryadm) success &= (AddChunk(badm_ID) != NULL);
+
+    // start maintaining block format XML lengths of existing channel formats so that
+    // the axml chunk can be sized on close by measuring only the last block formats
+    if (!compressaxml && !binaryadm) adm->GetAxmlLength();
   }
 
   return success;
@@ -180,10 +198,12 @@ void ADMRIFFFile::Close(bool abortwrite)
 
   if (file && adm && writing && !abortwrite)
   {
-    RIFFChunk *chunk;
-    uint64_t  endtime = filesamples ? filesamples->GetAbsolutePositionNS() : 0;
-    uint64_t  chnalen;
-    uint8_t   *chna;
+    RIFFChunk     *chunk;
+    RIFFaxmlChunk *axml = NULL;
+    uint64_t      endtime = filesamples ? filesamples->GetAbsolutePositionNS() : 0;
+    uint64_t      chnalen;
+    uint64_t      sourcehash = 0;
+    uint8_t       *chna;
 
     BBCDEBUG1(("Finalising ADM for '%s'...", file->getfilename().c_str()));
 
@@ -196,12 +216,18 @@ void ADMRIFFFile::Close(bool abortwrite)
       cursors[i]->EndChanges();
     }
 
+    // reduce captured block formats before the ADM is finalised
+    if (simplifyblocks) adm->SimplifyBlockFormats(simplifytolerances);
+
     // finalise ADM
     adm->Finalise();
 
     // update audio object time limits
     adm->UpdateAudioObjectLimits();
 
+    // generate remaining frames now all blockformats are complete and IDs are final
+    if (framegenerator) framegenerator->Finish(endtime);
+
     BBCDEBUG1(("Creating ADM RIFF chunks"));
 
     // get ADM object to create chna chunk
@@ -219,8 +245,60 @@ void ADMRIFFFile::Close(bool abortwrite)
     }
     else BBCERROR("No chna data available");
 
-    // add axml chunk
-    if ((chunk = GetChunk(axml_ID)) != NULL)
+    if (compressaxml)
+    {
+      // add compressed XML as bxml chunk
+      if ((chunk = GetChunk(bxml_ID)) != NULL)
+      {
+        std::vector<uint8_t> data;
+
+        if (adm->GetCompressedAxml(data, compressionlevel))
+        {
+          BBCDEBUG1(("Compressed ADM size is %s bytes", StringFrom((uint64_t)data.size()).c_str()));
+
+          if (chunk->CreateChunkData(sizeof(BXML_CHUNK) + data.size()))
+          {
+            BXML_CHUNK *bxml = (BXML_CHUNK *)chunk->GetDataWritable();
+
+            bxml->Version = BXML_VERSION;
+            memcpy(bxml->Data, &data[0], data.size());
+          }
+          else BBCERROR("Failed to allocate %s bytes for bxml data", StringFrom((uint64_t)data.size()).c_str());
+        }
+        else BBCERROR("Failed to generate compressed axml data");
+      }
+      else BBCERROR("Failed to add bxml chunk");
+    }
+    // add axml chunk, generated directly to the file as it is written
+    else if ((axml = dynamic_cast<RIFFaxmlChunk *>(GetChunk(axml_ID))) != NULL)
+    {
+      if (binaryadm)
+      {
+        // calculate size of ADM and hash for binary form without holding the XML in memory
+        HashSink sink(GetADMSourceHash(GetChunk(chna_ID), NULL));
+
+        if (adm->WriteAxml(sink))
+        {
+          BBCDEBUG1(("ADM size is %s bytes", StringFrom(sink.GetLength()).c_str()));
+
+          axml->SetXMLSource(adm, sink.GetLength());
+          sourcehash = sink.GetHash();
+        }
+        else BBCERROR("Failed to generate axml data");
+      }
+      else
+      {
+        // size of ADM is estimated from the block format lengths maintained whilst recording
+        // so the XML is normally only generated once, as the chunk is written (should the
+        // estimate be wrong, the chunk length is corrected and the chunks re-written on close)
+        uint64_t admlen = adm->GetAxmlLength();
+
+        BBCDEBUG1(("ADM size is %s bytes", StringFrom(admlen).c_str()));
+
+        axml->SetXMLSource(adm, admlen);
+      }
+    }
+    else if ((chunk = GetChunk(axml_ID)) != NULL)
     {
       // first, calculate size of ADM (to save lots of memory allocations)
       uint64_t admlen = adm->GetAxmlBuffer(NULL, 0);
@@ -237,6 +315,23 @@ void ADMRIFFFile::Close(bool abortwrite)
       else BBCERROR("Failed to allocate %s bytes for axml data", StringFrom(admlen).c_str());
     }
     else BBCERROR("Failed to add axml chunk");
+
+    // add binary ADM chunk, tied to the chna and axml (or bxml) chunks just generated
+    if (binaryadm)
+    {
+      if ((chunk = GetChunk(badm_ID)) != NULL)
+      {
+        std::vector<uint8_t> data;
+
+        // streamed axml chunk has no data to hash so use the hash calculated whilst sizing it
+        adm->GetBinary(data, axml ? sourcehash : GetADMSourceHash(GetChunk(chna_ID), GetChunk(compressaxml ? bxml_ID : axml_ID)));
+
+        BBCDEBUG1(("Binary ADM size is %s bytes", StringFrom((uint64_t)data.size()).c_str()));
+
+        if (!chunk->CreateChunkData(&data[0], data.size())) BBCERROR("Failed to allocate %s bytes for badm data", StringFrom((uint64_t)data.size()).c_str());
+      }
+      else BBCERROR("Failed to add badm chunk");
+    }
   }
 
   // write chunks and close file
@@ -280,6 +375,7 @@ void ADMRIFFFile::PrepareCursors()
       // create track cursor for tracking position during writing
       if ((cursor = new ADMTrackCursor(i)) != NULL)
       {
+        if (capturepolicyset) cursor->SetCapturePolicy(capturepolicy);
         cursor->Add(objects);
         cursors.push_back(cursor);
       }
@@ -287,6 +383,33 @@ void ADMRIFFFile::PrepareCursors()
   }
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Set/clear policy limiting the block formats created when positions are set
+ *
+ * @param policy capture policy applied to all track cursors
+ *
+ * @note see ADMTrackCursor::SetCapturePolicy()
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMRIFFFile::SetCapturePolicy(const ADMTrackCursor::CAPTUREPOLICY& policy)
+{
+  uint_t i;
+
+  capturepolicy    = policy;
+  capturepolicyset = true;
+
+  for (i = 0; i < cursors.size(); i++) cursors[i]->SetCapturePolicy(capturepolicy);
+}
+
+void ADMRIFFFile::ClearCapturePolicy()
+{
+  uint_t i;
+
+  capturepolicyset = false;
+
+  for (i = 0; i < cursors.size(); i++) cursors[i]->ClearCapturePolicy();
+}
+
 bool ADMRIFFFile::PostReadChunks()
 {
   bool success = RIFFFile::PostReadChunks();
@@ -297,14 +420,38 @@ bool ADMRIFFFile::PostReadChunks()
   {
     RIFFChunk *chna = GetChunk(chna_ID);
     RIFFChunk *axml = GetChunk(axml_ID);
+    RIFFChunk *bxml = GetChunk(bxml_ID);
+    RIFFChunk *badm = GetChunk(badm_ID);
+    RIFFChunk *xml  = axml ? axml : bxml;       // axml chunk takes precedence over bxml chunk
 
     // ensure each chunk is valid
     if (adm &&
         chna && chna->GetData() &&
-        axml && axml->GetData())
+        xml  && xml->GetData())
     {
-      // decode chunks
-      success = adm->Set(chna->GetData(), chna->GetLength(), (const char *)axml->GetData());
+      // use binary form of ADM if it was written with these chna and axml (or bxml) chunks, otherwise decode chunks
+      if (badm && badm->GetData() && adm->SetBinary(badm->GetData(), badm->GetLength(), GetADMSourceHash(chna, xml)))
+      {
+        BBCDEBUG1(("Read ADM from badm chunk"));
+        success = true;
+      }
+      else if (xml == axml) success = adm->Set(chna->GetData(), chna->GetLength(), (const char *)axml->GetData());
+      else
+      {
+        const BXML_CHUNK *chunk = (const BXML_CHUNK *)bxml->GetData();
+
+        // XML is decompressed and parsed in blocks
+        if ((bxml->GetLength() >= sizeof(*chunk)) && (chunk->Version == BXML_VERSION))
+        {
+          success = (adm->SetChna(chna->GetData(), chna->GetLength()) &&
+                     adm->SetCompressedAxml(chunk->Data, bxml->GetLength() - sizeof(*chunk)));
+        }
+        else
+        {
+          BBCERROR("Cannot decode ADM, unsupported bxml chunk");
+          success = false;
+        }
+      }
 
 #if BBCDEBUG_LEVEL >= 4
       { // dump ADM as text
@@ -337,7 +484,7 @@ bool ADMRIFFFile::PostReadChunks()
       BBCERROR("Cannot decode ADM, no ADM decoder available");
       success = false;
     }
-    else if (!chna || !axml)
+    else if (!chna || !xml)
     {
       // acceptable failure - chna and/or axml chunk not specified - not an ADM compatible BWF file but open anyway
       BBCDEBUG("Warning: no chna/axml chunks!");
@@ -435,24 +582,58 @@ bool ADMRIFFFile::PostReadChunks()
     else {
       // unacceptible failures: empty chna or empty axml chunks
       if (chna && !chna->GetData()) BBCERROR("Cannot decode ADM, chna chunk not available");
-      if (axml && !axml->GetData()) BBCERROR("Cannot decode ADM, axml chunk not available");
+      if (xml && !xml->GetData()) BBCERROR("Cannot decode ADM, %s chunk not available", (xml == axml) ? "axml" : "bxml");
       success = false;
     }
 
     // now that the data is dealt with, the chunk data can be deleted
     if (axml) axml->DeleteData();
+    if (bxml) bxml->DeleteData();
     if (chna) chna->DeleteData();
+    if (badm) badm->DeleteData();
   }
 
   return success;
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Return hash of chna and axml (or bxml) chunks (stored with binary form of the ADM)
+ */
+/*--------------------------------------------------------------------------------*/
+uint64_t ADMRIFFFile::GetADMSourceHash(const RIFFChunk *chna, const RIFFChunk *xml)
+{
+  uint64_t hash = XMLADMData::HashXML(NULL, NULL);      // initial hash value
+
+  if (chna && chna->GetData()) hash = XMLADMData::HashXML((const char *)chna->GetData(), (const char *)chna->GetData() + chna->GetLength(), hash);
+  if (xml  && xml->GetData())  hash = XMLADMData::HashXML((const char *)xml->GetData(),  (const char *)xml->GetData()  + xml->GetLength(),  hash);
+
+  return hash;
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Update current position within the file
  */
 /*--------------------------------------------------------------------------------*/
 void ADMRIFFFile::UpdateSamplePosition()
 {
+  // generate frames that are now complete
+  if (writing && framegenerator && filesamples) GenerateFrames(filesamples->GetAbsolutePositionNS());
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Generate Serial ADM frames that are complete at t
+ *
+ * @note objects are given their final IDs before the first frame is generated
+ */
+/*--------------------------------------------------------------------------------*/
+void ADMRIFFFile::GenerateFrames(uint64_t t)
+{
+  uint64_t frameduration = framegenerator->GetFrameDuration();
+
+  // frames MUST carry the IDs the ADM is finalised with, so change temporary IDs before the first
+  if (adm && !framegenerator->GetFrameCount() && frameduration && (t >= frameduration)) adm->ChangeTemporaryIDs();
+
+  framegenerator->Process(t);
 }
   
 /*--------------------------------------------------------------------------------*/
@@ -472,6 +653,9 @@ void ADMRIFFFile::SetObjectParameters(uint_t channel, const AudioObjectParameter
     PERFMON("Write ADM Channel Parameters");
     uint64_t t = filesamples ? filesamples->GetAbsolutePositionNS() : 0;
 
+    // frames ending at or before t can no longer change
+    if (framegenerator) GenerateFrames(t);
+
     cursors[channel]->Seek(t);
     cursors[channel]->SetObjectParameters(objparameters);
   }
@@ -9,6 +9,7 @@
 
 #include "RIFFFile.h"
 #include "XMLADMData.h"
+#include "ADMFrameGenerator.h"
 
 BBC_AUDIOTOOLBOX_START
 
@@ -104,6 +105,65 @@ public:
 
   ADMData *GetADM() const {return adm;}
 
+  /*--------------------------------------------------------------------------------*/
+  /** Enable/disable writing of the ADM in binary form (in a private badm chunk) as well as XML
+   *
+   * @note when reading, the badm chunk is used in preference to the axml chunk if it is
+   * @note present and was written with the chna and axml chunks in the file
+   * @note MUST be called before the file is created
+   */
+  /*--------------------------------------------------------------------------------*/
+  void EnableBinaryADM(bool enable = true) {binaryadm = enable;}
+  static void SetDefaultBinaryADM(bool enable = true) {defaultbinaryadm = enable;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Enable/disable writing of the ADM XML gzip compressed in a bxml chunk instead of an axml chunk
+   *
+   * @param enable true to write a bxml chunk
+   * @param level compression level (1 = fastest .. 9 = best)
+   *
+   * @note when reading, a bxml chunk is decoded if there is no axml chunk
+   * @note MUST be called before the file is created
+   */
+  /*--------------------------------------------------------------------------------*/
+  void EnableCompressedAxml(bool enable = true, int level = 6) {compressaxml = enable; compressionlevel = level;}
+  static void SetDefaultCompressedAxml(bool enable = true) {defaultcompressaxml = enable;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Enable/disable simplification of captured block formats when the file is closed
+   *
+   * @param tolerances maximum errors allowed in the rendered parameters
+   *
+   * @note see ADMAudioChannelFormat::SimplifyBlockFormats()
+   */
+  /*--------------------------------------------------------------------------------*/
+  void EnableBlockFormatSimplification(const ADMAudioChannelFormat::SIMPLIFYTOLERANCES& tolerances) {simplifyblocks = true; simplifytolerances = tolerances;}
+  void DisableBlockFormatSimplification() {simplifyblocks = false;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set/clear policy limiting the block formats created when positions are set
+   *
+   * @param policy capture policy applied to all track cursors
+   *
+   * @note see ADMTrackCursor::SetCapturePolicy()
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetCapturePolicy(const ADMTrackCursor::CAPTUREPOLICY& policy);
+  void ClearCapturePolicy();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set Serial ADM frame generator to generate frames as the file is written
+   *
+   * @param generator frame generator (or NULL to stop generating frames)
+   *
+   * @note generator is NOT owned by this object and MUST remain valid until the file is closed
+   * @note frames are generated as samples are written, parameters are set and the sample position
+   * @note is changed and remaining frames are generated when the file is closed (after the ADM
+   * @note has been finalised)
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetFrameGenerator(ADMFrameGenerator *generator) {framegenerator = generator;}
+
 protected:
   /*--------------------------------------------------------------------------------*/
   /** Post processing function - actually performs the interpretation of the ADM once
@@ -124,10 +184,55 @@ protected:
   /*--------------------------------------------------------------------------------*/
   virtual void UpdateSamplePosition();
 
+  /*--------------------------------------------------------------------------------*/
+  /** Generate Serial ADM frames that are complete at t
+   *
+   * @note objects are given their final IDs before the first frame is generated
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateFrames(uint64_t t);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return hash of chna and axml (or bxml) chunks (stored with binary form of the ADM)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static uint64_t GetADMSourceHash(const RIFFChunk *chna, const RIFFChunk *xml);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Sink hashing XML (and counting its length) without storing it
+   */
+  /*--------------------------------------------------------------------------------*/
+  class HashSink : public ADMXMLGenerator::Sink
+  {
+  public:
+    HashSink(uint64_t _hash) : ADMXMLGenerator::Sink(),
+                               hash(_hash) {}
+    virtual ~HashSink() {}
+
+    uint64_t GetHash() const {return hash;}
+
+  protected:
+    virtual bool WriteData(const char *data, uint_t len) {hash = XMLADMData::HashXML(data, data + len, hash); return true;}
+
+  protected:
+    uint64_t hash;
+  };
+
 protected:
   std::string admfile;
   XMLADMData  *adm;
   std::vector<ADMTrackCursor *> cursors;        // *only* used during writing an ADM file
+  bool        binaryadm;
+  bool        compressaxml;
+  int         compressionlevel;
+  bool        simplifyblocks;
+  ADMAudioChannelFormat::SIMPLIFYTOLERANCES simplifytolerances;
+  bool        capturepolicyset;
+  ADMTrackCursor::CAPTUREPOLICY capturepolicy;
+  ADMFrameGenerator *framegenerator;
+
+  static bool defaultbinaryadm;
+  static bool defaultcompressaxml;
 };
 
 BBC_AUDIOTOOLBOX_END
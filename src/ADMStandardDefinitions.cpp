@@ -0,0 +1,1386 @@
+/* Auto-generated from standarddefinitions.xml by generate-standard-definitions: DO NOT EDIT! */
+
+#include "ADMStandardDefinitions.h"
+
+BBC_AUDIOTOOLBOX_START
+
+const ADMSTANDARDDEFINITIONSRECORD ADMStandardDefinitions[] =
+{
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:775:3:pack:mono_(0+1+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010002"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:stereo_(0+2+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_0001000a"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:775:3:pack:3.0_(0+3+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_0001000b"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:775:3:pack:4.0_(0+4+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010009"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_0001000c"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:5.0_(0+5+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010003"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:5.1_(0+5+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_0001000d"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "6.1_(0+6+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010009"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_0001000e"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "7.1front_(0+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010026"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010027"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_0001000f"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "7.1back_(0+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010004"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:7.1top_(2+5+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000f"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010012"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "7.1side_5.1+sc_(0+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010024"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010025"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010013"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "7.1topside_5.1.2_(2+5+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010013"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010014"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010014"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "9.1screen_5.1.2+sc_(2+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010013"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010014"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010024"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010025"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010016"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "9.1_7.1.2_(2+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010013"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010014"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010005"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:9.1_5.4.1_(4+5+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000f"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010010"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:10.1_(4+5+1)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000f"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010015"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010007"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:10.2_(3+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010022"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010023"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010011"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010020"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010021"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010015"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "11.1_5.1.4+sc_(4+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000f"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010024"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010025"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010017"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "11.1_7.1.4_(4+7+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010022"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010023"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010008"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:13.1_(4+9+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010024"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010025"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010022"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010023"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010009"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "urn:itu:bs:2051:0:pack:22.2_(9+10+3)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010018"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010019"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010020"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010009"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010021"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010022"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010023"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000e"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001e"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001f"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010013"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010014"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010011"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010015"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010016"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010017"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioPackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatID", "AP_00010011"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioPackFormatName", "Auro-3D_(9+9+0)"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000f"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000e"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010013"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010014"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001e"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001f"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010001_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+030"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010002_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-030"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010003_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+000"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "LowFrequencyEffects"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "frequency", "120.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "typeDefinition", "lowPass"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010004_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:LFE"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-20.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "SurroundLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010005_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+110"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "110.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "SurroundRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010006_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-110"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-110.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010007"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontLeftOfCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010007_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+022"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "22.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010008"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontRightOfCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010008_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-022"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-22.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010009"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BackCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010009_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+180"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "180.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001000a"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "SideLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001000a_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+090"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "90.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001000b"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "SideRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001000b_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-090"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-90.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001000c"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001000c_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:T+000"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "90.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001000d"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopFrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001000d_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U+030"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001000e"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopFrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001000e_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U+000"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001000f"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopFrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001000f_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U-030"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopSurroundLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010010_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U+110"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "110.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010011"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopBackCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010011_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U+180"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "180.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopSurroundRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010012_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U-110"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-110.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010013"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopSideLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010013_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U+090"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "90.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010014"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopSideRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010014_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U-090"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-90.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010015"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BottomFrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010015_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:B+000"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010016"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BottomFrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010016_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:B+045"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010017"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BottomFrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010017_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:B-045"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010018"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontLeftWide"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010018_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+060"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "60.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010019"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontRightWide"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010019_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-060"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-60.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001001a"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BackLeftDiffuse"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001001a_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+135_Diff"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "135.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001001b"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BackRightDiffuse"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001001b_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-135_Diff"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-135.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BackLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001001c_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+135"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "135.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "BackRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001001d_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-135"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-135.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001001e"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopLeftBack"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001001e_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U+135"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "135.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_0001001f"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopRightBack"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_0001001f_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U-135"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-135.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010020"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "LowFrequencyEffectsL"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "frequency", "120.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "typeDefinition", "lowPass"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010020_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:LFEL"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-20.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010021"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "LowFrequencyEffectsR"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Value, 1, "frequency", "120.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "typeDefinition", "lowPass"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010021_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:LFER"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-20.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010022"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopLeftMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010022_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U+045"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010023"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "TopRightMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010023_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:U-045"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "30.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010024"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontLeftScreen"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010024_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+SC"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "25.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "screenEdgeLock", "left"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010025"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontRightScreen"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010025_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-SC"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-25.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "screenEdgeLock", "right"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010026"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontLeftMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010026_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M+045"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioChannelFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatID", "AC_00010027"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioChannelFormatName", "FrontRightMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "typeDefinition", "DirectSpeakers"},
+  {ADMStandardDefinitionsRecord_Block, 0, "audioBlockFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioBlockFormatID", "AC_00010027_00000001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "speakerLabel", "urn:itu:bs:2051:0:speaker:M-045"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "-45.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "azimuth"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "0.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "elevation"},
+  {ADMStandardDefinitionsRecord_Value, 1, "position", "1.0"},
+  {ADMStandardDefinitionsRecord_Attribute, 1, "coordinate", "distance"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010001"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010001_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010002"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010002"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010002_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010003"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010003"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010003_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010004"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_LowFrequencyEffects"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010004"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010004_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010005"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_SurroundLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010005"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010005_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010006"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_SurroundRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010006"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010006_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010007"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontLeftOfCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010007"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010007_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010008"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontRightOfCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010008"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010008_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010009"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BackCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010009"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010009_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001000a"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_SideLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001000a_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001000b"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_SideRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001000b_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001000c"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001000c_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001000d"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopFrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001000d_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001000e"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopFrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000e"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001000e_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001000f"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopFrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001000f"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001000f_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010010"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopSurroundLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010010"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010010_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010011"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopBackCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010011"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010011_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010012"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopSurroundRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010012"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010012_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010013"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopSideLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010013"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010013_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010014"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopSideRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010014"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010014_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010015"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BottomFrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010015"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010015_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010016"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BottomFrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010016"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010016_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010017"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BottomFrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010017"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010017_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010018"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontLeftWide"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010018"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010018_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010019"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontRightWide"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010019"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010019_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001001a"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BackLeftDiffuse"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001a"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001001a_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001001b"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BackRightDiffuse"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001b"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001001b_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001001c"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BackLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001c"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001001c_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001001d"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_BackRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001d"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001001d_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001001e"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopLeftBack"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001e"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001001e_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_0001001f"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopRightBack"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_0001001f"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_0001001f_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010020"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_LowFrequencyEffectsL"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010020"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010020_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010021"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_LowFrequencyEffectsR"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010021"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010021_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010022"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopLeftMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010022"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010022_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010023"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_TopRightMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010023"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010023_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010024"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontLeftScreen"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010024"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010024_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010025"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontRightScreen"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010025"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010025_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010026"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontLeftMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010026"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010026_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioStreamFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatID", "AS_00010027"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioStreamFormatName", "PCM_FrontRightMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioChannelFormatIDRef", "AC_00010027"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioTrackFormatIDRef", "AT_00010027_01"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010001_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010001"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010002_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010002"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010003_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010003"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010004_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_LowFrequencyEffects"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010004"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010005_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_SurroundLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010005"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010006_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_SurroundRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010006"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010007_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontLeftOfCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010007"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010008_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontRightOfCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010008"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010009_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BackCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010009"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001000a_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_SideLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001000a"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001000b_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_SideRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001000b"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001000c_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001000c"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001000d_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopFrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001000d"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001000e_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopFrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001000e"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001000f_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopFrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001000f"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010010_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopSurroundLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010010"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010011_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopBackCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010011"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010012_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopSurroundRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010012"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010013_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopSideLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010013"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010014_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopSideRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010014"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010015_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BottomFrontCentre"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010015"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010016_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BottomFrontLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010016"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010017_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BottomFrontRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010017"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010018_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontLeftWide"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010018"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010019_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontRightWide"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010019"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001001a_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BackLeftDiffuse"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001001a"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001001b_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BackRightDiffuse"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001001b"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001001c_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BackLeft"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001001c"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001001d_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_BackRight"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001001d"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001001e_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopLeftBack"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001001e"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_0001001f_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopRightBack"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_0001001f"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010020_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_LowFrequencyEffectsL"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010020"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010021_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_LowFrequencyEffectsR"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010021"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010022_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopLeftMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010022"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010023_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_TopRightMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010023"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010024_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontLeftScreen"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010024"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010025_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontRightScreen"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010025"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010026_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontLeftMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010026"},
+  {ADMStandardDefinitionsRecord_Object, 0, "audioTrackFormat", ""},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatID", "AT_00010027_01"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "audioTrackFormatName", "PCM_FrontRightMid"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatLabel", "0001"},
+  {ADMStandardDefinitionsRecord_Attribute, 0, "formatDefinition", "PCM"},
+  {ADMStandardDefinitionsRecord_Value, 1, "audioStreamFormatIDRef", "AS_00010027"},
+};
+
+const uint_t ADMStandardDefinitionsCount = NUMBEROF(ADMStandardDefinitions);
+
+BBC_AUDIOTOOLBOX_END
@@ -0,0 +1,43 @@
+#ifndef __ADM_STANDARD_DEFINITIONS__
+#define __ADM_STANDARD_DEFINITIONS__
+
+#include <bbcat-base/misc.h>
+
+BBC_AUDIOTOOLBOX_START
+
+/*--------------------------------------------------------------------------------*/
+/** Compiled-in standard definitions
+ *
+ * The standard definitions XML file is converted (by examples/generate-standard-definitions.cpp)
+ * into a flat list of records which can be turned into ADM objects without any file access
+ * or XML parsing
+ *
+ * Records follow the structure of the XML:
+ *   Object:    name = object type (e.g. audioPackFormat), starts a new object
+ *   Block:     name = contained object type (audioBlockFormat), starts a new block within the last object
+ *   Attribute: name/value of an attribute of the last object or block (level 0) or of the last value (level > 0)
+ *   Value:     name/value of a value of the last object or block (level 1) or a sub-value of the last value (level > 1)
+ */
+/*--------------------------------------------------------------------------------*/
+typedef struct
+{
+  uint8_t    type;          ///< ADMStandardDefinitionsRecord_xxx
+  uint8_t    level;         ///< nesting level (see above)
+  const char *name;
+  const char *value;
+} ADMSTANDARDDEFINITIONSRECORD;
+
+enum {
+  ADMStandardDefinitionsRecord_Object = 0,
+  ADMStandardDefinitionsRecord_Block,
+  ADMStandardDefinitionsRecord_Attribute,
+  ADMStandardDefinitionsRecord_Value,
+};
+
+// generated list of records (in ADMStandardDefinitions.cpp)
+extern const ADMSTANDARDDEFINITIONSRECORD ADMStandardDefinitions[];
+extern const uint_t                       ADMStandardDefinitionsCount;
+
+BBC_AUDIOTOOLBOX_END
+
+#endif
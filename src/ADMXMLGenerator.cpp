@@ -2,14 +2,46 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include <algorithm>
 
 #define BBCDEBUG_LEVEL 1
+#include <bbcat-base/Thread.h>
+
 #include "ADMXMLGenerator.h"
 
 BBC_AUDIOTOOLBOX_START
 
 namespace ADMXMLGenerator
 {
+  // size of chunks XML is supplied to sinks in
+  static const uint_t SinkChunkSize = 65536;
+
+  // number of threads used to generate audioChannelFormat XML (see SetGenerateThreads())
+  static uint_t generatethreads = 1;
+
+  // compact output options (see SetCompactMode())
+  static uint_t compactmode = 0;
+
+  // ADM defaults of audioBlockFormat elements, omitted by Compact_SuppressDefaults
+  static const struct {
+    const char *name;
+    double     value;
+  } blockformatdefaults[] = {
+    {"cartesian",        0.0},
+    {"gain",             1.0},
+    {"width",            0.0},
+    {"height",           0.0},
+    {"depth",            0.0},
+    {"diffuse",          0.0},
+    {"jumpPosition",     0.0},
+    {"objectDivergence", 0.0},
+    {"channelLock",      0.0},
+    {"importance",      10.0},
+  };
+
   /*--------------------------------------------------------------------------------*/
   /** Context structure for generating XML (this object ONLY!)
    */
@@ -20,33 +52,212 @@ namespace ADMXMLGenerator
       std::string *str;                 ///< ptr string into which XML is generated (or NULL)
       char        *buf;                 ///< raw char buffer (PRE-ALLOCATED) to generate XML in
       uint64_t    buflen;               ///< max length of above length (EXCLUDING terminator)
+      Sink        *sink;                ///< sink to write XML to in chunks (or NULL)
     } destination;                      ///< destination control
+    std::string chunk;                  ///< XML waiting to be written to sink
+    bool        failed;                 ///< true if writing to sink has failed
     std::string indent;                 ///< indent string for each level
     std::string eol;                    ///< end-of-line string
+    std::string indents;                ///< indent string repeated for the deepest level so far
     uint64_t    length;                 ///< length of XML data at completion
+    uint64_t    indentcount;            ///< number of indents appended
     uint_t      ind_level;              ///< current indentation level
     bool        ebumode;                ///< true to generate EBU XML format, false to generate ITU XML format
     bool        opened;                 ///< true if object is started but not ready for data (needs '>')
     bool        complete;               ///< dump ALL objects, not just programme, content or objects
     bool        eollast;                ///< string currently ends with an eol
-    std::vector<std::string> stack;     ///< object stack
+    bool        measure;                ///< only the length is required (objects can supply lengths without generating XML)
+    uint_t      compact;                ///< compact output options (Compact_xxx)
+    const FRAME *frame;                 ///< Serial ADM frame being generated (or NULL for complete ADM)
+    std::vector<std::string> stack;     ///< object stack (entries beyond depth are kept to reuse their memory)
+    uint_t      depth;                  ///< number of objects on stack
+    XMLValues   values;                 ///< values of current object (kept to reuse memory)
+    std::vector<ADMObject::REFERENCEDOBJECT> objects; ///< references of current object (kept to reuse memory)
+    ADMObject::CONTAINEDOBJECT containedobject;      ///< contained object (kept to reuse memory)
   } TEXTXML;
 
+  /*--------------------------------------------------------------------------------*/
+  /** Shared state of threads generating XML for a list of objects
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    const TEXTXML                  *xml;        ///< context objects are generated within (settings only)
+    const std::vector<const ADMObject *> *objects;  ///< objects to generate XML for
+    std::vector<std::string>       fragments;   ///< XML of objects not yet appended (object n uses entry n % window)
+    std::vector<bool>              done;        ///< true for each entry of fragments once its object has been generated
+    uint_t                         window;      ///< maximum number of objects held as XML at once
+    uint_t                         next;        ///< next object to generate
+    uint_t                         written;     ///< next object to append to the output
+    ThreadLockObject               tlock;       ///< protects done, next and written
+  } WORKERS;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set number of threads used to generate audioChannelFormat XML
+   *
+   * @param n number of threads (including the calling thread), 1 disables parallel generation
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetGenerateThreads(uint_t n)
+  {
+    generatethreads = std::max(n, (uint_t)1);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return number of threads used to generate audioChannelFormat XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t GetGenerateThreads()
+  {
+    return generatethreads;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set compact output options for all subsequent XML generation
+   *
+   * @param flags combination of Compact_xxx flags (0 for normal output)
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetCompactMode(uint_t flags)
+  {
+    compactmode = flags;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return compact output options
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t GetCompactMode()
+  {
+    return compactmode;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return XML entity for character or NULL if character does not need escaping
+   */
+  /*--------------------------------------------------------------------------------*/
+  const char *GetXMLEntity(char c)
+  {
+    const char *entity = NULL;
+
+    switch (c)
+    {
+      case '&':  entity = "&amp;";  break;
+      case '<':  entity = "&lt;";   break;
+      case '>':  entity = "&gt;";   break;
+      case '\"': entity = "&quot;"; break;
+      case '\'': entity = "&apos;"; break;
+      default: break;
+    }
+
+    return entity;
+  }
+
   /*--------------------------------------------------------------------------------*/
   /** Encode XML string
    */
   /*--------------------------------------------------------------------------------*/
   std::string EscapeXML(const std::string& _str)
   {
-    std::string str = _str;
-    str = SearchAndReplace(str, "&",  "&amp;");
-    str = SearchAndReplace(str, "<",  "&lt;");
-    str = SearchAndReplace(str, ">",  "&gt;");
-    str = SearchAndReplace(str, "\"", "&quot;");
-    str = SearchAndReplace(str, "'",  "&apos;");
+    std::string str;
+    uint_t i;
+
+    // fast path: nothing to escape
+    if (!strpbrk(_str.c_str(), "&<>\"'")) return _str;
+
+    str.reserve(_str.length() + 16);
+    for (i = 0; i < _str.length(); i++)
+    {
+      const char *entity;
+
+      if ((entity = GetXMLEntity(_str[i])) != NULL) str += entity;
+      else                                          str += _str[i];
+    }
+
     return str;
   }
-  
+
+  /*--------------------------------------------------------------------------------*/
+  /** Write data to sink
+   *
+   * @param xml user supplied argument representing context data
+   * @param str data to be written
+   * @param len length of data
+   */
+  /*--------------------------------------------------------------------------------*/
+  void WriteSink(TEXTXML& xml, const char *str, size_t len)
+  {
+    // once sink has failed, don't write any more to it
+    while (!xml.failed && len)
+    {
+      uint_t n = (uint_t)std::min(len, (size_t)0x40000000);
+
+      if (xml.destination.sink->Write(str, n))
+      {
+        str += n;
+        len -= n;
+      }
+      else
+      {
+        BBCERROR("Failed to write XML to sink");
+        xml.failed = true;
+      }
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Write XML waiting in chunk buffer to sink
+   *
+   * @param xml user supplied argument representing context data
+   */
+  /*--------------------------------------------------------------------------------*/
+  void FlushXML(TEXTXML& xml)
+  {
+    if (xml.destination.sink && xml.chunk.length())
+    {
+      WriteSink(xml, xml.chunk.data(), xml.chunk.length());
+      xml.chunk.clear();
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Append data to XML context
+   *
+   * @param xml user supplied argument representing context data
+   * @param str data to be appended/counted
+   * @param len length of data
+   */
+  /*--------------------------------------------------------------------------------*/
+  void AppendXML(TEXTXML& xml, const char *str, size_t len)
+  {
+    if (len)
+    {
+      size_t eollen = xml.eol.length();
+
+      // copy data to destination, if one specified
+      if (xml.destination.str) xml.destination.str->append(str, len);
+      else if (xml.destination.sink)
+      {
+        if ((xml.chunk.length() + len) > SinkChunkSize) FlushXML(xml);
+
+        // large pieces (e.g. XML generated on other threads) are written directly
+        if (len >= SinkChunkSize) WriteSink(xml, str, len);
+        else                      xml.chunk.append(str, len);
+      }
+      else if (xml.destination.buf &&
+               ((xml.length + len) <= xml.destination.buflen))
+      {
+        memcpy(xml.destination.buf + xml.length, str, len);
+        xml.destination.buf[xml.length + len] = 0;
+      }
+
+      // update length
+      xml.length += len;
+
+      // update flag to indicate whether buffer ends with an eol
+      xml.eollast = (eollen && (len >= eollen) && (memcmp(str + len - eollen, xml.eol.data(), eollen) == 0));
+    }
+  }
+
   /*--------------------------------------------------------------------------------*/
   /** Append string to XML context
    *
@@ -56,21 +267,69 @@ namespace ADMXMLGenerator
   /*--------------------------------------------------------------------------------*/
   void AppendXML(TEXTXML& xml, const std::string& str)
   {
-    if (str.length())
+    AppendXML(xml, str.data(), str.length());
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Append escaped string to XML context
+   *
+   * @param xml user supplied argument representing context data
+   * @param str string to be escaped and appended/counted
+   *
+   * @note the string is scanned once, unescaped runs being appended directly
+   */
+  /*--------------------------------------------------------------------------------*/
+  void AppendEscapedXML(TEXTXML& xml, const std::string& str)
+  {
+    const char *p   = str.data();
+    const char *end = p + str.length();
+    const char *p1;
+    bool escaped = false;
+
+    for (p1 = p; p1 < end; p1++)
     {
-      // copy string to destination, if one specified
-      if      (xml.destination.str) *xml.destination.str += str;
-      else if (xml.destination.buf &&
-               ((xml.length + str.length()) <= xml.destination.buflen)) strcpy(xml.destination.buf + xml.length, str.c_str());
-  
-      // update length
-      xml.length += str.length();
+      const char *entity;
+
+      if ((entity = GetXMLEntity(*p1)) != NULL)
+      {
+        AppendXML(xml, p, p1 - p);
+        AppendXML(xml, entity, strlen(entity));
+        p       = p1 + 1;
+        escaped = true;
+      }
+    }
 
-      // update flag to indicate whether buffer ends with an eol 
-      xml.eollast = (xml.eol.length() && (str.length() >= xml.eol.length()) && (str.substr(str.length() - xml.eol.length()) == xml.eol));
+    AppendXML(xml, p, end - p);
+
+    // the escaped string is a single item as far as the eol check is concerned: if the final
+    // run was too short to check, check the escaped form of the end of the string (each
+    // character escapes to at least one character so this covers the eol)
+    if (escaped && ((size_t)(end - p) < xml.eol.length()))
+    {
+      std::string tail = EscapeXML(str.substr(str.length() - std::min(str.length(), xml.eol.length())));
+
+      xml.eollast = ((tail.length() >= xml.eol.length()) && (tail.compare(tail.length() - xml.eol.length(), xml.eol.length(), xml.eol) == 0));
     }
   }
 
+  /*--------------------------------------------------------------------------------*/
+  /** Append indentation for level to XML context
+   *
+   * @param xml user supplied argument representing context data
+   * @param level indentation level
+   */
+  /*--------------------------------------------------------------------------------*/
+  void AppendIndent(TEXTXML& xml, uint_t level)
+  {
+    size_t len = level * xml.indent.length();
+
+    // extend cached indentation as deeper levels are reached
+    while (xml.indents.length() < len) xml.indents += xml.indent;
+
+    AppendXML(xml, xml.indents.data(), len);
+    xml.indentcount++;
+  }
+
   /*--------------------------------------------------------------------------------*/
   /** Start XML
    *
@@ -106,28 +365,44 @@ namespace ADMXMLGenerator
   void OpenXMLObject(TEXTXML& xml, const std::string& name)
   {
     // ensure any previous object is properly marked ready for data
-    if (xml.stack.size() && xml.opened)
+    if (xml.depth && xml.opened)
     {
-      AppendXML(xml, ">");
+      AppendXML(xml, ">", 1);
       xml.opened = false;
     }
 
     // add a newline if last bit of string isn't an eol
     if (!xml.eollast) AppendXML(xml, xml.eol);
 
-    std::string str;
-    Printf(str,
-           "%s<%s",
-           CreateIndent(xml.indent, xml.ind_level + (uint_t)xml.stack.size()).c_str(),
-           name.c_str());
+    AppendIndent(xml, xml.ind_level + xml.depth);
+    AppendXML(xml, "<", 1);
+    AppendXML(xml, name);
 
-    AppendXML(xml, str);
-  
-    // stack this object name (for closing)
-    xml.stack.push_back(name);
+    // stack this object name (for closing), reusing the memory of previous entries
+    if (xml.depth == xml.stack.size()) xml.stack.push_back(name);
+    else                               xml.stack[xml.depth] = name;
+    xml.depth++;
     xml.opened = true;
   }
   
+  /*--------------------------------------------------------------------------------*/
+  /** Get to the state following a completed object in the same way as OpenXMLObject() would
+   *
+   * @param xml user supplied argument representing context data
+   *
+   * @note used before appending XML generated separately in that state
+   */
+  /*--------------------------------------------------------------------------------*/
+  void CompleteXMLObject(TEXTXML& xml)
+  {
+    if (xml.depth && xml.opened)
+    {
+      AppendXML(xml, ">", 1);
+      xml.opened = false;
+    }
+    if (!xml.eollast) AppendXML(xml, xml.eol);
+  }
+
   /*--------------------------------------------------------------------------------*/
   /** Add an attribute to the current XML object
    *
@@ -140,10 +415,11 @@ namespace ADMXMLGenerator
   /*--------------------------------------------------------------------------------*/
   void AddXMLAttribute(TEXTXML& xml, const std::string& name, const std::string& value)
   {
-    std::string str;
-    Printf(str, " %s=\"%s\"", name.c_str(), EscapeXML(value).c_str());
-
-    AppendXML(xml, str);
+    AppendXML(xml, " ", 1);
+    AppendXML(xml, name);
+    AppendXML(xml, "=\"", 2);
+    AppendEscapedXML(xml, value);
+    AppendXML(xml, "\"", 1);
   }
 
   /*--------------------------------------------------------------------------------*/
@@ -158,13 +434,13 @@ namespace ADMXMLGenerator
   void SetXMLData(TEXTXML& xml, const std::string& data)
   {
     // ensure any object is marked ready for data
-    if (xml.stack.size() && xml.opened)
+    if (xml.depth && xml.opened)
     {
-      AppendXML(xml, ">");
+      AppendXML(xml, ">", 1);
       xml.opened = false;
     }
 
-    AppendXML(xml, EscapeXML(data));
+    AppendEscapedXML(xml, data);
   }
 
   /*--------------------------------------------------------------------------------*/
@@ -177,22 +453,25 @@ namespace ADMXMLGenerator
   /*--------------------------------------------------------------------------------*/
   void CloseXMLObject(TEXTXML& xml)
   {
-    if (xml.stack.size() && xml.opened)
+    if (xml.depth && xml.opened)
     {
       // object is empty
-      AppendXML(xml, " />" + xml.eol);
+      if (xml.compact & Compact_Whitespace) AppendXML(xml, "/>", 2);
+      else                                  AppendXML(xml, " />", 3);
+      AppendXML(xml, xml.eol);
       xml.opened = false;
     }
     else
     {
-      if (xml.eollast) AppendXML(xml, CreateIndent(xml.indent, xml.ind_level + (uint_t)xml.stack.size() - 1));
+      if (xml.eollast) AppendIndent(xml, xml.ind_level + xml.depth - 1);
 
-      std::string str;
-      Printf(str, "</%s>%s", xml.stack.back().c_str(), xml.eol.c_str());
-      AppendXML(xml, str);
+      AppendXML(xml, "</", 2);
+      AppendXML(xml, xml.stack[xml.depth - 1]);
+      AppendXML(xml, ">", 1);
+      AppendXML(xml, xml.eol);
     }
 
-    xml.stack.pop_back();
+    xml.depth--;
   }
 
   /*--------------------------------------------------------------------------------*/
@@ -220,6 +499,37 @@ namespace ADMXMLGenerator
     }
   }
 
+  void AddXMLValues(TEXTXML& xml, const XMLValues& values);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Add value (non-attribute) to object
+   *
+   * @param xml user supplied argument representing context data
+   * @param value XML value
+   *
+   * @note for other XML implementaions, this function MUST be overridden
+   */
+  /*--------------------------------------------------------------------------------*/
+  void AddXMLValue(TEXTXML& xml, const XMLValue& value)
+  {
+    XMLValue::ATTRS::const_iterator it;
+    const XMLValues *subvalues;
+
+    OpenXMLObject(xml, value.name);
+
+    for (it = value.attrs.begin(); it != value.attrs.end(); ++it)
+    {
+      AddXMLAttribute(xml, it->first, it->second);
+    }
+
+    // if value has sub-values, output those
+    if ((subvalues = value.GetSubValues()) != NULL) AddXMLValues(xml, *subvalues);
+    // otherwise output single value
+    else SetXMLData(xml, value.value);
+
+    CloseXMLObject(xml);
+  }
+
   /*--------------------------------------------------------------------------------*/
   /** Add values (non-attributres) from list of XML values to object
    *
@@ -236,27 +546,7 @@ namespace ADMXMLGenerator
     // output values
     for (i = 0; i < values.size(); i++)
     {
-      const XMLValue& value = values[i];
-
-      if (!value.attr)
-      {
-        XMLValue::ATTRS::const_iterator it;
-        const XMLValues *subvalues;
-        
-        OpenXMLObject(xml, value.name);
-
-        for (it = value.attrs.begin(); it != value.attrs.end(); ++it)
-        {
-          AddXMLAttribute(xml, it->first, it->second);
-        }
-
-        // if value has sub-values, output those
-        if ((subvalues = value.GetSubValues()) != NULL) AddXMLValues(xml, *subvalues);
-        // otherwise output single value
-        else SetXMLData(xml, value.value);
-
-        CloseXMLObject(xml);
-      }
+      if (!values[i].attr) AddXMLValue(xml, values[i]);
     }
   }
 
@@ -266,10 +556,10 @@ namespace ADMXMLGenerator
   /*--------------------------------------------------------------------------------*/
   void AppendExtraXML(TEXTXML& xml)
   {
-    if (xml.stack.size() && xml.opened)
+    if (xml.depth && xml.opened)
     {
       const XMLValues *values;
-      std::string parentname = xml.stack[xml.stack.size() - 1];
+      std::string parentname = xml.stack[xml.depth - 1];
 
       // for root node, use empty name
       if ((parentname == "ebuCoreMain") ||
@@ -284,90 +574,467 @@ namespace ADMXMLGenerator
   }
 
   /*--------------------------------------------------------------------------------*/
-  /** Generic XML creation
+  /** Return true if XML value is a simple audioBlockFormat element equal to its ADM default
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool IsDefaultBlockFormatValue(const XMLValue& value)
+  {
+    bool   isdefault = false;
+    uint_t i;
+
+    // elements with attributes or sub-values carry more than their value
+    if (!value.attr && value.attrs.empty() && !value.GetSubValues())
+    {
+      for (i = 0; i < NUMBEROF(blockformatdefaults); i++)
+      {
+        if (value.name == blockformatdefaults[i].name)
+        {
+          const char *str = value.value.c_str();
+          char       *end;
+          double     val;
+
+          // boolean values may be written as words
+          if      (value.value == "false") val = 0.0;
+          else if (value.value == "true")  val = 1.0;
+          else if (((val = strtod(str, &end)) == 0.0) && (end == str)) break;
+          else if (*end) break;
+
+          isdefault = (val == blockformatdefaults[i].value);
+          break;
+        }
+      }
+    }
+
+    return isdefault;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate XML for the block formats of a channel format in compact form
    *
-   * @param obj ADM object to generate XML for
+   * @param channelformat channel format
    * @param xml user supplied argument representing context data
    *
-   * @note for other XML implementaions, this function can be overridden
+   * @note Compact_MergeBlocks merges runs of contiguous block formats with identical
+   * @note values into a single block format spanning the run
+   * @note Compact_SuppressDefaults omits values equal to their ADM defaults
    */
   /*--------------------------------------------------------------------------------*/
-  void GenerateXML(const ADMObject *obj, TEXTXML& xml)
+  void GenerateCompactBlockFormats(const ADMAudioChannelFormat *channelformat, TEXTXML& xml)
   {
-    if (xml.complete || !obj->IsStandardDefinition())
+    ADMAudioBlockFormatRefs blockformatrefs = channelformat->GetBlockFormatRefs();
+    XMLValues attrs, values, nextattrs, nextvalues;
+    uint_t    i, j, k, n = 0;
+
+    for (i = 0; i < blockformatrefs.size(); i = j)
     {
-      std::vector<ADMObject::REFERENCEDOBJECT> objects;
-      XMLValues values;
-      uint_t    i;
-      bool      emptyobject = true;
+      const ADMAudioBlockFormat *block = blockformatrefs[i];
+      std::string id;
+      XMLValue    value;
 
-      obj->GetValuesAndReferences(values, objects);
+      // IDs are numbered by output block format so remain consecutive after merging
+      Printf(id, "%s%s_%08x", block->GetIDPrefix().c_str(), channelformat->GetID().substr(channelformat->GetIDPrefix().length()).c_str(), ++n);
 
-      // if object has contained objects, it cannot be empty
-      emptyobject &= (obj->GetContainedObjectCount() == 0);
-    
-      // test to see if this object is 'empty'
-      for (i = 0; emptyobject && (i < values.size()); i++)
-      {
-        emptyobject &= !(!values[i].attr);                            // if any values (non-attribute) found, object cannot be empty
-      }
-      for (i = 0; emptyobject && (i < objects.size()); i++)
-      {
-        emptyobject &= !objects[i].genref;                            // if any references to be generated, object cannot be empty
-      }
+      attrs.clear();
+      values.clear();
+      value.SetAttribute(block->GetType() + "ID", id);
+      attrs.AddValue(value);
+      block->GetValues(attrs, values);
 
-      // start XML object
-      OpenXMLObject(xml, obj->GetType());
-      AddXMLAttributes(xml, values);
-                     
-      if (!emptyobject)
+      j = i + 1;
+      if ((xml.compact & Compact_MergeBlocks) && block->RTimeSet() && block->DurationSet())
       {
-        AddXMLValues(xml, values);
-                   
-        // output references
-        for (i = 0; i < objects.size(); i++)
+        uint64_t end = block->GetRTime() + block->GetDuration();
+
+        // extend over following block formats that start where the run ends and are otherwise identical
+        for (; j < blockformatrefs.size(); j++)
         {
-          const ADMObject::REFERENCEDOBJECT& object = objects[i];
+          const ADMAudioBlockFormat *next = blockformatrefs[j];
 
-          if (object.genref)
-          {
-            // output reference to object.obj
-            OpenXMLObject(xml, object.obj->GetReference());
-            SetXMLData(xml, object.obj->GetID());
-            CloseXMLObject(xml);
-          }
+          if (!next->RTimeSet() || !next->DurationSet() || (next->GetRTime() != end)) break;
+
+          nextattrs.clear();
+          nextvalues.clear();
+          next->GetValues(nextattrs, nextvalues);
+          if (values != nextvalues) break;
+
+          end = next->GetRTime() + next->GetDuration();
         }
 
-        // output contained data
-        ADMObject::CONTAINEDOBJECT object;
-        for (i = 0; obj->GetContainedObject(i, object); i++)
+        if (j > (i + 1))
         {
-          OpenXMLObject(xml, object.type);
-          AddXMLAttributes(xml, object.attrs);
-          AddXMLValues(xml, object.values);
-          CloseXMLObject(xml);
+          // update duration to cover the whole run
+          for (k = 0; k < attrs.size(); k++)
+          {
+            if (attrs[k].name == "duration") attrs[k].SetAttribute("duration", end - block->GetRTime());
+          }
         }
-
-        // end XML object
-        CloseXMLObject(xml);
       }
-      else
+
+      OpenXMLObject(xml, block->GetType());
+      AddXMLAttributes(xml, attrs);
+
+      if (xml.compact & Compact_SuppressDefaults)
       {
-        // end empty XML object
-        CloseXMLObject(xml);
+        for (k = 0; k < values.size(); k++)
+        {
+          if (!values[k].attr && !IsDefaultBlockFormatValue(values[k])) AddXMLValue(xml, values[k]);
+        }
       }
+      else AddXMLValues(xml, values);
+
+      CloseXMLObject(xml);
     }
   }
-  
+
   /*--------------------------------------------------------------------------------*/
-  /** Generic XML creation
+  /** Generate XML for the block formats of a channel format that are active within the frame
    *
+   * @param channelformat channel format
    * @param xml user supplied argument representing context data
    *
-   * @note for other XML implementaions, this function can be overridden
+   * @note block formats are output whole in every frame they overlap, block formats
+   * @note without a duration (not yet ended) are output lasting until the end of the frame
    */
   /*--------------------------------------------------------------------------------*/
-  void GenerateXML(TEXTXML& xml)
+  void GenerateFrameBlockFormats(const ADMAudioChannelFormat *channelformat, TEXTXML& xml)
+  {
+    ADMAudioBlockFormatRefs                   blockformatrefs = channelformat->GetBlockFormatRefs();
+    const ADMAudioBlockTimeline&              timeline        = channelformat->GetTimeline();
+    std::map<const ADMAudioChannelFormat *, uint64_t>::const_iterator it;
+    ADMObject::CONTAINEDOBJECT& object = xml.containedobject;
+    uint64_t offset   = ((it = xml.frame->offsets.find(channelformat)) != xml.frame->offsets.end()) ? it->second : 0;
+    uint64_t frameend = xml.frame->start + xml.frame->duration;
+    uint64_t start, end;
+    uint_t   i, k, n = (uint_t)blockformatrefs.size();
+
+    // nothing can be active before the object starts
+    if (frameend <= offset) return;
+
+    // frame relative to object start
+    start = (xml.frame->start > offset) ? xml.frame->start - offset : 0;
+    end   = frameend - offset;
+
+    // find first block format that could be active using the timeline (avoids touching each block format)
+    i = (timeline.size() == n) ? timeline.Find(start, 0) : 0;
+
+    for (; i < n; i++)
+    {
+      const ADMAudioBlockFormat *block = blockformatrefs[i];
+      uint64_t blockstart = block->RTimeSet() ? block->GetRTime() : 0;
+      uint64_t blockend   = (block->RTimeSet() && block->DurationSet()) ? blockstart + block->GetDuration() : end;
+
+      if (blockstart >= end) break;
+      if ((blockend <= start) || !channelformat->GetContainedObject(i, object)) continue;
+
+      OpenXMLObject(xml, object.type);
+      AddXMLAttributes(xml, object.attrs);
+      if (block->RTimeSet() && !block->DurationSet())
+      {
+        // block format not yet ended lasts (for now) until the end of the frame
+        AddXMLAttribute(xml, "duration", GenerateTime(end - blockstart));
+      }
+
+      if (xml.compact & Compact_SuppressDefaults)
+      {
+        for (k = 0; k < object.values.size(); k++)
+        {
+          if (!object.values[k].attr && !IsDefaultBlockFormatValue(object.values[k])) AddXMLValue(xml, object.values[k]);
+        }
+      }
+      else AddXMLValues(xml, object.values);
+
+      CloseXMLObject(xml);
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generic XML creation
+   *
+   * @param obj ADM object to generate XML for
+   * @param xml user supplied argument representing context data
+   *
+   * @note for other XML implementaions, this function can be overridden
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateXML(const ADMObject *obj, TEXTXML& xml)
+  {
+    if (xml.complete || !obj->IsStandardDefinition())
+    {
+      // values and references are held in the context to reuse their memory from object to object
+      std::vector<ADMObject::REFERENCEDOBJECT>& objects = xml.objects;
+      XMLValues& values = xml.values;
+      uint_t     i;
+      bool       emptyobject = true;
+
+      values.clear();
+      objects.clear();
+      obj->GetValuesAndReferences(values, objects);
+
+      // if object has contained objects, it cannot be empty
+      emptyobject &= (obj->GetContainedObjectCount() == 0);
+    
+      // test to see if this object is 'empty'
+      for (i = 0; emptyobject && (i < values.size()); i++)
+      {
+        emptyobject &= !(!values[i].attr);                            // if any values (non-attribute) found, object cannot be empty
+      }
+      for (i = 0; emptyobject && (i < objects.size()); i++)
+      {
+        emptyobject &= !objects[i].genref;                            // if any references to be generated, object cannot be empty
+      }
+
+      // start XML object
+      OpenXMLObject(xml, obj->GetType());
+      AddXMLAttributes(xml, values);
+                     
+      if (!emptyobject)
+      {
+        AddXMLValues(xml, values);
+                   
+        // output references
+        for (i = 0; i < objects.size(); i++)
+        {
+          const ADMObject::REFERENCEDOBJECT& object = objects[i];
+
+          if (object.genref)
+          {
+            // output reference to object.obj
+            OpenXMLObject(xml, object.obj->GetReference());
+            SetXMLData(xml, object.obj->GetID());
+            CloseXMLObject(xml);
+          }
+        }
+
+        // output contained data
+        ADMObject::CONTAINEDOBJECT& object = xml.containedobject;
+        const ADMAudioChannelFormat *channelformat;
+        const std::string *cached;
+        uint64_t len;
+        if (xml.frame &&
+            ((channelformat = dynamic_cast<const ADMAudioChannelFormat *>(obj)) != NULL))
+        {
+          GenerateFrameBlockFormats(channelformat, xml);
+        }
+        else if ((xml.compact & (Compact_SuppressDefaults | Compact_MergeBlocks)) &&
+                 ((channelformat = dynamic_cast<const ADMAudioChannelFormat *>(obj)) != NULL))
+        {
+          GenerateCompactBlockFormats(channelformat, xml);
+        }
+        // lengths and cached XML are only held for normal output
+        else if (!xml.compact &&
+                 xml.measure &&
+            obj->GetContainedObjectsXMLLength(xml.indent, xml.eol, xml.ind_level + xml.depth, len) &&
+            len)
+        {
+          // object knows the length of its contained objects, which are measured in the
+          // state following a completed object so get to that state as OpenXMLObject() would
+          CompleteXMLObject(xml);
+
+          xml.length += len;
+          xml.eollast = (xml.eol.length() != 0);
+        }
+        else if (!xml.compact &&
+                 ((cached = obj->GetContainedObjectsXML(xml.indent, xml.eol, xml.ind_level + xml.depth)) != NULL) &&
+                 cached->length())
+        {
+          // cached XML was also generated in the state following a completed object
+          CompleteXMLObject(xml);
+          AppendXML(xml, *cached);
+        }
+        else
+        {
+          for (i = 0; obj->GetContainedObject(i, object); i++)
+          {
+            OpenXMLObject(xml, object.type);
+            AddXMLAttributes(xml, object.attrs);
+            AddXMLValues(xml, object.values);
+            CloseXMLObject(xml);
+          }
+        }
+
+        // end XML object
+        CloseXMLObject(xml);
+      }
+      else
+      {
+        // end empty XML object
+        CloseXMLObject(xml);
+      }
+    }
+  }
+  
+  /*--------------------------------------------------------------------------------*/
+  /** Take the next object from the shared list if it is within the window of objects held as XML
+   *
+   * @param workers shared state
+   * @param n variable to be set to the index of the object taken
+   * @param remaining variable to be set to true if there are objects left to take
+   *
+   * @return true if an object was taken
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool TakeXMLObject(WORKERS& workers, uint_t& n, bool& remaining)
+  {
+    ThreadLock lock(workers.tlock);
+
+    remaining = (workers.next < workers.objects->size());
+    if (remaining && (workers.next < (workers.written + workers.window)))
+    {
+      n = workers.next++;
+      return true;
+    }
+
+    return false;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate XML for a single object of the shared list into its own string
+   *
+   * @param workers shared state
+   * @param n index of object
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateXMLFragment(WORKERS& workers, uint_t n)
+  {
+    // generate object XML into its own string, in the state following a completed object
+    const TEXTXML& parent = *workers.xml;
+    TEXTXML context;
+    uint_t  slot = n % workers.window;
+
+    context.adm       = parent.adm;
+
+    // clear destination data
+    memset(&context.destination, 0, sizeof(context.destination));
+
+    // set string destination to use (the slot is not touched by anything else until marked as done)
+    context.destination.str = &workers.fragments[slot];
+
+    context.ebumode   = parent.ebumode;
+    context.indent    = parent.indent;
+    context.eol       = parent.eol;
+    context.ind_level = parent.ind_level;
+    context.length    = 0;
+    context.indentcount = 0;
+    context.stack.assign(parent.stack.begin(), parent.stack.begin() + parent.depth);
+    context.depth     = parent.depth;
+    context.opened    = false;
+    context.complete  = parent.complete;
+    context.eollast   = (parent.eol.length() != 0);
+    context.measure   = false;
+    context.compact   = parent.compact;
+    context.frame     = parent.frame;
+    context.failed    = false;
+
+    GenerateXML((*workers.objects)[n], context);
+
+    ThreadLock lock(workers.tlock);
+    workers.done[slot] = true;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Thread entry point for generating XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  void *__GenerateXMLThread(Thread& thread, void *arg)
+  {
+    WORKERS& workers = *(WORKERS *)arg;
+    uint_t   n;
+    bool     remaining = true;
+
+    UNUSED_PARAMETER(thread);
+
+    while (remaining)
+    {
+      if (TakeXMLObject(workers, n, remaining)) GenerateXMLFragment(workers, n);
+      // window full: wait for the output to catch up
+      else if (remaining) Sleep(1);
+    }
+
+    return NULL;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate XML for a list of objects on a pool of threads
+   *
+   * @param objects list of objects
+   * @param xml user supplied argument representing context data
+   *
+   * @note the threads are started once for the whole list and each object is generated into its
+   * @note own string; the calling thread appends the strings in order (generating objects itself
+   * @note whilst it waits) so the output is identical to generating them serially
+   * @note at most a fixed window of objects is held as XML at once
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateXMLParallel(const std::vector<const ADMObject *>& objects, TEXTXML& xml)
+  {
+    WORKERS  workers;
+    Thread   *threads;
+    uint_t   i, n, nthreads = std::min(generatethreads, (uint_t)objects.size());
+    uint64_t t = GetNanosecondTicks();
+
+    workers.xml      = &xml;
+    workers.objects  = &objects;
+    // limit the number of objects held as XML at once
+    workers.window   = generatethreads * 4;
+    workers.fragments.resize(workers.window);
+    workers.done.resize(workers.window, false);
+    workers.next     = 0;
+    workers.written  = 0;
+
+    // this thread is one of the workers
+    threads = new Thread[nthreads - 1];
+    for (i = 0; i < (nthreads - 1); i++) threads[i].Start(&__GenerateXMLThread, &workers);
+
+    while (workers.written < objects.size())
+    {
+      std::string fragment;
+      bool        ready, remaining;
+
+      {
+        ThreadLock lock(workers.tlock);
+        uint_t     slot = workers.written % workers.window;
+
+        if ((ready = workers.done[slot]))
+        {
+          // take the string, leaving the slot empty for a later object
+          fragment.swap(workers.fragments[slot]);
+          workers.done[slot] = false;
+          workers.written++;
+        }
+      }
+
+      if (ready)
+      {
+        // objects that generate nothing leave the state unchanged
+        if (!fragment.length()) continue;
+
+        // fragments were generated in the state following a completed object
+        CompleteXMLObject(xml);
+
+        AppendXML(xml, fragment);
+      }
+      // generate objects rather than waiting for other threads
+      else if (TakeXMLObject(workers, n, remaining)) GenerateXMLFragment(workers, n);
+      else Sleep(1);
+    }
+
+    // wait for all threads to finish (they stop once every object has been taken)
+    for (i = 0; i < (nthreads - 1); i++) threads[i].Stop();
+
+    delete[] threads;
+
+    UNUSED_PARAMETER(t);
+    BBCDEBUG2(("Generated XML for %u objects using %u threads in %0.3lfms", (uint_t)objects.size(), nthreads, (double)(GetNanosecondTicks() - t) * 1.0e-6));
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate audioFormatExtended object and all ADM objects within it
+   *
+   * @param xml user supplied argument representing context data
+   * @param version version attribute (or empty for none)
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateAudioFormatExtended(TEXTXML& xml, const std::string& version = "")
   {
     std::vector<const ADMObject *> list;
     std::string types[] = {
@@ -391,6 +1058,55 @@ namespace ADMXMLGenerator
     // add referenced objects to list
     xml.adm->GetReferencedObjects(list);
 
+    OpenXMLObject(xml, "audioFormatExtended");
+    if (version.length()) AddXMLAttribute(xml, "version", version);
+    AppendExtraXML(xml);
+
+    for (i = 0; i < NUMBEROF(types); i++)
+    {
+      if ((generatethreads > 1) && !xml.measure && !xml.frame && (types[i] == ADMAudioChannelFormat::Type))
+      {
+        // channel formats (with their block formats) dominate the XML so generate them in parallel
+        std::vector<const ADMObject *> objects;
+
+        for (j = 0; j < list.size(); j++)
+        {
+          if (list[j]->GetType() == types[i]) objects.push_back(list[j]);
+        }
+
+        if (objects.size() > 1)
+        {
+          GenerateXMLParallel(objects, xml);
+          continue;
+        }
+      }
+
+      // find objects of correct type and output them
+      for (j = 0; j < list.size(); j++)
+      {
+        const ADMObject *obj = list[j];
+
+        // can this object be outputted?
+        if (obj->GetType() == types[i])
+        {
+          GenerateXML(obj, xml);
+        }
+      }
+    }
+
+    CloseXMLObject(xml);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generic XML creation
+   *
+   * @param xml user supplied argument representing context data
+   *
+   * @note for other XML implementaions, this function can be overridden
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateXML(TEXTXML& xml)
+  {
     StartXML(xml);
     
     if (xml.ebumode)
@@ -418,28 +1134,63 @@ namespace ADMXMLGenerator
     OpenXMLObject(xml, "format");
     AppendExtraXML(xml);
 
-    OpenXMLObject(xml, "audioFormatExtended");
-    AppendExtraXML(xml);
+    GenerateAudioFormatExtended(xml);
 
-    for (i = 0; i < NUMBEROF(types); i++)
-    {
-      // find objects of correct type and output them
-      for (j = 0; j < list.size(); j++)
-      {
-        const ADMObject *obj = list[j];
+    CloseXMLObject(xml);
+    CloseXMLObject(xml);
+    CloseXMLObject(xml);
+  }
 
-        // can this object be outputted?
-        if (obj->GetType() == types[i])
-        {
-          GenerateXML(obj, xml);
-        }
-      }
-    }
+  /*--------------------------------------------------------------------------------*/
+  /** Serial ADM frame XML creation
+   *
+   * @param xml user supplied argument representing context data (with frame set)
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateFrameXML(TEXTXML& xml)
+  {
+    std::string id;
 
+    StartXML(xml);
+
+    OpenXMLObject(xml, "frame");
+    AddXMLAttribute(xml, "version", "ITU-R_BS.2125-1");
+
+    OpenXMLObject(xml, "frameHeader");
+
+    // each frame contains all metadata so is 'full' and timed from the start of the programme
+    Printf(id, "FF_%08x", xml.frame->index);
+    OpenXMLObject(xml, "frameFormat");
+    AddXMLAttribute(xml, "frameFormatID", id);
+    AddXMLAttribute(xml, "type", "full");
+    AddXMLAttribute(xml, "start", GenerateTime(xml.frame->start));
+    AddXMLAttribute(xml, "duration", GenerateTime(xml.frame->duration));
+    AddXMLAttribute(xml, "timeReference", "total");
+    if (xml.frame->flowid.length()) AddXMLAttribute(xml, "flowID", xml.frame->flowid);
     CloseXMLObject(xml);
+
     CloseXMLObject(xml);
+
+    GenerateAudioFormatExtended(xml, "ITU-R_BS.2076-2");
+
     CloseXMLObject(xml);
-    CloseXMLObject(xml);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Apply compact output options to context
+   *
+   * @param xml user supplied argument representing context data
+   */
+  /*--------------------------------------------------------------------------------*/
+  void ApplyCompactMode(TEXTXML& xml)
+  {
+    xml.compact = compactmode;
+
+    if (xml.compact & Compact_Whitespace)
+    {
+      xml.indent.clear();
+      xml.eol.clear();
+    }
   }
 
   /*--------------------------------------------------------------------------------*/
@@ -454,10 +1205,11 @@ namespace ADMXMLGenerator
    *
    * @return total length of XML
    *
+   * @note frame selects a Serial ADM frame to generate instead of the complete ADM
    * @note for other XML implementaions, this function can be overridden
    */
   /*--------------------------------------------------------------------------------*/
-  uint64_t GenerateXML(const ADMData *adm, std::string& str, bool ebumode, const std::string& indent, const std::string& eol, uint_t ind_level, bool complete = false)
+  uint64_t GenerateXML(const ADMData *adm, std::string& str, bool ebumode, const std::string& indent, const std::string& eol, uint_t ind_level, bool complete = false, const FRAME *frame = NULL)
   {
     TEXTXML context;
 
@@ -474,11 +1226,18 @@ namespace ADMXMLGenerator
     context.eol       = eol;
     context.ind_level = ind_level;
     context.length    = 0;
+    context.indentcount = 0;
+    context.depth     = 0;
     context.opened    = false;
     context.complete  = complete;
     context.eollast   = false;
+    context.measure   = false;
+    context.frame     = frame;
+
+    ApplyCompactMode(context);
   
-    GenerateXML(context);
+    if (frame) GenerateFrameXML(context);
+    else       GenerateXML(context);
 
     return context.length;
   }
@@ -517,14 +1276,249 @@ namespace ADMXMLGenerator
     context.eol       = eol;
     context.ind_level = ind_level;
     context.length    = 0;
+    context.indentcount = 0;
+    context.depth     = 0;
+    context.opened    = false;
     context.complete  = complete;
     context.eollast   = false;
+    context.measure   = false;
+    context.frame     = NULL;
+
+    ApplyCompactMode(context);
   
     GenerateXML(context);
 
     return context.length;
   }
 
+  /*--------------------------------------------------------------------------------*/
+  /** Create XML representation of ADM, writing it to a sink in chunks as it is generated
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param sink sink to write XML to
+   * @param ebumode true (default) to generate EBU XML format, false to generate ITU XML format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level initial indentation level
+   *
+   * @return true if all XML was written to the sink successfully
+   *
+   * @note frame selects a Serial ADM frame to generate instead of the complete ADM
+   * @note for other XML implementaions, this function can be overridden
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GenerateXMLSink(const ADMData *adm, Sink& sink, bool ebumode, const std::string& indent, const std::string& eol, uint_t ind_level, bool complete = false, const FRAME *frame = NULL)
+  {
+    TEXTXML context;
+
+    context.adm       = adm;
+
+    // clear destination data
+    memset(&context.destination, 0, sizeof(context.destination));
+
+    // set sink destination to use
+    context.destination.sink = &sink;
+    context.chunk.reserve(SinkChunkSize);
+    context.failed    = false;
+
+    context.ebumode   = ebumode;
+    context.indent    = indent;
+    context.eol       = eol;
+    context.ind_level = ind_level;
+    context.length    = 0;
+    context.indentcount = 0;
+    context.depth     = 0;
+    context.opened    = false;
+    context.complete  = complete;
+    context.eollast   = false;
+    context.measure   = false;
+    context.frame     = frame;
+
+    ApplyCompactMode(context);
+
+    if (frame) GenerateFrameXML(context);
+    else       GenerateXML(context);
+
+    // write remaining XML
+    FlushXML(context);
+
+    return !context.failed;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Initialise context for measuring XML (no destination)
+   *
+   * @param xml context to initialise
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param ind_level initial indentation level
+   */
+  /*--------------------------------------------------------------------------------*/
+  void InitMeasureXML(TEXTXML& xml, const std::string& indent, const std::string& eol, uint_t ind_level)
+  {
+    xml.adm       = NULL;
+
+    // clear destination data (just count length)
+    memset(&xml.destination, 0, sizeof(xml.destination));
+
+    xml.failed    = false;
+    xml.ebumode   = true;
+    xml.indent    = indent;
+    xml.eol       = eol;
+    xml.ind_level = ind_level;
+    xml.length    = 0;
+    xml.indentcount = 0;
+    xml.depth     = 0;
+    xml.opened    = false;
+    xml.complete  = false;
+    xml.eollast   = false;
+    xml.measure   = true;
+    xml.compact   = 0;
+    xml.frame     = NULL;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return length of XML representation of ADM without generating it
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param ebumode true (default) to generate EBU XML format, false to generate ITU XML format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level initial indentation level
+   * @param complete dump ALL objects, not just programme, content or objects
+   *
+   * @return total length of XML
+   *
+   * @note for other XML implementaions, this function can be overridden
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint64_t GenerateXMLLength(const ADMData *adm, bool ebumode, const std::string& indent, const std::string& eol, uint_t ind_level, bool complete = false)
+  {
+    TEXTXML context;
+
+    InitMeasureXML(context, indent, eol, ind_level);
+
+    context.adm       = adm;
+    context.ebumode   = ebumode;
+    context.complete  = complete;
+
+    ApplyCompactMode(context);
+
+    GenerateXML(context);
+
+    return context.length;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if the length of XML with the specified formatting can be accounted for piecewise
+   *
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   *
+   * @note pieces are measured separately from their surroundings so end-of-line detection
+   * @note must not be affected by those surroundings, which is only guaranteed for whitespace
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool CanMeasureXML(const std::string& indent, const std::string& eol)
+  {
+    return ((indent.find_first_not_of(" \t\r\n") == std::string::npos) &&
+            (eol.find_first_not_of(" \t\r\n")    == std::string::npos));
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Generate XML of a single block format in the state following a completed object
+   *
+   * @param xml user supplied argument representing context data
+   * @param block block format
+   * @param id ID of block format or NULL to omit the ID attribute
+   */
+  /*--------------------------------------------------------------------------------*/
+  void GenerateBlockFormatXML(TEXTXML& xml, const ADMAudioBlockFormat *block, const std::string *id)
+  {
+    XMLValues attrs, values;
+
+    xml.eollast = (xml.eol.length() != 0);
+
+    if (id)
+    {
+      XMLValue value;
+      value.SetAttribute(block->GetType() + "ID", *id);
+      attrs.AddValue(value);
+    }
+
+    block->GetValues(attrs, values);
+
+    OpenXMLObject(xml, block->GetType());
+    AddXMLAttributes(xml, attrs);
+    AddXMLValues(xml, values);
+    CloseXMLObject(xml);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Measure XML of a block format without its ID attribute
+   *
+   * @param block block format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param length updated with length of XML at indentation level 0
+   * @param indents updated with number of indents within the XML
+   *
+   * @note the XML is measured in the state following a completed object
+   */
+  /*--------------------------------------------------------------------------------*/
+  void MeasureBlockFormatXML(const ADMAudioBlockFormat *block, const std::string& indent, const std::string& eol, uint_t& length, uint_t& indents)
+  {
+    TEXTXML context;
+
+    InitMeasureXML(context, indent, eol, 0);
+    GenerateBlockFormatXML(context, block, NULL);
+
+    length  = (uint_t)context.length;
+    indents = (uint_t)context.indentcount;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Append XML of a block format to a string
+   *
+   * @param str string to append XML to
+   * @param block block format
+   * @param id ID of block format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level indentation level of the block format
+   *
+   * @note the XML is generated in the state following a completed object
+   */
+  /*--------------------------------------------------------------------------------*/
+  void AppendBlockFormatXML(std::string& str, const ADMAudioBlockFormat *block, const std::string& id, const std::string& indent, const std::string& eol, uint_t level)
+  {
+    TEXTXML context;
+
+    InitMeasureXML(context, indent, eol, level);
+    context.destination.str = &str;
+    context.measure         = false;
+
+    GenerateBlockFormatXML(context, block, &id);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return length of XML attribute
+   *
+   * @param name attribute name
+   * @param value attribute value
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t GetXMLAttributeLength(const std::string& name, const std::string& value)
+  {
+    TEXTXML context;
+
+    InitMeasureXML(context, "", "", 0);
+
+    AddXMLAttribute(context, name, value);
+
+    return (uint_t)context.length;
+  }
+
   /*--------------------------------------------------------------------------------*/
   /** Create axml chunk data
    *
@@ -566,6 +1560,120 @@ namespace ADMXMLGenerator
   {
     return GenerateXMLBuffer(adm, buf, buflen, ebumode, indent, eol, ind_level);
   }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Create XML representation of ADM, writing it to a sink in chunks as it is generated
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param sink sink to write XML to
+   * @param ebumode true (default) to generate EBU XML format, false to generate ITU XML format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level initial indentation level
+   *
+   * @return true if all XML was written to the sink successfully
+   *
+   * @note memory use is constant regardless of the size of the XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool WriteAxml(const ADMData *adm, Sink& sink, bool ebumode, const std::string& indent, const std::string& eol, uint_t ind_level)
+  {
+    return GenerateXMLSink(adm, sink, ebumode, indent, eol, ind_level);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return exact length of XML representation of ADM without generating all of it
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param ebumode true (default) to generate EBU XML format, false to generate ITU XML format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level initial indentation level
+   *
+   * @return total length of XML (identical to the length of GetAxml())
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint64_t GetAxmlLength(const ADMData *adm, bool ebumode, const std::string& indent, const std::string& eol, uint_t ind_level)
+  {
+    return GenerateXMLLength(adm, ebumode, indent, eol, ind_level);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Create a self-contained Serial ADM frame document holding only the block formats active within the frame
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param frame frame description
+   * @param indent indent string to use within XML
+   * @param eol end of line string to use within XML
+   * @param ind_level initial indentation level
+   *
+   * @return string containing XML data of frame
+   */
+  /*--------------------------------------------------------------------------------*/
+  std::string GetFrame(const ADMData *adm, const FRAME& frame, const std::string& indent, const std::string& eol, uint_t ind_level)
+  {
+    std::string str;
+
+    GenerateXML(adm, str, false, indent, eol, ind_level, false, &frame);
+
+    return str;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Create a self-contained Serial ADM frame document holding only the block formats
+   * active within the frame, writing it to a sink in chunks as it is generated
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param frame frame description
+   * @param sink sink to write XML to
+   * @param indent indent string to use within XML
+   * @param eol end of line string to use within XML
+   * @param ind_level initial indentation level
+   *
+   * @return true if all XML was written to the sink successfully
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool WriteFrame(const ADMData *adm, const FRAME& frame, Sink& sink, const std::string& indent, const std::string& eol, uint_t ind_level)
+  {
+    return GenerateXMLSink(adm, sink, false, indent, eol, ind_level, false, &frame);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Write a chunk of XML to the file
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool FileSink::WriteData(const char *data, uint_t len)
+  {
+    return (file && (file->fwrite(data, 1, len) == len));
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Write a chunk of XML to the file descriptor
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool FDSink::WriteData(const char *data, uint_t len)
+  {
+    bool success = true;
+
+    while (success && len)
+    {
+      ssize_t n;
+
+      if ((n = ::write(fd, data, len)) > 0)
+      {
+        data += n;
+        len  -= (uint_t)n;
+      }
+      else if ((n < 0) && (errno == EINTR)) continue;
+      else
+      {
+        BBCERROR("Failed to write XML to file descriptor %d (%s)", fd, strerror(errno));
+        success = false;
+      }
+    }
+
+    return success;
+  }
 };
 
 BBC_AUDIOTOOLBOX_END
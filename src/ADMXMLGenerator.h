@@ -1,6 +1,10 @@
 #ifndef __ADM_XML_GENERATOR__
 #define __ADM_XML_GENERATOR__
 
+#include <map>
+
+#include <bbcat-base/EnhancedFile.h>
+
 #include "ADMData.h"
 
 BBC_AUDIOTOOLBOX_START
@@ -11,6 +15,155 @@ BBC_AUDIOTOOLBOX_START
 /*--------------------------------------------------------------------------------*/
 namespace ADMXMLGenerator
 {
+  /*--------------------------------------------------------------------------------*/
+  /** Destination for XML generated by WriteAxml()
+   *
+   * XML is supplied to the sink in chunks as it is generated so that the whole
+   * document need never be held in memory
+   */
+  /*--------------------------------------------------------------------------------*/
+  class Sink
+  {
+  public:
+    Sink() : length(0) {}
+    virtual ~Sink() {}
+
+    /*--------------------------------------------------------------------------------*/
+    /** Write a chunk of XML to the sink
+     *
+     * @param data XML data (NOT terminated)
+     * @param len length of data
+     *
+     * @return true if successful
+     */
+    /*--------------------------------------------------------------------------------*/
+    bool Write(const char *data, uint_t len) {length += len; return WriteData(data, len);}
+
+    /*--------------------------------------------------------------------------------*/
+    /** Return total number of bytes supplied to the sink
+     */
+    /*--------------------------------------------------------------------------------*/
+    uint64_t GetLength() const {return length;}
+
+  protected:
+    /*--------------------------------------------------------------------------------*/
+    /** Write a chunk of XML to the destination (provided by derived objects)
+     *
+     * @param data XML data (NOT terminated)
+     * @param len length of data
+     *
+     * @return true if successful
+     */
+    /*--------------------------------------------------------------------------------*/
+    virtual bool WriteData(const char *data, uint_t len) = 0;
+
+  protected:
+    uint64_t length;
+  };
+
+  /*--------------------------------------------------------------------------------*/
+  /** Sink writing XML to an (open) EnhancedFile
+   */
+  /*--------------------------------------------------------------------------------*/
+  class FileSink : public Sink
+  {
+  public:
+    FileSink(EnhancedFile *_file) : Sink(),
+                                    file(_file) {}
+    virtual ~FileSink() {}
+
+  protected:
+    virtual bool WriteData(const char *data, uint_t len);
+
+  protected:
+    EnhancedFile *file;
+  };
+
+  /*--------------------------------------------------------------------------------*/
+  /** Sink writing XML to an (open) file descriptor
+   */
+  /*--------------------------------------------------------------------------------*/
+  class FDSink : public Sink
+  {
+  public:
+    FDSink(int _fd) : Sink(),
+                      fd(_fd) {}
+    virtual ~FDSink() {}
+
+  protected:
+    virtual bool WriteData(const char *data, uint_t len);
+
+  protected:
+    int fd;
+  };
+
+  /*--------------------------------------------------------------------------------*/
+  /** Sink passing XML to a user callback
+   *
+   * The callback is called with each chunk of XML and the supplied context and
+   * returns false to abort generation
+   */
+  /*--------------------------------------------------------------------------------*/
+  class CallbackSink : public Sink
+  {
+  public:
+    CallbackSink(bool (*_fn)(const char *data, uint_t len, void *context), void *_context = NULL) : Sink(),
+                                                                                                  fn(_fn),
+                                                                                                  context(_context) {}
+    virtual ~CallbackSink() {}
+
+  protected:
+    virtual bool WriteData(const char *data, uint_t len) {return (*fn)(data, len, context);}
+
+  protected:
+    bool (*fn)(const char *data, uint_t len, void *context);
+    void *context;
+  };
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set number of threads used to generate audioChannelFormat XML
+   *
+   * @param n number of threads (including the calling thread), 1 disables parallel generation
+   *
+   * @note output is identical regardless of the number of threads
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern void SetGenerateThreads(uint_t n);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return number of threads used to generate audioChannelFormat XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern uint_t GetGenerateThreads();
+
+  // compact output options
+  enum {
+    Compact_Whitespace       = 0x01,    // no indentation or end-of-lines and no space before '/>'
+    Compact_SuppressDefaults = 0x02,    // omit audioBlockFormat elements equal to their ADM defaults
+    Compact_MergeBlocks      = 0x04,    // merge runs of contiguous, otherwise identical audioBlockFormats
+
+    Compact_All = Compact_Whitespace | Compact_SuppressDefaults | Compact_MergeBlocks,
+  };
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set compact output options for all subsequent XML generation
+   *
+   * @param flags combination of Compact_xxx flags (0, the default, for normal output)
+   *
+   * @note Compact_Whitespace overrides the indent and eol strings supplied to the generator
+   * @note merged audioBlockFormats are numbered consecutively so their IDs do not match
+   * @note those of the block formats held in memory
+   * @note compact output is always generated in full, cached XML and lengths are not used
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern void SetCompactMode(uint_t flags);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return compact output options
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern uint_t GetCompactMode();
+
   /*--------------------------------------------------------------------------------*/
   /** Create axml chunk data
    *
@@ -40,6 +193,128 @@ namespace ADMXMLGenerator
    */
   /*--------------------------------------------------------------------------------*/
   extern uint64_t GetAxmlBuffer(const ADMData *adm, uint8_t *buf, uint64_t buflen, bool ebumode = true, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Create XML representation of ADM, writing it to a sink in chunks as it is generated
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param sink sink to write XML to
+   * @param ebumode true (default) to generate EBU XML format, false to generate ITU XML format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level initial indentation level
+   *
+   * @return true if all XML was written to the sink successfully
+   *
+   * @note memory use is constant regardless of the size of the XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern bool WriteAxml(const ADMData *adm, Sink& sink, bool ebumode = true, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return exact length of XML representation of ADM without generating all of it
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param ebumode true (default) to generate EBU XML format, false to generate ITU XML format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level initial indentation level
+   *
+   * @return total length of XML (identical to the length of GetAxml())
+   *
+   * @note audioBlockFormat lengths are maintained by their channel formats so after the
+   * @note first call only block formats added or modified since are measured
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern uint64_t GetAxmlLength(const ADMData *adm, bool ebumode = true, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Serial ADM (ITU-R BS.2125) frame
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct {
+    uint64_t    start;                  ///< start time of frame (ns)
+    uint64_t    duration;               ///< duration of frame (ns)
+    uint_t      index;                  ///< frame number (from 1), used for the frameFormatID
+    std::string flowid;                 ///< flowID of frames (or empty)
+    std::map<const ADMAudioChannelFormat *, uint64_t> offsets;  ///< start times (ns) of the objects of channel formats whose block format times are relative to them
+  } FRAME;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Create a self-contained Serial ADM frame document holding only the block formats active within the frame
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param frame frame description
+   * @param indent indent string to use within XML
+   * @param eol end of line string to use within XML
+   * @param ind_level initial indentation level
+   *
+   * @return string containing XML data of frame
+   *
+   * @note block formats are output whole (with their own IDs) in every frame they overlap
+   * @note and block formats yet to be ended are output lasting until the end of the frame
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern std::string GetFrame(const ADMData *adm, const FRAME& frame, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Create a self-contained Serial ADM frame document holding only the block formats
+   * active within the frame, writing it to a sink in chunks as it is generated
+   *
+   * @param adm ADMData structure holding description of ADM
+   * @param frame frame description
+   * @param sink sink to write XML to
+   * @param indent indent string to use within XML
+   * @param eol end of line string to use within XML
+   * @param ind_level initial indentation level
+   *
+   * @return true if all XML was written to the sink successfully
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern bool WriteFrame(const ADMData *adm, const FRAME& frame, Sink& sink, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if the length of XML with the specified formatting can be accounted for piecewise
+   *
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern bool CanMeasureXML(const std::string& indent, const std::string& eol);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Measure XML of a block format without its ID attribute
+   *
+   * @param block block format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param length updated with length of XML at indentation level 0
+   * @param indents updated with number of indents within the XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern void MeasureBlockFormatXML(const ADMAudioBlockFormat *block, const std::string& indent, const std::string& eol, uint_t& length, uint_t& indents);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Append XML of a block format to a string
+   *
+   * @param str string to append XML to
+   * @param block block format
+   * @param id ID of block format
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param level indentation level of the block format
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern void AppendBlockFormatXML(std::string& str, const ADMAudioBlockFormat *block, const std::string& id, const std::string& indent, const std::string& eol, uint_t level);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return length of XML attribute
+   *
+   * @param name attribute name
+   * @param value attribute value
+   */
+  /*--------------------------------------------------------------------------------*/
+  extern uint_t GetXMLAttributeLength(const std::string& name, const std::string& value);
 };
 
 BBC_AUDIOTOOLBOX_END
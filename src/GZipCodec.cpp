@@ -0,0 +1,198 @@
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <zlib.h>
+
+#define BBCDEBUG_LEVEL 1
+#include "GZipCodec.h"
+
+BBC_AUDIOTOOLBOX_START
+
+/*--------------------------------------------------------------------------------*/
+/** Constructor
+ *
+ * @param level compression level (0 = none, 1 = fastest .. 9 = best)
+ */
+/*--------------------------------------------------------------------------------*/
+GZipCompressor::GZipCompressor(int level) : stream(new z_stream),
+                                            valid(false),
+                                            ended(false)
+{
+  memset(stream, 0, sizeof(*stream));
+
+  // windowBits of 15 + 16 selects gzip format
+  if (deflateInit2(stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK) valid = true;
+  else BBCERROR("Failed to initialise gzip compressor");
+}
+
+GZipCompressor::~GZipCompressor()
+{
+  if (valid) deflateEnd(stream);
+  delete stream;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Compress data
+ *
+ * @param data data to compress
+ * @param len length of data
+ *
+ * @return true if successful
+ */
+/*--------------------------------------------------------------------------------*/
+bool GZipCompressor::Add(const void *data, uint64_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  bool success = (valid && !ended);
+
+  // zlib lengths are limited to 32 bits so feed data in pieces
+  while (success && len)
+  {
+    uInt n = (uInt)std::min(len, (uint64_t)0x40000000);
+
+    stream->next_in  = (Bytef *)p;
+    stream->avail_in = n;
+
+    success = Compress(Z_NO_FLUSH);
+
+    p   += n;
+    len -= n;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Complete compressed data
+ *
+ * @return true if successful
+ *
+ * @note no further data can be added
+ */
+/*--------------------------------------------------------------------------------*/
+bool GZipCompressor::End()
+{
+  bool success = (valid && !ended);
+
+  if (success)
+  {
+    stream->next_in  = NULL;
+    stream->avail_in = 0;
+
+    success = Compress(Z_FINISH);
+    ended   = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Compress input, appending to data
+ *
+ * @param flush zlib flush mode
+ *
+ * @return true if successful
+ */
+/*--------------------------------------------------------------------------------*/
+bool GZipCompressor::Compress(int flush)
+{
+  bool success = true, finished = false;
+
+  // keep going until all input is consumed and (when finishing) the stream is complete
+  while (success && !finished)
+  {
+    size_t pos = data.size();
+    int    res;
+
+    // always allow at least 64k of output space
+    data.resize(pos + std::max((size_t)65536, (size_t)deflateBound(stream, stream->avail_in)));
+
+    stream->next_out  = &data[pos];
+    stream->avail_out = (uInt)(data.size() - pos);
+
+    res = deflate(stream, flush);
+
+    data.resize(data.size() - stream->avail_out);
+
+    if      (res == Z_STREAM_END) finished = true;
+    else if ((res == Z_OK) || (res == Z_BUF_ERROR)) finished = ((flush != Z_FINISH) && !stream->avail_in);
+    else
+    {
+      BBCERROR("gzip compression failed (%d)", res);
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Constructor
+ *
+ * @param data compressed data (MUST remain valid whilst data is read)
+ * @param len length of compressed data
+ */
+/*--------------------------------------------------------------------------------*/
+GZipDecompressor::GZipDecompressor(const uint8_t *data, uint64_t len) : stream(new z_stream),
+                                                                        valid(false),
+                                                                        complete(false),
+                                                                        failed(false)
+{
+  memset(stream, 0, sizeof(*stream));
+
+  if (len > (uint64_t)0xffffffff) BBCERROR("Compressed data too large (%s bytes)", StringFrom(len).c_str());
+  // windowBits of 15 + 32 automatically detects gzip or zlib format
+  else if (inflateInit2(stream, 15 + 32) == Z_OK)
+  {
+    stream->next_in  = (Bytef *)data;
+    stream->avail_in = (uInt)len;
+    valid = true;
+  }
+  else BBCERROR("Failed to initialise gzip decompressor");
+}
+
+GZipDecompressor::~GZipDecompressor()
+{
+  if (valid) inflateEnd(stream);
+  delete stream;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read decompressed data
+ *
+ * @param buf buffer to receive data
+ * @param len maximum number of bytes to read
+ *
+ * @return number of bytes read, 0 at end of data or on error (see IsComplete())
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t GZipDecompressor::Read(void *buf, uint_t len)
+{
+  uint_t n = 0;
+
+  if (valid && !complete && !failed && len)
+  {
+    int res;
+
+    stream->next_out  = (Bytef *)buf;
+    stream->avail_out = len;
+
+    res = inflate(stream, Z_NO_FLUSH);
+
+    n = len - stream->avail_out;
+
+    if (res == Z_STREAM_END) complete = true;
+    else if ((res != Z_OK) || (!n && !stream->avail_in))
+    {
+      // error or compressed data truncated
+      BBCERROR("gzip decompression failed (%d)", res);
+      failed = true;
+    }
+  }
+
+  return n;
+}
+
+BBC_AUDIOTOOLBOX_END
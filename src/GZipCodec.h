@@ -0,0 +1,125 @@
+#ifndef __GZIP_CODEC__
+#define __GZIP_CODEC__
+
+#include <vector>
+
+#include <bbcat-base/misc.h>
+
+struct z_stream_s;
+
+BBC_AUDIOTOOLBOX_START
+
+/*--------------------------------------------------------------------------------*/
+/** Streaming gzip compressor
+ *
+ * Data is supplied in any number of pieces and compressed as it is supplied, the
+ * compressed data being appended to an internal buffer
+ */
+/*--------------------------------------------------------------------------------*/
+class GZipCompressor
+{
+public:
+  /*--------------------------------------------------------------------------------*/
+  /** Constructor
+   *
+   * @param level compression level (0 = none, 1 = fastest .. 9 = best)
+   */
+  /*--------------------------------------------------------------------------------*/
+  GZipCompressor(int level = 6);
+  ~GZipCompressor();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Compress data
+   *
+   * @param data data to compress
+   * @param len length of data
+   *
+   * @return true if successful
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool Add(const void *data, uint64_t len);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Complete compressed data
+   *
+   * @return true if successful
+   *
+   * @note no further data can be added
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool End();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return compressed data
+   *
+   * @note the non-const version allows the data to be swapped out
+   */
+  /*--------------------------------------------------------------------------------*/
+  const std::vector<uint8_t>& GetData() const {return data;}
+  std::vector<uint8_t>& GetData() {return data;}
+
+protected:
+  /*--------------------------------------------------------------------------------*/
+  /** Compress input, appending to data
+   *
+   * @param flush zlib flush mode
+   *
+   * @return true if successful
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool Compress(int flush);
+
+protected:
+  struct z_stream_s    *stream;
+  std::vector<uint8_t> data;
+  bool                 valid;
+  bool                 ended;
+};
+
+/*--------------------------------------------------------------------------------*/
+/** Streaming gzip (or zlib) decompressor
+ *
+ * The compressed data is supplied in one go but decompressed on demand through Read()
+ * so that the whole decompressed data need never be held in memory
+ */
+/*--------------------------------------------------------------------------------*/
+class GZipDecompressor
+{
+public:
+  /*--------------------------------------------------------------------------------*/
+  /** Constructor
+   *
+   * @param data compressed data (MUST remain valid whilst data is read)
+   * @param len length of compressed data
+   */
+  /*--------------------------------------------------------------------------------*/
+  GZipDecompressor(const uint8_t *data, uint64_t len);
+  ~GZipDecompressor();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read decompressed data
+   *
+   * @param buf buffer to receive data
+   * @param len maximum number of bytes to read
+   *
+   * @return number of bytes read, 0 at end of data or on error (see IsComplete())
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t Read(void *buf, uint_t len);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if all compressed data has been decompressed successfully
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool IsComplete() const {return complete;}
+
+protected:
+  struct z_stream_s *stream;
+  bool              valid;
+  bool              complete;
+  bool              failed;
+};
+
+BBC_AUDIOTOOLBOX_END
+
+#endif
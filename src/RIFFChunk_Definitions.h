@@ -139,22 +139,40 @@ enum
 #define data_ID IFFID("data")
 
 #define chna_ID IFFID("chna")
+typedef PACKEDSTRUCT
+{
+  uint16_t TrackNum;
+  char     UID[12];
+  char     TrackRef[14];
+  char     PackRef[11];
+  uint8_t  _pad;
+} CHNA_UID;
+
 typedef PACKEDSTRUCT
 {
   uint16_t   TrackCount;
   uint16_t   UIDCount;
-  PACKEDSTRUCT
-  {
-    uint16_t TrackNum;
-    char     UID[12];
-    char     TrackRef[14];
-    char     PackRef[11];
-    uint8_t  _pad;
-  } UIDs[0];
+  CHNA_UID   UIDs[0];
 } CHNA_CHUNK;
 
 #define axml_ID IFFID("axml")
 
+// bxml chunk (ITU-R BS.2088) - gzip compressed axml
+#define bxml_ID IFFID("bxml")
+typedef PACKEDSTRUCT
+{
+  uint16_t   Version;
+  uint8_t    Data[0];
+} BXML_CHUNK;
+
+enum
+{
+  BXML_VERSION = 1,
+};
+
+// private chunk holding binary form of ADM (see ADMData::GetBinary())
+#define badm_ID IFFID("badm")
+
 #define JUNK_ID IFFID("JUNK")
 
 BBC_AUDIOTOOLBOX_END
@@ -2,6 +2,8 @@
 #include <string.h>
 #include <errno.h>
 
+#include <algorithm>
+
 #define BBCDEBUG_LEVEL 1
 #include <bbcat-base/ByteSwap.h>
 
@@ -757,7 +759,8 @@ void RIFFchnaChunk::ByteSwapData(bool writing)
 
 /*----------------------------------------------------------------------------------------------------*/
 
-RIFFaxmlChunk::RIFFaxmlChunk(uint32_t chunk_id) : RIFFChunk(chunk_id)
+RIFFaxmlChunk::RIFFaxmlChunk(uint32_t chunk_id) : RIFFChunk(chunk_id),
+                                                   xmlsource(NULL)
 {
   // include an extra byte when allocating/reading data for string terminator
   extrabytes = 1;
@@ -775,6 +778,100 @@ void RIFFaxmlChunk::Register()
   RIFFChunk::RegisterProvider("axml", &Create);
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Generate the chunk data from an ADM as the chunk is written rather than holding it in memory
+ *
+ * @param adm ADM to generate XML from (MUST remain valid and unchanged until the chunk is written)
+ * @param len expected length of the XML (e.g. from ADMXMLGenerator::Sink::GetLength() or XMLADMData::GetAxmlLength())
+ *
+ * @note any existing chunk data is deleted
+ * @note if the XML turns out to be a different length, all of it is still written and the
+ * @note chunk length updated, RIFFFile::Close() then re-writes the chunks with the correct sizes
+ */
+/*--------------------------------------------------------------------------------*/
+void RIFFaxmlChunk::SetXMLSource(const XMLADMData *adm, uint64_t len)
+{
+  DeleteData();
+
+  xmlsource = adm;
+  length    = len;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write chunk data, generating it from the XML source if set
+ *
+ * @return true if chunk successfully written
+ */
+/*--------------------------------------------------------------------------------*/
+bool RIFFaxmlChunk::WriteChunkData(EnhancedFile *file)
+{
+  bool success;
+
+  if (xmlsource && !data)
+  {
+    ChunkSink sink(file);
+
+    // the XML is never truncated or padded, the chunk length is corrected instead
+    if ((success = xmlsource->WriteAxml(sink)) && (sink.GetLength() != length))
+    {
+      BBCDEBUG1(("Generated axml data is a different size to that expected (%s vs %s), chunk length updated", StringFrom(sink.GetLength()).c_str(), StringFrom(length).c_str()));
+      length = sink.GetLength();
+    }
+  }
+  else success = RIFFChunk::WriteChunkData(file);
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Write XML to file
+ */
+/*--------------------------------------------------------------------------------*/
+bool RIFFaxmlChunk::ChunkSink::WriteData(const char *data, uint_t len)
+{
+  return (!len || (file->fwrite(data, 1, len) == len));
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------------*/
+/** bxml chunk - gzip compressed alternative to the axml chunk (ITU-R BS.2088)
+ *
+ * The chunk data is read, byte swapped but not processed (it is handled by the parent)
+ *
+ */
+/*--------------------------------------------------------------------------------*/
+void RIFFbxmlChunk::Register()
+{
+  RIFFChunk::RegisterProvider("bxml", &Create);
+}
+
+void RIFFbxmlChunk::ByteSwapData(bool writing)
+{
+  UNUSED_PARAMETER(writing);
+
+  if (SwapLittleEndian() && data && (length >= sizeof(BXML_CHUNK)))
+  {
+    BXML_CHUNK& chunk = *(BXML_CHUNK *)data;
+
+    BYTESWAP_VAR(chunk.Version);
+  }
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------------------*/
+/** badm chunk - private chunk holding the ADM in binary form (see ADMData::GetBinary())
+ *
+ * The chunk data is read, not byte swapped and not processed (it is handled by the parent)
+ *
+ */
+/*--------------------------------------------------------------------------------*/
+void RIFFbadmChunk::Register()
+{
+  RIFFChunk::RegisterProvider("badm", &Create);
+}
+
 /*----------------------------------------------------------------------------------------------------*/
 
 RIFFdataChunk::~RIFFdataChunk()
@@ -853,6 +950,8 @@ void RegisterRIFFChunkProviders()
   RIFFbextChunk::Register();
   RIFFchnaChunk::Register();
   RIFFaxmlChunk::Register();
+  RIFFbxmlChunk::Register();
+  RIFFbadmChunk::Register();
   RIFFdataChunk::Register();
 }
 
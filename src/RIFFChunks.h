@@ -6,6 +6,7 @@
 
 #include "RIFFChunk.h"
 #include "SoundFileAttributes.h"
+#include "XMLADMData.h"
 
 BBC_AUDIOTOOLBOX_START
 
@@ -313,6 +314,19 @@ public:
   // this chunk is written *after* data chunk
   virtual bool WriteChunkBeforeSamples() const {return false;}
 
+  /*--------------------------------------------------------------------------------*/
+  /** Generate the chunk data from an ADM as the chunk is written rather than holding it in memory
+   *
+   * @param adm ADM to generate XML from (MUST remain valid and unchanged until the chunk is written)
+   * @param len expected length of the XML (e.g. from ADMXMLGenerator::Sink::GetLength() or XMLADMData::GetAxmlLength())
+   *
+   * @note any existing chunk data is deleted
+   * @note if the XML turns out to be a different length, all of it is still written and the
+   * @note chunk length updated, RIFFFile::Close() then re-writes the chunks with the correct sizes
+   */
+  /*--------------------------------------------------------------------------------*/
+  void SetXMLSource(const XMLADMData *adm, uint64_t len);
+
   // provider function register for this object
   static void Register();
 
@@ -324,6 +338,101 @@ protected:
     return new RIFFaxmlChunk(id);
   }
 
+  /*--------------------------------------------------------------------------------*/
+  /** Write chunk data, generating it from the XML source if set
+   *
+   * @return true if chunk successfully written
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool WriteChunkData(EnhancedFile *file);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Sink writing XML to file
+   */
+  /*--------------------------------------------------------------------------------*/
+  class ChunkSink : public ADMXMLGenerator::Sink
+  {
+  public:
+    ChunkSink(EnhancedFile *_file) : ADMXMLGenerator::Sink(),
+                                     file(_file) {}
+    virtual ~ChunkSink() {}
+
+  protected:
+    virtual bool WriteData(const char *data, uint_t len);
+
+  protected:
+    EnhancedFile *file;
+  };
+
+protected:
+  // data should be read
+  virtual ChunkHandling_t GetChunkHandling() const {return ChunkHandling_ReadChunk;}
+
+protected:
+  const XMLADMData *xmlsource;
+};
+
+/*--------------------------------------------------------------------------------*/
+/** bxml chunk - gzip compressed alternative to the axml chunk (ITU-R BS.2088)
+ *
+ * The chunk data is read, byte swapped but not processed (it is handled by the parent)
+ *
+ */
+/*--------------------------------------------------------------------------------*/
+class RIFFbxmlChunk : public RIFFChunk
+{
+public:
+  RIFFbxmlChunk(uint32_t chunk_id) : RIFFChunk(chunk_id) {}
+  virtual ~RIFFbxmlChunk() {}
+
+  // this chunk is written *after* data chunk
+  virtual bool WriteChunkBeforeSamples() const {return false;}
+
+  // provider function register for this object
+  static void Register();
+
+protected:
+  // provider function for this object
+  static RIFFChunk *Create(uint32_t id, void *context)
+  {
+    (void)context;
+    return new RIFFbxmlChunk(id);
+  }
+
+protected:
+  // byte swapping required
+  virtual void ByteSwapData(bool writing);
+  // data should be read
+  virtual ChunkHandling_t GetChunkHandling() const {return ChunkHandling_ReadChunk;}
+};
+
+/*--------------------------------------------------------------------------------*/
+/** badm chunk - private chunk holding the ADM in binary form (see ADMData::GetBinary())
+ *
+ * The chunk data is read, not byte swapped and not processed (it is handled by the parent)
+ *
+ */
+/*--------------------------------------------------------------------------------*/
+class RIFFbadmChunk : public RIFFChunk
+{
+public:
+  RIFFbadmChunk(uint32_t chunk_id) : RIFFChunk(chunk_id) {}
+  virtual ~RIFFbadmChunk() {}
+
+  // this chunk is written *after* data chunk
+  virtual bool WriteChunkBeforeSamples() const {return false;}
+
+  // provider function register for this object
+  static void Register();
+
+protected:
+  // provider function for this object
+  static RIFFChunk *Create(uint32_t id, void *context)
+  {
+    (void)context;
+    return new RIFFbadmChunk(id);
+  }
+
 protected:
   // data should be read
   virtual ChunkHandling_t GetChunkHandling() const {return ChunkHandling_ReadChunk;}
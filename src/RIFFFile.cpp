@@ -310,70 +310,93 @@ void RIFFFile::Close(bool abortwrite)
       RIFFds64Chunk  *ds64  = dynamic_cast<RIFFds64Chunk *>(GetChunk(ds64_ID));
       RIFFChunk      *chunk;
       const uint64_t maxsize = RIFFChunk::RIFF_MaxSize; // max size of chunks and file before switching to RF64
+      std::vector<uint64_t> lengths;
+      uint_t         pass;
+      bool           rewrite = true;
 
       BBCDEBUG1(("Closing file '%s'...", file->getfilename().c_str()));
 
-      // now total up all the bytes for each chunk
-      uint64_t totalbytes = 0;
-      for (i = 0; i < chunklist.size(); i++)
+      // chunks generated as they are written (e.g. axml) may turn out to be a different length
+      // to that expected, in which case the sizes are recalculated and the chunks written again
+      for (pass = 0; rewrite && (pass < 2); pass++)
       {
-        uint64_t bytes;
+        // now total up all the bytes for each chunk
+        uint64_t totalbytes = 0;
+        lengths.resize(chunklist.size());
+        for (i = 0; i < chunklist.size(); i++)
+        {
+          uint64_t bytes;
 
-        chunk = chunklist[i];
+          chunk = chunklist[i];
 
-        // update data chunk size
-        if (chunk->GetID() == data_ID) chunk->CreateWriteData();
+          // update data chunk size
+          if (chunk->GetID() == data_ID) chunk->CreateWriteData();
 
-        // ignore RIFF ID since the RIFF size refers to the rest of the content
-        if (chunk->GetID() != RIFF_ID)
-        {
-          bytes = chunk->GetLengthOnFile();
+          // ignore RIFF ID since the RIFF size refers to the rest of the content
+          if (chunk->GetID() != RIFF_ID)
+          {
+            bytes = chunk->GetLengthOnFile();
 
-          BBCDEBUG3(("Chunk '%s' has length %s bytes", chunk->GetName(), StringFrom(bytes).c_str()));
-          totalbytes += bytes;
-        }
+            BBCDEBUG3(("Chunk '%s' has length %s bytes", chunk->GetName(), StringFrom(bytes).c_str()));
+            totalbytes += bytes;
+          }
 
-        // check whether chunk length (NOT length on file) is too big
-        // and needs an entry in the ds64 chunk
-        // (obviously if *any* chunk exceeds the maximum size, the file will as well)
-        if (((bytes = chunk->GetLength()) >= maxsize) ||
-            (ds64 && ((chunk->GetID() == RIFF_ID) ||  // RIFF and data chunks should *always* be in the ds64, if it exists
-                      (chunk->GetID() == data_ID))))
-        {
-          BBCDEBUG3(("Chunk '%s' needs to be in ds64 chunk", chunk->GetName()));
-          if (ds64)
+          // check whether chunk length (NOT length on file) is too big
+          // and needs an entry in the ds64 chunk
+          // (obviously if *any* chunk exceeds the maximum size, the file will as well)
+          if (((bytes = chunk->GetLength()) >= maxsize) ||
+              (ds64 && ((chunk->GetID() == RIFF_ID) ||  // RIFF and data chunks should *always* be in the ds64, if it exists
+                        (chunk->GetID() == data_ID))))
           {
-            if (!ds64->SetChunkSize(chunk->GetID(), bytes)) BBCERROR("Failed to set chunk size for '%s' in ds64 chunk", chunk->GetName());
-
-            // set the sample count from the size of the data chunk
-            if (chunk->GetID() == data_ID)
+            BBCDEBUG3(("Chunk '%s' needs to be in ds64 chunk", chunk->GetName()));
+            if (ds64)
             {
-              ds64->SetSampleCount(bytes / fileformat->GetBytesPerFrame());
+              if (!ds64->SetChunkSize(chunk->GetID(), bytes)) BBCERROR("Failed to set chunk size for '%s' in ds64 chunk", chunk->GetName());
+
+              // set the sample count from the size of the data chunk
+              if (chunk->GetID() == data_ID)
+              {
+                ds64->SetSampleCount(bytes / fileformat->GetBytesPerFrame());
+              }
             }
+            else BBCERROR("ds64 chunk needed but doesn't exist");
           }
-          else BBCERROR("ds64 chunk needed but doesn't exist");
         }
-      }
 
-      // test whether RIFF64 file is needed
-      if (totalbytes >= maxsize)
-      {
-        BBCDEBUG1(("Switching file to RF64 type"));
+        // test whether RIFF64 file is needed
+        if (totalbytes >= maxsize)
+        {
+          BBCDEBUG1(("Switching file to RF64 type"));
+
+          // tell each chunk (that's interested) that the file is going to be a RIFF64
+          for (i = 0; i < chunklist.size(); i++)
+          {
+            chunklist[i]->EnableRIFF64();
+          }
+        }
+
+        BBCDEBUG3(("Total size %s bytes", StringFrom(totalbytes).c_str()));
+
+        // set total length of RIFF chunk
+        chunkmap[RIFF_ID]->CreateChunkData(NULL, totalbytes);
 
-        // tell each chunk (that's interested) that the file is going to be a RIFF64
+        // write/re-write all chunks
+        for (i = 0; i < chunklist.size(); i++) lengths[i] = chunklist[i]->GetLength();
+
+        WriteChunks(true);
+
+        rewrite = false;
         for (i = 0; i < chunklist.size(); i++)
         {
-          chunklist[i]->EnableRIFF64();
+          if (chunklist[i]->GetLength() != lengths[i])
+          {
+            BBCDEBUG1(("Chunk '%s' was written with a different length (%s bytes, expected %s bytes), re-writing chunks", chunklist[i]->GetName(), StringFrom(chunklist[i]->GetLength()).c_str(), StringFrom(lengths[i]).c_str()));
+            rewrite = true;
+          }
         }
       }
 
-      BBCDEBUG3(("Total size %s bytes", StringFrom(totalbytes).c_str()));
-
-      // set total length of RIFF chunk
-      chunkmap[RIFF_ID]->CreateChunkData(NULL, totalbytes);
-
-      // write/re-write all chunks
-      WriteChunks(true);
+      if (rewrite) BBCERROR("Chunk lengths of '%s' changed whilst writing, file is invalid", file->getfilename().c_str());
 
       BBCDEBUG1(("Closed file '%s'", file->getfilename().c_str()));
     }
@@ -552,4 +575,26 @@ RIFFChunk *RIFFFile::GetChunk(uint32_t id) const
   return ((it = chunkmap.find(id)) != chunkmap.end()) ? it->second : NULL;
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Write sample frames
+ *
+ * @param buffer source buffer
+ * @param type desired sample buffer format
+ * @param nframes number of sample frames to write
+ *
+ * @note all channels must be written
+ *
+ * @return number of frames written or -1 for an error (no open file for example)
+ */
+/*--------------------------------------------------------------------------------*/
+sint_t RIFFFile::WriteSamples(const uint8_t *buffer, SampleFormat_t type, uint_t srcchannel, uint_t nsrcchannels, uint_t nsrcframes)
+{
+  sint_t n = filesamples ? (sint_t)filesamples->WriteSamples((const uint8_t *)buffer, type, srcchannel, nsrcchannels, nsrcframes) : -1;
+
+  // writing moves the sample position on
+  if (n > 0) UpdateSamplePosition();
+
+  return n;
+}
+
 BBC_AUDIOTOOLBOX_END
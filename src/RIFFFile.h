@@ -287,7 +287,7 @@ public:
    * @return number of frames written or -1 for an error (no open file for example)
    */
   /*--------------------------------------------------------------------------------*/
-  sint_t WriteSamples(const uint8_t *buffer, SampleFormat_t type, uint_t srcchannel, uint_t nsrcchannels, uint_t nsrcframes = 1) {return filesamples ? filesamples->WriteSamples((const uint8_t *)buffer, type, srcchannel, nsrcchannels, nsrcframes) : -1;}
+  sint_t WriteSamples(const uint8_t *buffer, SampleFormat_t type, uint_t srcchannel, uint_t nsrcchannels, uint_t nsrcframes = 1);
   sint_t WriteSamples(const int16_t *buffer, uint_t srcchannel, uint_t nsrcchannels, uint_t nsrcframes = 1) {return WriteSamples((const uint8_t *)buffer, SampleFormatOf(buffer), srcchannel, nsrcchannels, nsrcframes);}
   sint_t WriteSamples(const int32_t *buffer, uint_t srcchannel, uint_t nsrcchannels, uint_t nsrcframes = 1) {return WriteSamples((const uint8_t *)buffer, SampleFormatOf(buffer), srcchannel, nsrcchannels, nsrcframes);}
   sint_t WriteSamples(const float   *buffer, uint_t srcchannel, uint_t nsrcchannels, uint_t nsrcframes = 1) {return WriteSamples((const uint8_t *)buffer, SampleFormatOf(buffer), srcchannel, nsrcchannels, nsrcframes);}
@@ -0,0 +1,1426 @@
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+
+#include <bbcat-base/Thread.h>
+
+#define BBCDEBUG_LEVEL 1
+#include "SAXADMData.h"
+
+BBC_AUDIOTOOLBOX_START
+
+BBC_AUDIOTOOLBOX_KEEP(SAXADMData);
+
+uint_t      SAXADMData::parsethreads     = 1;
+bool        SAXADMData::lazyblockformats = false;
+uint64_t    SAXADMData::memorybudget     = 0;
+std::string SAXADMData::spilldirectory;
+
+SAXADMData::SAXADMData(const std::string& standarddefinitionsfile) : XMLADMData(),
+                                                                     streamstarted(false),
+                                                                     formatfound(false)
+{
+  LoadStandardDefinitions(standarddefinitionsfile);
+}
+
+SAXADMData::SAXADMData() : XMLADMData(),
+                           streamstarted(false),
+                           formatfound(false)
+{
+}
+
+SAXADMData::~SAXADMData()
+{
+  // delete anything left from XML supplied in pieces
+  ResetAxml();
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Make XMLADMData::CreateADM() (and therefore ADMRIFFFile) use this provider
+ *
+ * @note this is NOT called automatically, TinyXMLADMData remains the default provider
+ * @note unless an application opts in by calling this
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::Register()
+{
+  static bool registered = false;
+  if (!registered) {
+    RegisterProvider(&__Creator, NULL, true);
+    registered = true;
+  }
+
+  return registered;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Set number of threads used to parse audioChannelFormat sections (1 = no parallel parsing)
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::SetParseThreads(uint_t n)
+{
+  parsethreads = std::max(n, (uint_t)1);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Skip whitespace
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::SkipWhiteSpace(const char *& p)
+{
+  while ((p[0] == ' ') || (p[0] == '\t') || (p[0] == '\r') || (p[0] == '\n')) p++;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return true if c can be part of an XML name
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::IsNameChar(char c)
+{
+  return (c &&
+          (c != ' ') && (c != '\t') && (c != '\r') && (c != '\n') &&
+          (c != '/') && (c != '>')  && (c != '='));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read XML name from p, updating p
+ */
+/*--------------------------------------------------------------------------------*/
+std::string SAXADMData::ReadName(const char *& p)
+{
+  const char *p1 = p;
+
+  while (IsNameChar(p[0])) p++;
+
+  return std::string(p1, p - p1);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Decode XML entities in string
+ */
+/*--------------------------------------------------------------------------------*/
+std::string SAXADMData::DecodeEntities(const char *str, uint_t len)
+{
+  static const struct {
+    const char *entity;
+    char       c;
+  } entities[] = {
+    {"&amp;",  '&'},
+    {"&lt;",   '<'},
+    {"&gt;",   '>'},
+    {"&quot;", '\"'},
+    {"&apos;", '\''},
+  };
+  std::string res;
+  uint_t i, j;
+
+  // fast path: no entities
+  if (!memchr(str, '&', len)) return std::string(str, len);
+
+  res.reserve(len);
+
+  for (i = 0; i < len;)
+  {
+    if (str[i] == '&')
+    {
+      bool found = false;
+
+      if (((i + 2) < len) && (str[i + 1] == '#'))
+      {
+        // numeric character reference
+        const char *p = str + i + 2;
+        char       *endp;
+        ulong_t    c;
+
+        if ((p[0] == 'x') || (p[0] == 'X')) c = strtoul(p + 1, &endp, 16);
+        else                                c = strtoul(p, &endp, 10);
+
+        if ((endp[0] == ';') && ((uint_t)(endp - str) < len))
+        {
+          // encode as UTF-8
+          if      (c < 0x80)    res += (char)c;
+          else if (c < 0x800)   {res += (char)(0xc0 | (c >> 6));  res += (char)(0x80 | (c & 0x3f));}
+          else if (c < 0x10000) {res += (char)(0xe0 | (c >> 12)); res += (char)(0x80 | ((c >> 6) & 0x3f)); res += (char)(0x80 | (c & 0x3f));}
+          else                  {res += (char)(0xf0 | (c >> 18)); res += (char)(0x80 | ((c >> 12) & 0x3f)); res += (char)(0x80 | ((c >> 6) & 0x3f)); res += (char)(0x80 | (c & 0x3f));}
+
+          i     = (uint_t)(endp - str) + 1;
+          found = true;
+        }
+      }
+      else
+      {
+        for (j = 0; j < NUMBEROF(entities); j++)
+        {
+          uint_t l = (uint_t)strlen(entities[j].entity);
+
+          if (((i + l) <= len) && (strncmp(str + i, entities[j].entity, l) == 0))
+          {
+            res   += entities[j].c;
+            i     += l;
+            found  = true;
+            break;
+          }
+        }
+      }
+
+      // unknown entity: pass through unchanged
+      if (!found) res += str[i++];
+    }
+    else res += str[i++];
+  }
+
+  return res;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Decode XML string as ADM
+ *
+ * @param data ptr to string containing ADM XML (MUST be terminated)
+ *
+ * @return true if XML decoded correctly
+ *
+ * @note the XML is parsed in a single pass, objects being created as elements are
+ * @note opened and completed as they are closed
+ *
+ * @note if more than one parse thread is set (see SetParseThreads()), the contents of
+ * @note audioChannelFormat elements are skipped during the main pass and then parsed
+ * @note on a pool of threads, the results being merged into the channels (in document
+ * @note order) once all threads have finished
+ *
+ * @note if a memory budget is set (see SetMemoryBudget()), the XML is parsed serially
+ * @note and block formats decoded immediately
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::TranslateXML(const char *data)
+{
+  return DecodeXML(data, RefCount<std::string>());
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Decode XML held in a shared buffer as ADM
+ *
+ * @param data buffer holding ADM XML
+ *
+ * @return true if XML decoded correctly
+ *
+ * @note when decoding block formats lazily, channel formats keep a reference to the
+ * @note buffer rather than a copy of the XML
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::TranslateSharedXML(const RefCount<std::string>& data)
+{
+  return DecodeXML(data->c_str(), data);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Decode XML as ADM
+ *
+ * @param data ptr to string containing ADM XML (MUST be terminated)
+ * @param buffer buffer holding data (or invalid if data is not held in a shared buffer)
+ *
+ * @return true if XML decoded correctly
+ *
+ * @note when decoding block formats lazily without a buffer, the XML is copied
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::DecodeXML(const char *data, const RefCount<std::string>& buffer)
+{
+  PARSESTATE state;
+  std::vector<SECTION> sections;
+  const char *p = data;
+  bool lazy = (lazyblockformats && !memorybudget);
+  bool success;
+  uint_t i, j;
+
+  BBCDEBUG3(("XML: %s", data));
+
+  formatfound = false;
+
+  // skip UTF-8 BOM
+  if (strncmp(p, "\xef\xbb\xbf", 3) == 0) p += 3;
+
+  if (lazy)
+  {
+    // block formats are decoded later from the XML so the channel formats keep a reference
+    // to the shared buffer or, if there isn't one, to a copy of the XML
+    if (buffer.Valid()) state.xml = buffer;
+    else
+    {
+      state.xml = new std::string(p);
+      data = p = state.xml->c_str();
+    }
+  }
+
+  state.sections    = ((parsethreads > 1) && !lazy && !memorybudget) ? &sections : NULL;
+  state.section     = NULL;
+  state.lazy        = lazy;
+  state.base        = data;       // lazily decoded block formats are located relative to the start of the buffer
+  state.incremental = false;
+  state.next        = p;
+  SetBudget(state, memorybudget);
+  state.spillstore  = blockstore;
+
+  success = EndParse(state, Parse(state, p, p + strlen(p)));
+
+  if (state.spillstore.Valid()) blockstore = state.spillstore;
+
+  if (sections.size())
+  {
+    if (success) ParseSections(sections);
+
+    // merge results into channels in document order
+    for (i = 0; i < sections.size(); i++)
+    {
+      SECTION& section = sections[i];
+
+      if (success && section.success)
+      {
+        for (j = 0; j < section.values.size(); j++) section.channel->GetValues().MoveValue(section.values[j]);
+        for (j = 0; j < section.blocks.size(); j++) section.channel->Add(section.blocks[j]);
+
+        PostParse(section.channel, NULL);
+        section.channel->SetValues();
+      }
+      else
+      {
+        for (j = 0; j < section.blocks.size(); j++) delete section.blocks[j];
+        success = false;
+      }
+    }
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Complete parsing of XML, checking that it was complete
+ *
+ * @param state parse state
+ * @param success true if parsing has succeeded so far
+ *
+ * @return true if XML was parsed successfully and was complete
+ *
+ * @note any block formats not yet added to their channel formats are deleted
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::EndParse(PARSESTATE& state, bool success)
+{
+  if (success && state.stack.size())
+  {
+    BBCERROR("Unterminated element '%s'", state.stack.back().name.c_str());
+    success = false;
+  }
+
+  if (success && !formatfound)
+  {
+    BBCERROR("Failed to find audioFormatExtended element");
+    success = false;
+  }
+
+  // delete any blocks not yet added to their channels
+  while (state.stack.size())
+  {
+    delete state.stack.back().block;
+    state.stack.pop_back();
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM data from XML supplied in pieces
+ *
+ * StartAxml() MUST be called first, followed by any number of calls to AddAxml()
+ * and finally EndAxml() which completes the ADM
+ *
+ * @return true if successful
+ *
+ * @note each piece is parsed as it is added so the whole XML is never held in memory
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::StartAxml()
+{
+  ResetAxml();
+
+  formatfound = false;
+
+  // XML is parsed serially and block formats decoded immediately
+  streamstate.sections    = NULL;
+  streamstate.section     = NULL;
+  streamstate.lazy        = false;
+  streamstate.base        = NULL;
+  streamstate.incremental = true;
+  streamstate.next        = NULL;
+  SetBudget(streamstate, memorybudget);
+  streamstate.spillstore  = blockstore;
+
+  return true;
+}
+
+bool SAXADMData::AddAxml(const char *data, uint_t len)
+{
+  streamxml.append(data, len);
+
+  return ParseStream(false);
+}
+
+bool SAXADMData::EndAxml()
+{
+  bool success = EndParse(streamstate, ParseStream(true));
+
+  ResetAxml();
+
+  if (success)
+  {
+    Finalise();
+
+    // no XML is retained to compare against
+    ClearXMLHashes(true);
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse XML supplied by AddAxml()
+ *
+ * @param final true if no more XML will be supplied
+ *
+ * @return true if XML parsed correctly
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::ParseStream(bool final)
+{
+  const char *p = streamxml.c_str();
+  bool success  = true;
+
+  if (!streamstarted && ((streamxml.size() >= 3) || final))
+  {
+    // skip UTF-8 BOM
+    if (strncmp(p, "\xef\xbb\xbf", 3) == 0) p += 3;
+    streamstarted = true;
+  }
+
+  if (streamstarted)
+  {
+    streamstate.incremental = !final;
+    streamstate.next        = p;
+
+    success = Parse(streamstate, p, streamxml.c_str() + streamxml.size());
+
+    // remove parsed XML, leaving only the incomplete item at the end
+    streamxml.erase(0, streamstate.next - streamxml.c_str());
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Discard any XML supplied by AddAxml() that has not been decoded
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::ResetAxml()
+{
+  XMLADMData::ResetAxml();
+
+  // delete any blocks not yet added to their channels
+  while (streamstate.stack.size())
+  {
+    delete streamstate.stack.back().block;
+    streamstate.stack.pop_back();
+  }
+
+  // the store is kept alive by any channel formats whose block formats are in it
+  if (streamstate.spillstore.Valid()) blockstore = streamstate.spillstore;
+  SetBudget(streamstate, 0);
+
+  streamstarted = false;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return true if the item (markup or text) at p is complete
+ *
+ * @param p ptr to item (the XML MUST be terminated)
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::IsComplete(const char *p)
+{
+  bool complete = false;
+
+  // text is complete once the following markup has been found
+  if (p[0] != '<') complete = (strchr(p, '<') != NULL);
+  else if (strncmp(p, "<?", 2) == 0) complete = (strstr(p + 2, "?>") != NULL);
+  else if (strncmp(p, "<!--", 4) == 0) complete = (strstr(p + 4, "-->") != NULL);
+  else if (strncmp(p, "<![CDATA[", 9) == 0) complete = (strstr(p + 9, "]]>") != NULL);
+  else if (p[1] == '!') complete = (strchr(p, '>') != NULL);
+  else
+  {
+    // tags are complete at the first '>' outside of an attribute value
+    char quote = 0;
+
+    for (p++; p[0] && !complete; p++)
+    {
+      if (quote)
+      {
+        if (p[0] == quote) quote = 0;
+      }
+      else if ((p[0] == '\"') || (p[0] == '\'')) quote = p[0];
+      else if (p[0] == '>') complete = true;
+    }
+  }
+
+  return complete;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse XML between data and end
+ *
+ * @param state parse state (element stack, etc)
+ * @param data ptr to start of XML
+ * @param end ptr to end of XML (the XML MUST still be terminated at or beyond end)
+ *
+ * @return true if XML parsed correctly
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::Parse(PARSESTATE& state, const char *data, const char *end)
+{
+  const char *p = data;
+  bool success  = true;
+
+  while (success && (p < end))
+  {
+    // when XML is supplied in pieces, stop at the first incomplete item
+    if (state.incremental && !IsComplete(p)) break;
+
+    if (p[0] == '<')
+    {
+      if (strncmp(p, "<?", 2) == 0)
+      {
+        // processing instruction or declaration
+        const char *p1;
+        if ((p1 = strstr(p, "?>")) != NULL) p = p1 + 2;
+        else success = false;
+      }
+      else if (strncmp(p, "<!--", 4) == 0)
+      {
+        // comment
+        const char *p1;
+        if ((p1 = strstr(p, "-->")) != NULL) p = p1 + 3;
+        else success = false;
+      }
+      else if (strncmp(p, "<![CDATA[", 9) == 0)
+      {
+        // CDATA is passed through as text without decoding
+        const char *p1;
+        if ((p1 = strstr(p + 9, "]]>")) != NULL)
+        {
+          Text(state, std::string(p + 9, p1 - (p + 9)), false);
+          p = p1 + 3;
+        }
+        else success = false;
+      }
+      else if (strncmp(p, "<!", 2) == 0)
+      {
+        // DOCTYPE, etc. (internal subsets not supported)
+        const char *p1;
+        if ((p1 = strchr(p, '>')) != NULL) p = p1 + 1;
+        else success = false;
+      }
+      else if (p[1] == '/')
+      {
+        // end tag
+        std::string name;
+
+        p += 2;
+        name = ReadName(p);
+        SkipWhiteSpace(p);
+
+        if (p[0] == '>')
+        {
+          p++;
+          success = EndElement(state, name);
+        }
+        else success = false;
+      }
+      else
+      {
+        // start tag
+        ATTRIBUTES  attrs;
+        std::string name;
+        const char  *tagstart = p;
+        bool        terminated = false, closed = false;
+
+        p++;
+        name = ReadName(p);
+
+        while (success && !terminated && p[0])
+        {
+          SkipWhiteSpace(p);
+
+          if (p[0] == '>')
+          {
+            p++;
+            terminated = true;
+          }
+          else if ((p[0] == '/') && (p[1] == '>'))
+          {
+            p += 2;
+            terminated = closed = true;
+          }
+          else
+          {
+            // attribute
+            std::string attrname = ReadName(p);
+
+            SkipWhiteSpace(p);
+            if (attrname.empty() || (p[0] != '=')) success = false;
+            else
+            {
+              char quote;
+
+              p++;
+              SkipWhiteSpace(p);
+
+              if (((quote = p[0]) == '\"') || (quote == '\''))
+              {
+                const char *p1;
+
+                p++;
+                if ((p1 = strchr(p, quote)) != NULL)
+                {
+                  attrs.push_back(std::pair<std::string,std::string>(attrname, DecodeEntities(p, (uint_t)(p1 - p))));
+                  p = p1 + 1;
+                }
+                else success = false;
+              }
+              else success = false;
+            }
+          }
+        }
+
+        if (success && (name.empty() || !terminated)) success = false;
+        if (success) success = StartElement(state, name, attrs);
+        if (success && state.stack.back().deferred)
+        {
+          // contents of deferred elements are skipped here
+          ELEMENT&   element = state.stack.back();
+          const char *p1     = p;
+
+          if (!closed && ((p1 = FindEndElement(p, name)) == NULL)) success = false;
+          else if (element.kind == Element_Block)
+          {
+            // lazily decoded block format: extend range in channel format element
+            ELEMENT&   parent = state.stack[state.stack.size() - 2];
+            const char *p2    = closed ? p : strchr(p1, '>');
+
+            if (!parent.blockstart) parent.blockstart = tagstart;
+            parent.blockend = closed ? p : (p2 ? p2 + 1 : p1);
+          }
+          else
+          {
+            // channel format contents are parsed later (possibly in parallel)
+            SECTION section;
+
+            section.channel = dynamic_cast<ADMAudioChannelFormat *>(element.obj);
+            section.start   = p;
+            section.end     = p1;
+            section.success = false;
+            state.sections->push_back(section);
+          }
+
+          // continue at end element
+          p = p1;
+        }
+        if (success && closed) success = EndElement(state, name);
+      }
+
+      if (!success) BBCERROR("Malformed XML at offset %lu", (ulong_t)(p - data));
+    }
+    else
+    {
+      // text
+      const char *p1 = strchr(p, '<');
+
+      if (!p1 || (p1 > end)) p1 = end;
+
+      Text(state, DecodeEntities(p, (uint_t)(p1 - p)));
+
+      p = p1;
+    }
+  }
+
+  state.next = p;
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Decode pending block formats (see ADMAudioChannelFormat::SetPendingBlockFormats())
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::DecodeBlockFormats(const ADMAudioChannelFormat& channel, const char *start, const char *end, std::vector<ADMAudioBlockFormat *>& blocks)
+{
+  SAXADMData decoder;       // parser only, no standard definitions
+  SECTION    section;
+  uint_t     i;
+
+  UNUSED_PARAMETER(channel);
+
+  section.channel = NULL;
+  section.start   = start;
+  section.end     = end;
+  section.success = false;
+
+  // any values in the range have already been parsed and are discarded
+  decoder.ParseSection(section);
+
+  if (section.success) blocks.swap(section.blocks);
+  else
+  {
+    for (i = 0; i < section.blocks.size(); i++) delete section.blocks[i];
+  }
+
+  return section.success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Initialise memory budget of parse state
+ *
+ * @param state parse state
+ * @param budget memory budget for block formats (0 = unlimited)
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::SetBudget(PARSESTATE& state, uint64_t budget)
+{
+  state.budget      = budget;
+  state.blockmemory = 0;
+  state.spillable.clear();
+  state.spillstore  = NULL;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Move block formats of completed channel formats out of memory until the memory
+ * used by block formats is within the budget
+ *
+ * @param state parse state
+ *
+ * @return false if block formats could not be moved out of memory
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::SpillBlockFormats(PARSESTATE& state)
+{
+  return SpillBlockFormats(state.spillstore, state.spillable, state.blockmemory, state.budget);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Move block formats of channel formats out of memory until the memory used by block
+ * formats is within the budget
+ *
+ * @param store store to move block formats to (created if necessary)
+ * @param channels channel formats in the order they should be moved (those moved are removed)
+ * @param memory approximate memory used by block formats, updated as they are moved
+ * @param budget memory budget for block formats
+ *
+ * @return false if block formats could not be moved out of memory
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::SpillBlockFormats(RefCount<ADMBlockFormatStore>& store, std::vector<ADMAudioChannelFormat *>& channels, uint64_t& memory, uint64_t budget)
+{
+  uint64_t blocksize = ADMAudioChannelFormat::GetBlockFormatMemory();
+  uint_t   i;
+  bool     success = true;
+
+  // nothing can be moved until a channel format has been completed
+  if (channels.size() && !store.Valid())
+  {
+    const char *tmpdir;
+    std::string dir = spilldirectory;
+    BlockFormatFile *file;
+
+    if (dir.empty()) dir = ((tmpdir = getenv("TMPDIR")) != NULL) ? tmpdir : "/tmp";
+
+    if (((file = new BlockFormatFile(dir)) != NULL) && file->IsOpen()) store = file;
+    else
+    {
+      delete file;
+      success = false;
+    }
+  }
+
+  // move oldest channel formats first (they are least likely to be accessed soon)
+  for (i = 0; success && (i < channels.size()) && (memory > budget); i++)
+  {
+    ADMAudioChannelFormat *channel = channels[i];
+
+    // already pending block formats are not counted
+    if (!channel->BlockFormatsPending())
+    {
+      uint64_t channelmemory = (uint64_t)channel->GetContainedObjectCount() * blocksize;
+
+      // shared block formats are not stored but are no longer counted either
+      if (channel->BlockFormatsShared() || channel->StoreBlockFormats(store))
+      {
+        memory -= std::min(memory, channelmemory);
+      }
+      else success = false;
+    }
+  }
+
+  channels.erase(channels.begin(), channels.begin() + i);
+
+  if (!success) BBCERROR("Failed to move block formats out of memory, memory budget of %s bytes cannot be met", StringFrom(budget).c_str());
+  else BBCDEBUG2(("Block formats using %s bytes after moving %u channel formats out of memory", StringFrom(memory).c_str(), i));
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Move block formats out of memory again until the memory used by block formats is
+ * within the budget (see SetMemoryBudget())
+ *
+ * @return false if block formats could not be moved out of memory
+ *
+ * Block formats that have been read back since parsing (e.g. by track cursors) are moved
+ * out again, least recently read back first.  Those that have not been modified reuse the
+ * run they were read from, modified ones are added to the store again
+ *
+ * @note any block format of this ADM may be deleted so this MUST NOT be called whilst
+ * @note block formats are being accessed (from any thread), e.g. call it periodically
+ * @note from the thread using the track cursors whilst the ADM is being played
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::ApplyMemoryBudget()
+{
+  bool success = true;
+
+  if (memorybudget)
+  {
+    std::vector<ADMObject *> objects;
+    std::multimap<uint64_t,ADMAudioChannelFormat *> loaded;
+    std::multimap<uint64_t,ADMAudioChannelFormat *>::iterator it;
+    std::vector<ADMAudioChannelFormat *> channels;
+    uint64_t blocksize = ADMAudioChannelFormat::GetBlockFormatMemory();
+    uint64_t memory    = 0;
+    uint_t   i;
+
+    GetWritableObjects(ADMAudioChannelFormat::Type, objects);
+    for (i = 0; i < objects.size(); i++)
+    {
+      ADMAudioChannelFormat *channel;
+
+      // as whilst parsing, only block formats held in memory by this ADM alone are counted
+      if (((channel = dynamic_cast<ADMAudioChannelFormat *>(objects[i])) != NULL) &&
+          !channel->IsStandardDefinition() &&
+          !channel->BlockFormatsPending() &&
+          !channel->BlockFormatsShared())
+      {
+        uint_t n = channel->GetContainedObjectCount();
+
+        if (n)
+        {
+          memory += (uint64_t)n * blocksize;
+          loaded.insert(std::pair<uint64_t,ADMAudioChannelFormat *>(channel->GetBlockFormatsLoadSequence(), channel));
+        }
+      }
+    }
+
+    if (memory > memorybudget)
+    {
+      // block formats never moved out of memory are the oldest of all
+      for (it = loaded.begin(); it != loaded.end(); ++it) channels.push_back(it->second);
+
+      success = SpillBlockFormats(blockstore, channels, memory, memorybudget);
+    }
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Add lazily decoded block format to channel format element's extents
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::UpdateBlockExtents(ELEMENT& channel, const ATTRIBUTES& attrs)
+{
+  uint64_t rtime = 0, duration = 0, end;
+  uint_t   i;
+
+  for (i = 0; i < attrs.size(); i++)
+  {
+    if      ((attrs[i].first == "rtime")    && !XMLValues::ParseTime(attrs[i].second.c_str(), rtime))    channel.extentsknown = false;
+    else if ((attrs[i].first == "duration") && !XMLValues::ParseTime(attrs[i].second.c_str(), duration)) channel.extentsknown = false;
+  }
+
+  // as ADMAudioBlockTimeline::GetEndTime()
+  end = duration ? limited::addm(rtime, duration) : ADMObject::MaxTime;
+
+  if (!channel.blockstart)
+  {
+    channel.minstart = rtime;
+    channel.maxend   = end;
+  }
+  else
+  {
+    channel.minstart = std::min(channel.minstart, rtime);
+    channel.maxend   = std::max(channel.maxend,   end);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Find end element (matching start element just read) from p
+ *
+ * @param p ptr to contents of element
+ * @param name element name
+ *
+ * @return ptr to end element or NULL if not found
+ */
+/*--------------------------------------------------------------------------------*/
+const char *SAXADMData::FindEndElement(const char *p, const std::string& name)
+{
+  const char *str = name.c_str();
+  size_t     len  = name.size();
+  uint_t     depth = 1;
+
+  while ((p = strchr(p, '<')) != NULL)
+  {
+    if (strncmp(p, "<!--", 4) == 0)
+    {
+      if ((p = strstr(p, "-->")) == NULL) break;
+    }
+    else if (strncmp(p, "<![CDATA[", 9) == 0)
+    {
+      if ((p = strstr(p, "]]>")) == NULL) break;
+    }
+    else if (p[1] == '/')
+    {
+      // name compared in place to avoid allocations for every element
+      if ((strncmp(p + 2, str, len) == 0) && !IsNameChar(p[2 + len]) && !--depth) return p;
+    }
+    else if ((strncmp(p + 1, str, len) == 0) && !IsNameChar(p[1 + len]))
+    {
+      // self-closing elements do not change the depth ('>' cannot appear unquoted in a tag but can in attributes)
+      const char *p1 = p + 1 + len;
+      char quote = 0;
+
+      for (; p1[0] && (quote || (p1[0] != '>')); p1++)
+      {
+        if      (quote && (p1[0] == quote))                          quote = 0;
+        else if (!quote && ((p1[0] == '\"') || (p1[0] == '\''))) quote = p1[0];
+      }
+
+      if (!p1[0]) break;
+      if (p1[-1] != '/') depth++;
+      p = p1;
+    }
+
+    p++;
+  }
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse the contents of a single deferred audioChannelFormat
+ *
+ * @param section section to parse (values and blocks are stored in section)
+ *
+ * @note this is called from parse threads and so MUST NOT modify the ADM
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::ParseSection(SECTION& section)
+{
+  PARSESTATE state;
+  ELEMENT    element;
+
+  element.name         = ADMAudioChannelFormat::Type;
+  element.kind         = Element_Section;
+  element.haschildren  = false;
+  element.deferred     = false;
+  element.obj          = section.channel;
+  element.block        = NULL;
+  element.blockstart   = NULL;
+  element.blockend     = NULL;
+  element.extentsknown = false;
+  element.minstart     = 0;
+  element.maxend       = 0;
+
+  state.sections    = NULL;
+  state.section     = &section;
+  state.lazy        = false;
+  state.base        = section.start;
+  state.incremental = false;
+  state.next        = section.start;
+  SetBudget(state, 0);
+  state.stack.push_back(element);
+
+  section.success = (Parse(state, section.start, section.end) && (state.stack.size() == 1));
+
+  // delete any blocks not yet added to the section
+  while (state.stack.size())
+  {
+    delete state.stack.back().block;
+    state.stack.pop_back();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse deferred audioChannelFormat sections on a pool of threads
+ *
+ * @param sections list of sections to parse
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::ParseSections(std::vector<SECTION>& sections)
+{
+  WORKERS workers;
+  uint_t  i, nthreads = std::min(parsethreads, (uint_t)sections.size());
+  uint64_t t = GetNanosecondTicks();
+
+  workers.adm      = this;
+  workers.sections = &sections;
+  workers.next     = 0;
+
+  if (nthreads > 1)
+  {
+    // this thread is one of the workers
+    Thread *threads = new Thread[nthreads - 1];
+
+    for (i = 0; i < (nthreads - 1); i++) threads[i].Start(&__ParseSectionsThread, &workers);
+
+    ParseSectionsWorker(workers);
+
+    // wait for all threads to finish
+    for (i = 0; i < (nthreads - 1); i++) threads[i].Stop();
+
+    delete[] threads;
+  }
+  else
+  {
+    for (i = 0; i < sections.size(); i++) ParseSection(sections[i]);
+  }
+
+  UNUSED_PARAMETER(t);
+  BBCDEBUG2(("Parsed %u channel formats using %u threads in %0.3lfms", (uint_t)sections.size(), nthreads, (double)(GetNanosecondTicks() - t) * 1.0e-6));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Thread entry point for parsing sections
+ */
+/*--------------------------------------------------------------------------------*/
+void *SAXADMData::__ParseSectionsThread(Thread& thread, void *arg)
+{
+  UNUSED_PARAMETER(thread);
+  ParseSectionsWorker(*(WORKERS *)arg);
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Take sections from the shared list and parse them until all have been parsed
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::ParseSectionsWorker(WORKERS& workers)
+{
+  uint_t n;
+
+  while (true)
+  {
+    {
+      ThreadLock lock(workers.tlock);
+      n = workers.next++;
+    }
+
+    if (n >= workers.sections->size()) break;
+
+    workers.adm->ParseSection((*workers.sections)[n]);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Handle start of element
+ *
+ * @param name element name
+ * @param attrs element attributes
+ *
+ * @return true if element handled successfully
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::StartElement(PARSESTATE& state, const std::string& name, const ATTRIBUTES& attrs)
+{
+  std::vector<ELEMENT>& stack = state.stack;
+  ELEMENT element;
+  uint_t  parentkind = stack.size() ? stack.back().kind : (uint_t)Element_Ignored;
+  bool    success    = true;
+
+  element.name         = name;
+  element.kind         = Element_Ignored;
+  element.haschildren  = false;
+  element.deferred     = false;
+  element.obj          = NULL;
+  element.block        = NULL;
+  element.blockstart   = NULL;
+  element.blockend     = NULL;
+  element.extentsknown = true;
+  element.minstart     = 0;
+  element.maxend       = 0;
+
+  if (stack.size()) stack.back().haschildren = true;
+
+  if (!stack.size())
+  {
+    // root element
+    // frame is the root of a Serial ADM (ITU-R BS.2125) frame
+    if ((name == "ebuCoreMain") || (name == "ituADM") || (name == "frame")) element.kind = Element_Root;
+    else
+    {
+      BBCERROR("Failed to find ebuCoreMain, ituADM or frame nodes");
+      success = false;
+    }
+  }
+  else if ((parentkind == Element_Root) || (parentkind == Element_Container))
+  {
+    const std::string& parentname = stack.back().name;
+
+    // audioFormatExtended may be at the top level or within coreMetadata/format
+    if ((name == "audioFormatExtended") && ((parentkind == Element_Root) || (parentname == "format")))
+    {
+      element.kind = Element_Container;
+      formatfound  = true;
+    }
+    else if (((name == "coreMetadata") && (parentkind == Element_Root)) ||
+             ((name == "format") && (parentname == "coreMetadata")))
+    {
+      element.kind = Element_Container;
+    }
+    else if (ValidType(name))
+    {
+      // ADM objects are only parsed within audioFormatExtended
+      if (parentname == "audioFormatExtended")
+      {
+        ADMHEADER header;
+
+        ParseHeader(header, name, (void *)&attrs);
+
+        if ((element.obj = Create(name, header.id, header.name)) != NULL)
+        {
+          ParseValues(element.obj, (void *)&attrs);
+          element.kind     = Element_Object;
+          // defer parsing of channel format contents if sections are being collected
+          element.deferred = (state.sections && (name == ADMAudioChannelFormat::Type));
+        }
+      }
+    }
+    else if ((name != "audioFormatExtended") &&
+             (name != "coreMetadata") &&
+             (name != "format")) // not an ADM type
+    {
+      BBCDEBUG4(("Parsing non-ADM type '%s'", name.c_str()));
+
+      element.kind = Element_Value;
+    }
+  }
+  else if ((parentkind == Element_Object) || (parentkind == Element_Section))
+  {
+    if (name == ADMAudioBlockFormat::Type)
+    {
+      // AudioBlockFormat sections are handled differently...
+      if ((parentkind == Element_Section) || dynamic_cast<ADMAudioChannelFormat *>(stack.back().obj))
+      {
+        if (state.lazy)
+        {
+          // only the location and extents of the block format are recorded
+          UpdateBlockExtents(stack.back(), attrs);
+          element.kind     = Element_Block;
+          element.deferred = true;
+        }
+        else if ((element.block = new ADMAudioBlockFormat) != NULL)
+        {
+          ParseAttributes(element.block->GetType(), element.values, attrs);
+          element.kind = Element_Block;
+        }
+        else BBCERROR("Parsed object was not an AudioBlockFormat object");
+      }
+      else BBCERROR("No AudioChannelFormat for found AudioBlockFormat");
+    }
+    else element.kind = Element_Value;
+  }
+  else if ((parentkind == Element_Block) || (parentkind == Element_Value))
+  {
+    element.kind = Element_Value;
+  }
+
+  if (element.kind == Element_Value)
+  {
+    uint_t i;
+
+    element.value.attr = false;
+    element.value.name = name;
+
+    for (i = 0; i < attrs.size(); i++)
+    {
+      element.value.attrs[attrs[i].first] = attrs[i].second;
+    }
+  }
+
+  if (success) stack.push_back(element);
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Handle end of element
+ *
+ * @param name element name
+ *
+ * @return true if element handled successfully
+ */
+/*--------------------------------------------------------------------------------*/
+bool SAXADMData::EndElement(PARSESTATE& state, const std::string& name)
+{
+  std::vector<ELEMENT>& stack = state.stack;
+  bool success = false;
+
+  if (stack.size() && (name == stack.back().name))
+  {
+    ELEMENT& element = stack.back();
+    ELEMENT  *parent = (stack.size() > 1) ? &stack[stack.size() - 2] : NULL;
+
+    success = true;
+
+    switch (element.kind)
+    {
+      case Element_Object:
+        // deferred objects are completed once their section has been parsed
+        if (!element.deferred)
+        {
+          if (element.blockstart)
+          {
+            // block formats will be decoded when first accessed
+            dynamic_cast<ADMAudioChannelFormat *>(element.obj)->SetPendingBlockFormats(state.xml,
+                                                                                       (size_t)(element.blockstart - state.base),
+                                                                                       (size_t)(element.blockend   - state.base),
+                                                                                       &DecodeBlockFormats,
+                                                                                       element.extentsknown,
+                                                                                       element.minstart,
+                                                                                       element.maxend);
+          }
+
+          PostParse(element.obj, NULL);
+          element.obj->SetValues();
+
+          if (state.budget)
+          {
+            ADMAudioChannelFormat *channel;
+
+            // completed channel formats can be moved out of memory
+            if ((channel = dynamic_cast<ADMAudioChannelFormat *>(element.obj)) != NULL)
+            {
+              state.spillable.push_back(channel);
+              if (state.blockmemory > state.budget) success = SpillBlockFormats(state);
+            }
+          }
+        }
+        break;
+
+      case Element_Block:
+        // lazily decoded block formats are not created here
+        if (!element.deferred)
+        {
+          element.block->SetValues(element.values);
+          if (parent->kind == Element_Section) state.section->blocks.push_back(element.block);
+          else dynamic_cast<ADMAudioChannelFormat *>(parent->obj)->Add(element.block);
+          element.block = NULL;
+
+          if (state.budget && ((state.blockmemory += ADMAudioChannelFormat::GetBlockFormatMemory()) > state.budget))
+          {
+            success = SpillBlockFormats(state);
+          }
+        }
+        break;
+
+      case Element_Value:
+        // move subvalues to value
+        element.value.MoveSubValues(element.values);
+
+        switch (parent->kind)
+        {
+          case Element_Object:
+            parent->obj->GetValues().MoveValue(element.value);
+            break;
+
+          case Element_Block:
+          case Element_Value:
+            parent->values.MoveValue(element.value);
+            break;
+
+          case Element_Section:
+            state.section->values.MoveValue(element.value);
+            break;
+
+          case Element_Root:
+            // for root node, use empty name
+            nonadmxml[""].MoveValue(element.value);
+            break;
+
+          case Element_Container:
+            nonadmxml[parent->name].MoveValue(element.value);
+            break;
+
+          default:
+            break;
+        }
+        break;
+
+      default:
+        break;
+    }
+
+    stack.pop_back();
+  }
+  else if (stack.size()) BBCERROR("Mismatched end element '%s' (expected '%s')", name.c_str(), stack.back().name.c_str());
+  else BBCERROR("Unexpected end element '%s'", name.c_str());
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Handle text within element
+ *
+ * @param text text (entities decoded)
+ * @param condense true to condense whitespace (false for CDATA)
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::Text(PARSESTATE& state, const std::string& text, bool condense)
+{
+  // ignore text outside of elements
+  if (!state.stack.size()) return;
+
+  ELEMENT& element = state.stack.back();
+
+  // only the first child of a value can be its text
+  if ((element.kind == Element_Value) && !element.haschildren)
+  {
+    if (condense)
+    {
+      // condense whitespace: strip leading and trailing whitespace and reduce internal runs to a single space
+      std::string str;
+      bool space = false;
+      uint_t i;
+
+      for (i = 0; i < text.size(); i++)
+      {
+        char c = text[i];
+
+        if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n')) space = true;
+        else
+        {
+          if (space && str.size()) str += ' ';
+          str  += c;
+          space = false;
+        }
+      }
+
+      // whitespace only text is ignored
+      if (str.size())
+      {
+        element.value.value = str;
+        element.haschildren = true;
+      }
+    }
+    else
+    {
+      element.value.value = text;
+      element.haschildren = true;
+    }
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse the XML section header
+ *
+ * @param header header object ot be populated
+ * @param type XML type of object
+ * @param userdata ptr to ATTRIBUTES list of the element
+ *
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::ParseHeader(ADMHEADER& header, const std::string& type, void *userdata)
+{
+  const ATTRIBUTES& attrs = *(const ATTRIBUTES *)userdata;
+  uint_t i;
+
+  header.type = type;
+  header.id   = StringFrom(GetNanosecondTicks(), "016x");
+
+  for (i = 0; i < attrs.size(); i++)
+  {
+    const std::string& attr_name = attrs[i].first;
+
+    // find '<type>Name', '<type>ID' or 'UID' (special for AudioTrack)
+    if (attr_name == (type + "Name"))
+    {
+      header.name = attrs[i].second;
+    }
+    else if (attr_name == (type + "ID"))
+    {
+      header.id   = attrs[i].second;
+    }
+    else if (attr_name == "UID")
+    {
+      header.id   = attrs[i].second;
+    }
+  }
+
+  BBCDEBUG2(("Parse header (type='%s', id='%s', name='%s')", header.type.c_str(), header.id.c_str(), header.name.c_str()));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse attributes as values
+ *
+ * @param obj object to read values from
+ * @param userdata ptr to the ATTRIBUTES list of the element
+ *
+ * @note sub-elements are added to the object's values as they close
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::ParseValues(ADMObject *obj, void *userdata)
+{
+  ParseAttributes(obj->GetType(), obj->GetValues(), *(const ATTRIBUTES *)userdata);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse attributes into a list of XML values
+ *
+ * @param type object type - necessary to prevent object name and ID being added
+ * @param values list of XML values to be populated
+ * @param attrs list of element attributes
+ */
+/*--------------------------------------------------------------------------------*/
+void SAXADMData::ParseAttributes(const std::string& type, XMLValues& values, const ATTRIBUTES& attrs)
+{
+  uint_t i;
+
+  for (i = 0; i < attrs.size(); i++)
+  {
+    const std::string& attr_name = attrs[i].first;
+
+    // ignore header values previously found
+    if ((attr_name != (type + "Name")) &&
+        (attr_name != (type + "ID")) &&
+        (attr_name != "UID"))
+    {
+      XMLValue value;
+
+      value.attr  = true;
+      value.name  = attr_name;
+      value.value = attrs[i].second;
+
+      values.MoveValue(value);
+
+      BBCDEBUG3(("%s: %s='%s'", type.c_str(), attr_name.c_str(), attrs[i].second.c_str()));
+    }
+  }
+}
+
+BBC_AUDIOTOOLBOX_END
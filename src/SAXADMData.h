@@ -0,0 +1,481 @@
+#ifndef __SAX_ADM_DATA__
+#define __SAX_ADM_DATA__
+
+#include "XMLADMData.h"
+
+BBC_AUDIOTOOLBOX_START
+
+class Thread;
+
+/*--------------------------------------------------------------------------------*/
+/** An implementation of ADMData using a built-in streaming (SAX-style) XML parser
+ *
+ * Unlike TinyXMLADMData, no document tree is built: ADM objects are created as their
+ * start tags are read and values, blockformats and objects are completed as their
+ * elements close
+ *
+ * @note the memory used by the ADM itself (mostly block formats) still grows with the size
+ * @note of the XML unless a memory budget is set (see SetMemoryBudget())
+ *
+ * @note to use this provider via XMLADMData::CreateADM() (e.g. in ADMRIFFFile), call
+ * @note SAXADMData::Register() before any ADMs are created
+ *
+ * audioChannelFormat contents (usually the vast majority of the XML) can optionally be
+ * parsed on multiple threads, see SetParseThreads()
+ *
+ * XML can also be supplied in pieces (see StartAxml()), in which case it is parsed as it
+ * arrives and only the incomplete item at the end of each piece is kept between pieces
+ *
+ * The memory used by block formats during parsing can be limited, see SetMemoryBudget()
+ */
+/*--------------------------------------------------------------------------------*/
+class SAXADMData : public XMLADMData
+{
+public:
+  SAXADMData(const std::string& standarddefinitionsfile);
+  virtual ~SAXADMData();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Make XMLADMData::CreateADM() (and therefore ADMRIFFFile) use this provider
+   *
+   * @note this is NOT called automatically, TinyXMLADMData remains the default provider
+   * @note unless an application opts in by calling this
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool Register();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set number of threads used to parse audioChannelFormat sections
+   *
+   * @param n number of threads (including the calling thread), 1 disables parallel parsing
+   *
+   * @note applies to all subsequently parsed XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetParseThreads(uint_t n);
+  static uint_t GetParseThreads() {return parsethreads;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Enable/disable lazy decoding of audioBlockFormats
+   *
+   * @param enable true to record only the location of each audioChannelFormat's block formats
+   * in (a copy of) the XML, the block formats being decoded when they are first accessed
+   *
+   * @note XML read using SetAxml(const RefCount<std::string>&) is referenced rather than copied
+   * @note applies to all subsequently parsed XML and takes precedence over parallel parsing
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetLazyBlockFormats(bool enable = true) {lazyblockformats = enable;}
+  static bool GetLazyBlockFormats() {return lazyblockformats;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set memory budget for block formats
+   *
+   * @param bytes approximate maximum memory used by block formats (0 = unlimited)
+   *
+   * @note when the block formats parsed so far exceed the budget, the block formats of
+   * @note completed audioChannelFormats (oldest first) are moved to a temporary file (see
+   * @note SetSpillDirectory()) and read back when they are next accessed (e.g. when a track
+   * @note cursor reaches them)
+   * @note the block formats of the audioChannelFormat being parsed are never moved so a
+   * @note single audioChannelFormat with more block formats than the budget exceeds it
+   * @note applies to all subsequently parsed XML and takes precedence over lazy decoding and
+   * @note parallel parsing (both of which hold the whole XML in memory)
+   * @note once parsing is complete, block formats read back are only moved out of memory
+   * @note again by ApplyMemoryBudget()
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetMemoryBudget(uint64_t bytes) {memorybudget = bytes;}
+  static uint64_t GetMemoryBudget() {return memorybudget;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Move block formats out of memory again until the memory used by block formats is
+   * within the budget (see SetMemoryBudget())
+   *
+   * @return false if block formats could not be moved out of memory
+   *
+   * Block formats that have been read back since parsing (e.g. by track cursors) are moved
+   * out again, least recently read back first.  Those that have not been modified reuse the
+   * run they were read from, modified ones are added to the store again
+   *
+   * @note any block format of this ADM may be deleted so this MUST NOT be called whilst
+   * @note block formats are being accessed (from any thread), e.g. call it periodically
+   * @note from the thread using the track cursors whilst the ADM is being played
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool ApplyMemoryBudget();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set directory in which the temporary file of block formats is created
+   *
+   * @param dir directory (empty to use $TMPDIR or /tmp)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetSpillDirectory(const std::string& dir) {spilldirectory = dir;}
+  static const std::string& GetSpillDirectory() {return spilldirectory;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read ADM data from XML supplied in pieces
+   *
+   * StartAxml() MUST be called first, followed by any number of calls to AddAxml()
+   * and finally EndAxml() which completes the ADM
+   *
+   * @return true if successful
+   *
+   * @note each piece is parsed as it is added so the whole XML is never held in memory
+   * @note audioChannelFormats are always parsed serially and block formats decoded
+   * @note immediately (parallel parsing and lazy decoding require the whole XML)
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool StartAxml();
+  virtual bool AddAxml(const char *data, uint_t len);
+  virtual bool EndAxml();
+
+protected:
+  /*--------------------------------------------------------------------------------*/
+  /** Constructor for parser only instance (used for decoding pending block formats)
+   */
+  /*--------------------------------------------------------------------------------*/
+  SAXADMData();
+
+  typedef std::vector<std::pair<std::string,std::string> > ATTRIBUTES;
+
+  enum {
+    Element_Root = 0,           // ebuCoreMain, ituADM or frame
+    Element_Container,          // coreMetadata, format or audioFormatExtended
+    Element_Object,             // ADM object
+    Element_Section,            // deferred audioChannelFormat being parsed separately
+    Element_Block,              // audioBlockFormat within audioChannelFormat
+    Element_Value,              // value within object, block or non-ADM XML
+    Element_Ignored,            // element (and all sub-elements) ignored
+  };
+
+  typedef struct {
+    std::string         name;
+    uint_t              kind;
+    bool                haschildren;    // true once a sub-element has been found (text after that is ignored)
+    bool                deferred;       // true if contents of object are parsed separately
+    ADMObject           *obj;           // object for Element_Object and Element_Section
+    ADMAudioBlockFormat *block;         // block for Element_Block
+    XMLValue            value;          // value for Element_Value
+    XMLValues           values;         // sub-values for Element_Value, values for Element_Block
+    const char          *blockstart;    // range of lazily decoded block formats within audioChannelFormat
+    const char          *blockend;
+    bool                extentsknown;   // true if extents of lazily decoded block formats are known
+    uint64_t            minstart, maxend;
+  } ELEMENT;
+
+  // contents of an audioChannelFormat, parsed independently of the ADM
+  typedef struct {
+    ADMAudioChannelFormat              *channel;
+    const char                         *start, *end;
+    XMLValues                          values;
+    std::vector<ADMAudioBlockFormat *> blocks;
+    bool                               success;
+  } SECTION;
+
+  typedef struct {
+    std::vector<ELEMENT> stack;
+    std::vector<SECTION> *sections;     // if non-NULL, audioChannelFormat contents are deferred into this list
+    SECTION              *section;      // section being parsed (or NULL)
+    bool                 lazy;          // true to defer decoding of block formats
+    RefCount<std::string> xml;          // XML buffer (if lazy)
+    const char           *base;         // start of XML buffer (if lazy)
+    bool                 incremental;   // true to stop at the first incomplete item (XML supplied in pieces)
+    const char           *next;         // where parsing stopped
+    uint64_t             budget;        // memory budget for block formats (0 = unlimited)
+    uint64_t             blockmemory;   // approximate memory used by block formats held in memory
+    std::vector<ADMAudioChannelFormat *> spillable;     // completed channel formats whose block formats are held in memory
+    RefCount<ADMBlockFormatStore>        spillstore;    // store for block formats moved out of memory
+  } PARSESTATE;
+
+  typedef struct {
+    SAXADMData           *adm;
+    std::vector<SECTION> *sections;
+    uint_t               next;          // next section to be parsed
+    ThreadLockObject     tlock;         // protects next
+  } WORKERS;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Decode XML string as ADM
+   *
+   * @param data ptr to string containing ADM XML (MUST be terminated)
+   *
+   * @return true if XML decoded correctly
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool TranslateXML(const char *data);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Decode XML held in a shared buffer as ADM
+   *
+   * @param data buffer holding ADM XML
+   *
+   * @return true if XML decoded correctly
+   *
+   * @note when decoding block formats lazily, channel formats keep a reference to the
+   * @note buffer rather than a copy of the XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool TranslateSharedXML(const RefCount<std::string>& data);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Decode XML as ADM
+   *
+   * @param data ptr to string containing ADM XML (MUST be terminated)
+   * @param buffer buffer holding data (or invalid if data is not held in a shared buffer)
+   *
+   * @return true if XML decoded correctly
+   *
+   * @note when decoding block formats lazily without a buffer, the XML is copied
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool DecodeXML(const char *data, const RefCount<std::string>& buffer);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse XML header
+   *
+   * @note userdata is a ptr to the ATTRIBUTES list of the element
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ParseHeader(ADMHEADER& header, const std::string& type, void *userdata);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse attributes as values
+   *
+   * @param obj object to read values from
+   * @param userdata ptr to the ATTRIBUTES list of the element
+   *
+   * @note sub-elements are added to the object's values as they close
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ParseValues(ADMObject *obj, void *userdata);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse attributes into a list of XML values
+   *
+   * @param type object type - necessary to prevent object name and ID being added
+   * @param values list of XML values to be populated
+   * @param attrs list of element attributes
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ParseAttributes(const std::string& type, XMLValues& values, const ATTRIBUTES& attrs);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Complete parsing of XML, checking that it was complete
+   *
+   * @param state parse state
+   * @param success true if parsing has succeeded so far
+   *
+   * @return true if XML was parsed successfully and was complete
+   *
+   * @note any block formats not yet added to their channel formats are deleted
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool EndParse(PARSESTATE& state, bool success);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse XML supplied by AddAxml()
+   *
+   * @param final true if no more XML will be supplied
+   *
+   * @return true if XML parsed correctly
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool ParseStream(bool final);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Discard any XML supplied by AddAxml() that has not been decoded
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ResetAxml();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if the item (markup or text) at p is complete
+   *
+   * @param p ptr to item (the XML MUST be terminated)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool IsComplete(const char *p);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse XML between data and end
+   *
+   * @param state parse state (element stack, etc)
+   * @param data ptr to start of XML
+   * @param end ptr to end of XML (the XML MUST still be terminated at or beyond end)
+   *
+   * @return true if XML parsed correctly
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool Parse(PARSESTATE& state, const char *data, const char *end);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse the contents of a single deferred audioChannelFormat
+   *
+   * @param section section to parse (values and blocks are stored in section)
+   *
+   * @note this is called from parse threads and so MUST NOT modify the ADM
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ParseSection(SECTION& section);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse deferred audioChannelFormat sections on a pool of threads
+   *
+   * @param sections list of sections to parse
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ParseSections(std::vector<SECTION>& sections);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Take sections from the shared list and parse them until all have been parsed
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void ParseSectionsWorker(WORKERS& workers);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Decode pending block formats (see ADMAudioChannelFormat::SetPendingBlockFormats())
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool DecodeBlockFormats(const ADMAudioChannelFormat& channel, const char *start, const char *end, std::vector<ADMAudioBlockFormat *>& blocks);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Initialise memory budget of parse state
+   *
+   * @param state parse state
+   * @param budget memory budget for block formats (0 = unlimited)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetBudget(PARSESTATE& state, uint64_t budget);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Move block formats of completed channel formats out of memory until the memory
+   * used by block formats is within the budget
+   *
+   * @param state parse state
+   *
+   * @return false if block formats could not be moved out of memory
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool SpillBlockFormats(PARSESTATE& state);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Move block formats of channel formats out of memory until the memory used by block
+   * formats is within the budget
+   *
+   * @param store store to move block formats to (created if necessary)
+   * @param channels channel formats in the order they should be moved (those moved are removed)
+   * @param memory approximate memory used by block formats, updated as they are moved
+   * @param budget memory budget for block formats
+   *
+   * @return false if block formats could not be moved out of memory
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool SpillBlockFormats(RefCount<ADMBlockFormatStore>& store, std::vector<ADMAudioChannelFormat *>& channels, uint64_t& memory, uint64_t budget);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Add lazily decoded block format to channel format element's extents
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void UpdateBlockExtents(ELEMENT& channel, const ATTRIBUTES& attrs);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Find end element (matching start element just read) from p
+   *
+   * @param p ptr to contents of element
+   * @param name element name
+   *
+   * @return ptr to end element or NULL if not found
+   */
+  /*--------------------------------------------------------------------------------*/
+  static const char *FindEndElement(const char *p, const std::string& name);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Handle start of element
+   *
+   * @param state parse state
+   * @param name element name
+   * @param attrs element attributes
+   *
+   * @return true if element handled successfully
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool StartElement(PARSESTATE& state, const std::string& name, const ATTRIBUTES& attrs);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Handle end of element
+   *
+   * @param state parse state
+   * @param name element name
+   *
+   * @return true if element handled successfully
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool EndElement(PARSESTATE& state, const std::string& name);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Handle text within element
+   *
+   * @param state parse state
+   * @param text text (entities decoded)
+   * @param condense true to condense whitespace (false for CDATA)
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void Text(PARSESTATE& state, const std::string& text, bool condense = true);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Decode XML entities in string
+   */
+  /*--------------------------------------------------------------------------------*/
+  static std::string DecodeEntities(const char *str, uint_t len);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if c can be part of an XML name
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool IsNameChar(char c);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read XML name from p, updating p
+   */
+  /*--------------------------------------------------------------------------------*/
+  static std::string ReadName(const char *& p);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Skip whitespace
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SkipWhiteSpace(const char *& p);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Creator for this class
+   */
+  /*--------------------------------------------------------------------------------*/
+  static XMLADMData *__Creator(const std::string& standarddefinitionsfile, void *context)
+  {
+    UNUSED_PARAMETER(context);
+    return new SAXADMData(standarddefinitionsfile);
+  }
+
+  /*--------------------------------------------------------------------------------*/
+  /** Thread entry point for parsing sections
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void *__ParseSectionsThread(Thread& thread, void *arg);
+
+protected:
+  PARSESTATE streamstate;               // state of XML supplied in pieces
+  bool       streamstarted;             // true once the start of XML supplied in pieces has been parsed
+  bool       formatfound;
+  RefCount<ADMBlockFormatStore> blockstore;     // store block formats have been moved to (kept for ApplyMemoryBudget())
+
+  static uint_t      parsethreads;
+  static bool        lazyblockformats;
+  static uint64_t    memorybudget;
+  static std::string spilldirectory;
+};
+
+BBC_AUDIOTOOLBOX_END
+
+#endif
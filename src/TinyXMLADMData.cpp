@@ -56,8 +56,10 @@ bool TinyXMLADMData::TranslateXML(const char *data)
   doc.Parse(data);
 
   // dig to correct location of audioFormatExtended section
+  // frame is the root of a Serial ADM (ITU-R BS.2125) frame
   if (((node = FindElement(&doc, "ebuCoreMain")) != NULL) ||
-      ((node = FindElement(&doc, "ituADM")) != NULL))
+      ((node = FindElement(&doc, "ituADM")) != NULL) ||
+      ((node = FindElement(&doc, "frame")) != NULL))
   {
     // collect non-ADM objects from parent node
     CollectNonADMObjects(node);
@@ -90,7 +92,7 @@ bool TinyXMLADMData::TranslateXML(const char *data)
       success = true;
     }
   }
-  else BBCERROR("Failed to find ebuCoreMain or ituADM nodes");
+  else BBCERROR("Failed to find ebuCoreMain, ituADM or frame nodes");
 
   return success;
 }
@@ -392,7 +394,8 @@ void TinyXMLADMData::CollectNonADMObjects(const TiXmlNode *node)
 
   // for root node, use empty name
   if ((parentname == "ebuCoreMain") ||
-      (parentname == "ituADM")) parentname = "";
+      (parentname == "ituADM") ||
+      (parentname == "frame")) parentname = "";
   
   for (subnode = node->FirstChild(); subnode; subnode = subnode->NextSibling())
   {
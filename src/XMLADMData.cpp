@@ -7,6 +7,7 @@
 #define BBCDEBUG_LEVEL 1
 #include <bbcat-base/EnhancedFile.h>
 #include "ADMXMLGenerator.h"
+#include "GZipCodec.h"
 
 #include "XMLADMData.h"
 #include "RIFFChunk_Definitions.h"
@@ -20,194 +21,1293 @@ BBC_AUDIOTOOLBOX_START
 
 const std::string XMLADMData::DefaultStandardDefinitionsFile = "standarddefinitions.xml";
 bool  XMLADMData::defaultebuxmlmode = true;
+bool  XMLADMData::usecompiledstandarddefinitions = true;
 
 XMLADMData::XMLADMData() : ADMData(),
-                           ebuxmlmode(defaultebuxmlmode)
+                           xmlskeletonhash(0),
+                           xmlread(false),
+                           xmlhashesvalid(false),
+                           incrementalupdates(false),
+                           ebuxmlmode(defaultebuxmlmode),
+                           ingestadm(NULL),
+                           ingesthorizon(0),
+                           ingestedtime(0),
+                           ingestoffsetsvalid(false)
 {
 }
 
 XMLADMData::XMLADMData(const XMLADMData& obj) : ADMData(obj),
-                                                ebuxmlmode(obj.ebuxmlmode)
+                                                xmlhashes(obj.xmlhashes),
+                                                xmlskeletonhash(obj.xmlskeletonhash),
+                                                xmlread(obj.xmlread),
+                                                xmlhashesvalid(obj.xmlhashesvalid),
+                                                incrementalupdates(obj.incrementalupdates),
+                                                ebuxmlmode(obj.ebuxmlmode),
+                                                ingestadm(NULL),
+                                                ingesthorizon(obj.ingesthorizon),
+                                                ingestedtime(obj.ingestedtime),
+                                                ingestoffsetsvalid(false)
 {
 }
 
 XMLADMData::~XMLADMData()
 {
+  if (ingestadm) delete ingestadm;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Delete all objects within this ADM
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLADMData::Delete()
+{
+  ADMData::Delete();
+
+  // no XML to compare against
+  ClearXMLHashes(false);
+
+  // no frames ingested
+  ingestoffsets.clear();
+  ingestoffsetsvalid = false;
+  ingestedtime       = 0;
 }
 
 /*--------------------------------------------------------------------------------*/
 /** Return provider list, creating as necessary
  */
 /*--------------------------------------------------------------------------------*/
-std::vector<XMLADMData::PROVIDER>& XMLADMData::GetProviderList()
+std::vector<XMLADMData::PROVIDER>& XMLADMData::GetProviderList()
+{
+  // create here so that this function can be called before this object's static data is constructed
+  static std::vector<PROVIDER> _providerlist;
+  return _providerlist;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return process-wide standard definitions library, creating as necessary
+ */
+/*--------------------------------------------------------------------------------*/
+XMLADMData::STANDARDDEFINITIONSLIBRARY& XMLADMData::GetStandardDefinitionsLibrary()
+{
+  // create here so that this function can be called before this object's static data is constructed
+  static STANDARDDEFINITIONSLIBRARY _library;
+  return _library;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Delete all standard definitions held in the process-wide library
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLADMData::ClearStandardDefinitionsLibrary()
+{
+  STANDARDDEFINITIONSLIBRARY& library = GetStandardDefinitionsLibrary();
+  ThreadLock lock(library.tlock);
+  std::map<std::string,const ADMData *>::iterator it;
+
+  for (it = library.definitions.begin(); it != library.definitions.end(); ++it)
+  {
+    delete it->second;
+  }
+
+  library.definitions.clear();
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Load standard definitions file into ADM
+ *
+ * The first time a particular file is requested it is parsed and a copy of the
+ * result stored in the library, subsequent requests copy the objects from the
+ * library (sharing block formats) instead of re-parsing the file
+ *
+ * If no file is specified, the compiled-in standard definitions are used (unless disabled)
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::LoadStandardDefinitions(const std::string& filename)
+{
+  static const std::string paths[] = {
+    "",
+    ".",
+    BBCAT_AUDIOOBJECTS_DATA_FILES,
+  };
+  // library key of the compiled-in standard definitions (the leading NUL means it cannot match a filename)
+  static const std::string compiledkey(std::string(1, '\0') + "compiled-in");
+  STANDARDDEFINITIONSLIBRARY& library = GetStandardDefinitionsLibrary();
+  std::map<std::string,const ADMData *>::const_iterator libit;
+  std::string filename2;
+  uint_t i;
+  bool compiled = ((filename == "") && usecompiledstandarddefinitions && ADMStandardDefinitionsCount);
+  // the compiled-in definitions and the default file are cached separately
+  const std::string& key = compiled ? compiledkey : filename;
+  bool success = false;
+
+  // delete any existing objects
+  Delete();
+
+  // hold the lock whilst parsing so that other threads wait for the result rather than parsing the file themselves
+  ThreadLock lock(library.tlock);
+
+  if ((libit = library.definitions.find(key)) != library.definitions.end())
+  {
+    bool _puremode = puremode;
+
+    BBCDEBUG2(("Using %s standard definitions '%s' from library", compiled ? "compiled-in" : "file", filename.c_str()));
+
+    // copy objects, standard definition channel formats always share their block formats
+    Copy(*libit->second);
+    puremode = _puremode;
+
+    success = true;
+  }
+  else if (compiled)
+  {
+    BBCDEBUG2(("Using compiled-in standard definitions"));
+
+    if (LoadStandardDefinitions(ADMStandardDefinitions, ADMStandardDefinitionsCount))
+    {
+      ADMOBJECTS_IT it;
+
+      // set standard def flag on all loaded objects
+      for (it = admobjects.begin(); it != admobjects.end(); ++it)
+      {
+        it->second->SetStandardDefinition();
+      }
+
+      // store copy in library for subsequent ADMs
+      library.definitions[key] = new ADMData(*this);
+
+      success = true;
+    }
+    else BBCERROR("Failed to load compiled-in standard definitions");
+  }
+  else
+  {
+    for (i = 0; i < NUMBEROF(paths); i++)
+    {
+      if (filename != "") filename2 = EnhancedFile::catpath(paths[i], filename);
+      else                filename2 = EnhancedFile::catpath(paths[i], DefaultStandardDefinitionsFile);    // use default filename if none supplied
+
+      if (EnhancedFile::exists(filename2.c_str()))
+      {
+        BBCDEBUG("Found standard definitions file '%s' as '%s'", filename.c_str(), filename2.c_str());
+
+        if (ReadXMLFromFile(filename2.c_str()))
+        {
+          ADMOBJECTS_IT it;
+
+          // standard definitions are not part of the XML read by the application
+          xmlhashes.clear();
+          xmlread        = false;
+          xmlhashesvalid = false;
+
+          // set standard def flag on all loaded objects
+          for (it = admobjects.begin(); it != admobjects.end(); ++it)
+          {
+            it->second->SetStandardDefinition();
+          }
+
+          // store copy in library for subsequent ADMs
+          library.definitions[filename] = new ADMData(*this);
+
+          success = true;
+        }
+        else BBCERROR("Failed to read standard definitions file '%s'", filename2.c_str());
+        break;
+      }
+      else BBCDEBUG2(("Standard definitions file '%s' doesn't exist (from '%s' and '%s')", filename2.c_str(), paths[i].c_str(), filename.c_str()));
+    }
+
+    if (i == NUMBEROF(paths)) BBCERROR("Failed to find standard definitions file '%s'", filename.c_str());
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Load standard definitions from a list of compiled-in records (see ADMStandardDefinitions.h)
+ *
+ * @param records list of records
+ * @param n number of records
+ *
+ * @return true if all records were handled
+ *
+ * @note this mirrors Parse() but takes the values from the records instead of XML
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::LoadStandardDefinitions(const ADMSTANDARDDEFINITIONSRECORD *records, uint_t n)
+{
+  uint_t i = 0;
+  bool success = true;
+
+  while (success && (i < n))
+  {
+    if (records[i].type == ADMStandardDefinitionsRecord_Object)
+    {
+      ADMHEADER  header;
+      ADMObject  *obj;
+      uint_t     j;
+
+      header.type = records[i++].name;
+      header.id   = StringFrom(GetNanosecondTicks(), "016x");
+
+      // find '<type>Name', '<type>ID' or 'UID' (special for AudioTrack) in object's attributes
+      for (j = i; (j < n) && (records[j].type == ADMStandardDefinitionsRecord_Attribute) && (records[j].level == 0); j++)
+      {
+        std::string attr_name = records[j].name;
+
+        if      (attr_name == (header.type + "Name")) header.name = records[j].value;
+        else if (attr_name == (header.type + "ID"))   header.id   = records[j].value;
+        else if (attr_name == "UID")                  header.id   = records[j].value;
+      }
+
+      if ((obj = Create(header.type, header.id, header.name)) != NULL)
+      {
+        ADMAudioChannelFormat *channel = dynamic_cast<ADMAudioChannelFormat *>(obj);
+
+        i = ReadRecordValues(records, i, n, header.type, obj->GetValues());
+
+        // AudioBlockFormat records follow the values of their AudioChannelFormat
+        while ((i < n) && (records[i].type == ADMStandardDefinitionsRecord_Block))
+        {
+          std::string blocktype = records[i].name;
+          XMLValues   values;
+
+          i = ReadRecordValues(records, i + 1, n, blocktype, values);
+
+          if (channel)
+          {
+            ADMAudioBlockFormat *block;
+
+            if ((block = new ADMAudioBlockFormat) != NULL)
+            {
+              block->SetValues(values);
+              channel->Add(block);
+            }
+          }
+          else BBCERROR("No AudioChannelFormat for found AudioBlockFormat");
+        }
+
+        obj->SetValues();
+      }
+      else
+      {
+        BBCERROR("Failed to create %s object '%s'", header.type.c_str(), header.id.c_str());
+        success = false;
+      }
+    }
+    else
+    {
+      BBCERROR("Unexpected standard definitions record %u (type %u, name '%s')", i, (uint_t)records[i].type, records[i].name);
+      success = false;
+    }
+  }
+
+  if (success) Finalise();
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read attributes and values of an object or block from a list of records
+ *
+ * @param records list of records
+ * @param i index of first record after the object or block record
+ * @param n number of records
+ * @param type object type - necessary to prevent object name and ID being added
+ * @param values list of XML values to be populated
+ *
+ * @return index of next unused record
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t XMLADMData::ReadRecordValues(const ADMSTANDARDDEFINITIONSRECORD *records, uint_t i, uint_t n, const std::string& type, XMLValues& values)
+{
+  for (; (i < n) && (records[i].type == ADMStandardDefinitionsRecord_Attribute) && (records[i].level == 0); i++)
+  {
+    std::string attr_name = records[i].name;
+
+    // ignore header values
+    if ((attr_name != (type + "Name")) &&
+        (attr_name != (type + "ID")) &&
+        (attr_name != "UID"))
+    {
+      XMLValue value;
+
+      value.attr  = true;
+      value.name  = attr_name;
+      value.value = records[i].value;
+
+      values.AddValue(value);
+    }
+  }
+
+  while ((i < n) && (records[i].type == ADMStandardDefinitionsRecord_Value) && (records[i].level == 1))
+  {
+    XMLValue value;
+
+    i = ReadRecordValue(records, i, n, value);
+
+    values.AddValue(value);
+  }
+
+  return i;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read a value (and its attributes and sub-values) from a list of records
+ *
+ * @param records list of records
+ * @param i index of value record
+ * @param n number of records
+ * @param value value to be populated
+ *
+ * @return index of next unused record
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t XMLADMData::ReadRecordValue(const ADMSTANDARDDEFINITIONSRECORD *records, uint_t i, uint_t n, XMLValue& value)
+{
+  uint_t    level = records[i].level;
+  XMLValues subvalues;
+
+  value.attr  = false;
+  value.name  = records[i].name;
+  value.value = records[i].value;
+
+  for (i++; (i < n) && (records[i].type == ADMStandardDefinitionsRecord_Attribute) && (records[i].level == level); i++)
+  {
+    value.attrs[records[i].name] = records[i].value;
+  }
+
+  while ((i < n) && (records[i].type == ADMStandardDefinitionsRecord_Value) && (records[i].level == (level + 1)))
+  {
+    XMLValue subvalue;
+
+    i = ReadRecordValue(records, i, n, subvalue);
+
+    subvalues.AddValue(subvalue);
+  }
+
+  // add subvalues to value
+  value.AddSubValues(subvalues);
+
+  return i;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM data from the chna RIFF chunk
+ *
+ * @param data ptr to chna chunk data
+ * @param len length of chna chunk
+ *
+ * @return true if data read successfully
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::SetChna(const uint8_t *data, uint64_t len)
+{
+  const CHNA_CHUNK& chna = *(const CHNA_CHUNK *)data;
+  uint_t maxuids = (len >= sizeof(CHNA_CHUNK)) ? (uint_t)((len - sizeof(CHNA_CHUNK)) / sizeof(chna.UIDs[0])) : 0;   // calculate maximum number of UIDs given chunk length
+  uint_t nuids, lasttracknum = 0;
+  std::string id, uuid;
+  XMLValue tvalue, pvalue;
+  bool sorted  = tracklist.empty();         // tracks added to an empty list in order need no sorting
+  bool success = true;
+
+  if (maxuids < chna.UIDCount) BBCERROR("Warning: chna specifies %u UIDs but chunk has only length for %u", (uint_t)chna.UIDCount, maxuids);
+
+  nuids = std::min((uint_t)chna.UIDCount, maxuids);
+
+  // size track list once
+  tracklist.reserve(tracklist.size() + nuids);
+
+  uint_t i;
+  for (i = 0; i < nuids; i++)
+  {
+    const CHNA_UID& uid = chna.UIDs[i];
+
+    // only handle non-zero track numbers
+    if (uid.TrackNum)
+    {
+      ADMAudioTrack *track = NULL;
+      ADMOBJECTS_CIT it;
+
+      id.assign(uid.UID, GetChnaFieldLength(uid.UID, sizeof(uid.UID)));
+
+      if (!id.empty())
+      {
+        // find existing track or create new one directly (avoiding Create()'s search for the next track number)
+        uuid.assign(ADMAudioTrack::Type);
+        uuid += '/';
+        uuid += id;
+
+        if ((it = admobjects.find(uuid)) == admobjects.end()) track = new ADMAudioTrack(*this, id);
+        else
+        {
+          // existing track's position in the list is unchanged
+          track  = dynamic_cast<ADMAudioTrack *>(it->second);
+          sorted = false;
+        }
+      }
+      else
+      {
+        track  = dynamic_cast<ADMAudioTrack *>(Create(ADMAudioTrack::Type, id, ""));
+        sorted = false;
+      }
+
+      if (track)
+      {
+        track->SetTrackNum(uid.TrackNum - 1);
+
+        // track list remains sorted as long as track numbers are in order
+        if (track->GetTrackNum() < lasttracknum) sorted = false;
+        lasttracknum = track->GetTrackNum();
+
+        // references are resolved once the objects have been read from the axml
+        tvalue.attr = false;
+        tvalue.name = ADMAudioTrackFormat::Reference;
+        tvalue.value.assign(uid.TrackRef, GetChnaFieldLength(uid.TrackRef, sizeof(uid.TrackRef)));
+
+        pvalue.attr = false;
+        pvalue.name = ADMAudioPackFormat::Reference;
+        pvalue.value.assign(uid.PackRef, GetChnaFieldLength(uid.PackRef, sizeof(uid.PackRef)));
+
+        BBCDEBUG2(("Track %u/%u: Index %u UID '%s' TrackFormatRef '%s' PackFormatRef '%s'",
+                i, (uint_t)tracklist.size(),
+                track->GetTrackNum() + 1,
+                track->GetID().c_str(),
+                tvalue.value.c_str(),
+                pvalue.value.c_str()));
+
+        track->GetValues().MoveValue(tvalue);
+        track->GetValues().MoveValue(pvalue);
+
+        // no values read by SetValues() come from the chna so it need not be called
+      }
+      else BBCERROR("Failed to create AudioTrack for UID %u", i);
+    }
+  }
+
+  // tracks are usually listed in order in the chna so sorting is rarely needed
+  if (!sorted) SortTracks();
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return length of fixed width chna field (which is terminated only if shorter than its width)
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t XMLADMData::GetChnaFieldLength(const char *field, uint_t width)
+{
+  const char *p = (const char *)memchr(field, 0, width);
+
+  return p ? (uint_t)(p - field) : width;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM data from the axml RIFF chunk
+ *
+ * @param data ptr to axml chunk data (MUST be terminated!)
+ *
+ * @return true if data read successfully
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::SetAxml(const char *data)
+{
+  bool success = false;
+
+  BBCDEBUG3(("Read XML:\n%s", data));
+
+  if (TranslateXML(data))
+  {
+    Finalise();
+
+    // record hashes of objects for subsequent incremental updates (if enabled)
+    RecordXMLHashes(data);
+
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM data from explicit XML
+ *
+ * @param data XML data stored as a string
+ *
+ * @return true if data read successfully
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::SetAxml(const std::string& data)
+{
+  bool success = false;
+
+  BBCDEBUG3(("Read XML:\n%s", data.c_str()));
+
+  if (TranslateXML(data.c_str()))
+  {
+    Finalise();
+
+    // record hashes of objects for subsequent incremental updates (if enabled)
+    RecordXMLHashes(data.c_str());
+
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM data from XML held in a shared buffer
+ *
+ * @param data buffer holding XML
+ *
+ * @return true if data read successfully
+ *
+ * @note the ADM may keep a reference to the buffer instead of copying the XML (e.g.
+ * @note SAXADMData decoding block formats lazily) so it MUST NOT be modified afterwards
+ * @note an existing string can be handed over without copying it by swapping it into the buffer
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::SetAxml(const RefCount<std::string>& data)
+{
+  bool success = false;
+
+  BBCDEBUG3(("Read XML:\n%s", data->c_str()));
+
+  if (TranslateSharedXML(data))
+  {
+    Finalise();
+
+    // record hashes of objects for subsequent incremental updates (if enabled)
+    RecordXMLHashes(data->c_str());
+
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM data from XML supplied in pieces
+ *
+ * StartAxml() MUST be called first, followed by any number of calls to AddAxml()
+ * and finally EndAxml() which completes the ADM
+ *
+ * @return true if successful
+ *
+ * @note this base implementation collects the XML and decodes it in EndAxml()
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::StartAxml()
+{
+  ResetAxml();
+  return true;
+}
+
+bool XMLADMData::AddAxml(const char *data, uint_t len)
+{
+  streamxml.append(data, len);
+  return true;
+}
+
+bool XMLADMData::EndAxml()
+{
+  bool success = SetAxml(streamxml);
+
+  ResetAxml();
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Discard any XML supplied by AddAxml() that has not been decoded
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLADMData::ResetAxml()
+{
+  // release memory used by XML
+  std::string().swap(streamxml);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read ADM data from gzip compressed XML (e.g. from a bxml chunk)
+ *
+ * @param data compressed data
+ * @param len length of compressed data
+ *
+ * @return true if data read successfully
+ *
+ * @note the XML is decompressed in blocks and passed to AddAxml()
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::SetCompressedAxml(const uint8_t *data, uint64_t len)
+{
+  GZipDecompressor decompressor(data, len);
+  std::vector<char> buf(65536);
+  uint_t n;
+  bool   success = StartAxml();
+
+  while (success && ((n = decompressor.Read(&buf[0], (uint_t)buf.size())) > 0))
+  {
+    success = AddAxml(&buf[0], n);
+  }
+
+  if (success && !decompressor.IsComplete())
+  {
+    BBCERROR("Compressed XML is invalid or truncated");
+    success = false;
+  }
+
+  if (success) success = EndAxml();
+  else ResetAxml();
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Update ADM from XML that shares most of its content with the XML last read
+ *
+ * @param data ptr to string containing ADM XML (MUST be terminated)
+ *
+ * @return true if ADM updated successfully
+ *
+ * Top-level ADM objects are matched by ID and a hash of their XML: only new or changed
+ * objects are re-parsed and only references to changed or removed objects are re-linked,
+ * all other objects are retained as they are
+ *
+ * The new and changed objects are parsed from a copy of the XML with all unchanged objects
+ * removed (the XML around the objects is unchanged so the provider parses it as normal)
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::UpdateAxml(const char *data)
+{
+  std::vector<XMLFRAGMENT>       fragments;
+  std::map<std::string,uint64_t> hashes;
+  uint64_t skeletonhash;
+  bool     success = false;
+
+  if (!xmlread)
+  {
+    // nothing to compare against, hash the objects for subsequent updates
+    incrementalupdates = true;
+    success = SetAxml(data);
+  }
+  else if (!incrementalupdates) BBCERROR("Incremental updates not enabled when XML was last read, cannot update incrementally");
+  else if (!xmlhashesvalid) BBCERROR("XML last read could not be split into objects, cannot update incrementally");
+  else if (!SplitXML(data, fragments, skeletonhash)) BBCERROR("Failed to split XML into objects, cannot update incrementally");
+  else if (skeletonhash != xmlskeletonhash) BBCDEBUG1(("XML outside of ADM objects has changed, cannot update incrementally"));
+  else
+  {
+    std::map<std::string,uint64_t>::const_iterator it;
+    std::map<const ADMObject *,bool> replaced;          // objects being replaced or removed (bool is a dummy)
+    std::map<std::string,XMLValues>  _nonadmxml;
+    std::vector<bool> changed(fragments.size(), false);
+    std::string       xml;
+    const char        *p = data;
+    uint_t i, nchanged = 0;
+    bool   incremental = true;
+
+    // find new and changed objects
+    for (i = 0; incremental && (i < fragments.size()); i++)
+    {
+      const XMLFRAGMENT& fragment = fragments[i];
+
+      if (hashes.find(fragment.id) != hashes.end())
+      {
+        BBCERROR("Object '%s' appears more than once, cannot update incrementally", fragment.id.c_str());
+        incremental = false;
+      }
+      else hashes[fragment.id] = fragment.hash;
+
+      if (((it = xmlhashes.find(fragment.id)) == xmlhashes.end()) || (it->second != fragment.hash))
+      {
+        changed[i] = true;
+        nchanged++;
+      }
+    }
+
+    // find objects to be replaced or removed
+    for (it = xmlhashes.begin(); incremental && (it != xmlhashes.end()); ++it)
+    {
+      std::map<std::string,uint64_t>::const_iterator it2 = hashes.find(it->first);
+      ADMOBJECTS_CIT it3;
+
+      if (((it2 == hashes.end()) || (it2->second != it->second)) &&
+          ((it3 = admobjects.find(it->first)) != admobjects.end()) &&
+          !it3->second->IsStandardDefinition())
+      {
+        // tracks also hold chna information so cannot be replaced
+        if (it3->second->GetType() == ADMAudioTrack::Type)
+        {
+          BBCDEBUG1(("Track '%s' has changed, cannot update incrementally", it->first.c_str()));
+          incremental = false;
+        }
+        else replaced[it3->second] = true;
+      }
+    }
+
+    for (i = 0; incremental && (i < fragments.size()); i++)
+    {
+      if (changed[i] && (fragments[i].type == ADMAudioTrack::Type))
+      {
+        BBCDEBUG1(("Track '%s' has been added, cannot update incrementally", fragments[i].id.c_str()));
+        incremental = false;
+      }
+    }
+
+    if (incremental)
+    {
+      // construct XML with only the new and changed objects
+      xml.reserve(strlen(data));
+      for (i = 0; i < fragments.size(); i++)
+      {
+        const XMLFRAGMENT& fragment = fragments[i];
+
+        xml.append(p, fragment.start - p);
+        if (changed[i]) xml.append(fragment.start, fragment.end - fragment.start);
+        p = fragment.end;
+      }
+      xml.append(p);
+
+      // parse new and changed objects into a separate ADM first so that this ADM is left unchanged if they fail to parse
+      if (nchanged)
+      {
+        XMLADMData *scratchadm;
+
+        if ((scratchadm = CreateADM()) != NULL)
+        {
+          // scratch ADM never holds standard definitions
+          scratchadm->Delete();
+
+          if (!scratchadm->TranslateXML(xml.c_str()))
+          {
+            BBCERROR("Failed to parse changed objects, ADM left unchanged");
+            incremental = false;
+          }
+
+          delete scratchadm;
+        }
+        else
+        {
+          BBCERROR("No ADM provider available to parse changed objects, cannot update incrementally");
+          incremental = false;
+        }
+      }
+    }
+
+    if (incremental)
+    {
+      std::map<const ADMObject *,bool>::const_iterator it2;
+      ADMOBJECTS_IT it3;
+
+      BBCDEBUG2(("Re-parsing %u of %u objects, replacing or removing %u", nchanged, (uint_t)fragments.size(), (uint_t)replaced.size()));
+
+      // remove old objects from the ADM (they stay valid until references to them have been re-linked)
+      for (it2 = replaced.begin(); it2 != replaced.end(); ++it2)
+      {
+        Unregister(const_cast<ADMObject *>(it2->first));
+      }
+
+      if (nchanged)
+      {
+        // non-ADM XML is unchanged, discard anything read from the XML again
+        nonadmxml.swap(_nonadmxml);
+        success = TranslateXML(xml.c_str());
+        nonadmxml.swap(_nonadmxml);
+      }
+      else success = true;
+
+      // re-link references to replaced or removed objects
+      RelinkReferences(replaced);
+
+      for (it2 = replaced.begin(); it2 != replaced.end(); ++it2)
+      {
+        delete it2->first;
+      }
+
+      // finalise new and changed objects only
+      SortTracks();
+      for (i = 0; i < fragments.size(); i++)
+      {
+        ADMAudioChannelFormat *cf;
+
+        if (changed[i] &&
+            ((it3 = admobjects.find(fragments[i].id)) != admobjects.end()) &&
+            ((cf = dynamic_cast<ADMAudioChannelFormat *>(it3->second)) != NULL))
+        {
+          cf->SortBlockFormats();
+        }
+      }
+      ConnectReferences();
+      ChangeTemporaryIDs();
+
+      if (success) xmlhashes.swap(hashes);
+      else
+      {
+        // ADM no longer matches any XML so it cannot be updated incrementally again
+        BBCERROR("Failed to parse changed objects");
+        xmlhashes.clear();
+        xmlhashesvalid = false;
+      }
+    }
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Record hashes of objects in XML just read (for UpdateAxml())
+ *
+ * @note hashes are only recorded if incremental updates are enabled
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLADMData::RecordXMLHashes(const char *data)
 {
-  // create here so that this function can be called before this object's static data is constructed
-  static std::vector<PROVIDER> _providerlist;
-  return _providerlist;
+  std::vector<XMLFRAGMENT> fragments;
+  uint_t i;
+
+  xmlhashes.clear();
+  xmlread        = true;
+  xmlhashesvalid = (incrementalupdates && SplitXML(data, fragments, xmlskeletonhash));
+
+  for (i = 0; xmlhashesvalid && (i < fragments.size()); i++)
+  {
+    xmlhashes[fragments[i].id] = fragments[i].hash;
+  }
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Load standard definitions file into ADM
+/** Clear hashes of objects in XML (UpdateAxml() then fails unless no ADM has been read)
+ *
+ * @param read true if an ADM has been read by means other than SetAxml()
  */
 /*--------------------------------------------------------------------------------*/
-bool XMLADMData::LoadStandardDefinitions(const std::string& filename)
+void XMLADMData::ClearXMLHashes(bool read)
 {
-  static const std::string paths[] = {
-    "",
-    ".",
-    BBCAT_AUDIOOBJECTS_DATA_FILES,
-  };
-  std::string filename2;
-  uint_t i;
+  xmlhashes.clear();
+  xmlskeletonhash = 0;
+  xmlread         = read;
+  xmlhashesvalid  = false;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Merge a Serial ADM (ITU-R BS.2125) frame into this ADM
+ *
+ * @param data ptr to string containing frame XML (MUST be terminated)
+ *
+ * @return true if frame merged successfully
+ *
+ * Objects not already in this ADM are added, block formats of existing channel formats
+ * are merged (see ADMAudioChannelFormat::MergeBlockFormats()), new references from existing
+ * programmes, content and objects are added and all other changes to existing objects are
+ * ignored.  Full, divided and intermediate frames are all merged in the same way since
+ * each only ever adds to the ADM
+ *
+ * If a horizon is set (see SetIngestHorizon()), block formats superseded more than the
+ * horizon before the end of the frame are then removed so that the memory used by a
+ * continuous stream of frames remains bounded
+ *
+ * @note only frames with a 'total' time reference are supported
+ * @note track cursors using this ADM continue to work across frames but MUST NOT be used
+ * @note from other threads whilst a frame is merged; objects added by a frame must be
+ * @note added to existing cursors using ADMTrackCursor::Add()
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::IngestFrame(const char *data)
+{
+  uint64_t start, duration;
+  bool     success = false;
+
+  // each frame is translated into a separate ADM which never holds standard definitions
+  if (!ingestadm && ((ingestadm = CreateADM()) != NULL)) ingestadm->Delete();
+
+  if (!ingestadm) BBCERROR("No ADM provider available to translate frames");
+  else if (!ingestadm->TranslateXML(data)) BBCERROR("Failed to translate frame");
+  else if (ReadFrameHeader(*ingestadm, start, duration))
+  {
+    std::vector<ADMAudioChannelFormat *> channelformats;
+    uint_t changed;
+
+    if ((changed = MergeFrame(*ingestadm, channelformats)) > 0)
+    {
+      SortTracks();
+
+      // objects of channel formats must be found again
+      ingestoffsetsvalid = false;
+    }
+
+    ingestedtime = std::max(ingestedtime, start + duration);
+
+    BBCDEBUG2(("Ingested frame %0.3lfs-%0.3lfs: added or changed tracks of %u objects, merged block formats of %u channel formats",
+               (double)start * 1.0e-9, (double)(start + duration) * 1.0e-9, changed, (uint_t)channelformats.size()));
+
+    if (ingesthorizon && (ingestedtime > ingesthorizon)) RemoveBlockFormatsBefore(channelformats, ingestedtime - ingesthorizon);
+
+    success = true;
+  }
+
+  // nothing from the frame is retained
+  if (ingestadm) ingestadm->Delete();
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Read start and duration (ns) of a frame from its frameHeader
+ *
+ * @param frameadm ADM into which the frame has been translated
+ * @param start variable to be set to the start of the frame
+ * @param duration variable to be set to the duration of the frame
+ *
+ * @return true if the frame header is valid and supported
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::ReadFrameHeader(const XMLADMData& frameadm, uint64_t& start, uint64_t& duration)
+{
+  const XMLValues   *values, *subvalues;
+  const XMLValue    *header, *format;
+  const std::string *attr;
   bool success = false;
 
-  // delete any existing objects
-  Delete();
+  // frameHeader is held as non-ADM XML of the root node
+  if (((values    = frameadm.GetNonADMXML("")) != NULL) &&
+      ((header    = values->GetValue("frameHeader")) != NULL) &&
+      ((subvalues = header->GetSubValues()) != NULL) &&
+      ((format    = subvalues->GetValue("frameFormat")) != NULL))
+  {
+    if (((attr = format->GetAttribute("timeReference")) != NULL) && (*attr != "total")) BBCERROR("Frame time reference '%s' is not supported", attr->c_str());
+    else if (((attr = format->GetAttribute("start"))    == NULL) || !XMLValues::ParseTime(attr->c_str(), start))    BBCERROR("Frame has no valid start time");
+    else if (((attr = format->GetAttribute("duration")) == NULL) || !XMLValues::ParseTime(attr->c_str(), duration)) BBCERROR("Frame has no valid duration");
+    else
+    {
+      BBCDEBUG3(("Frame type '%s' start %0.3lfs duration %0.3lfs",
+                 ((attr = format->GetAttribute("type")) != NULL) ? attr->c_str() : "", (double)start * 1.0e-9, (double)duration * 1.0e-9));
+      success = true;
+    }
+  }
+  else BBCERROR("Failed to find frameHeader/frameFormat element in frame");
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Merge objects and block formats of a translated frame into this ADM (for IngestFrame())
+ *
+ * @param frameadm ADM into which the frame has been translated
+ * @param channelformats list to be populated with the channel formats whose block formats have been merged
+ *
+ * @return number of objects added or whose tracks have changed
+ *
+ * @note new references from existing programmes, content and objects are added (e.g. tracks
+ * @note added to an object), all other changes to existing objects are ignored
+ * @note the values of objects are moved out of frameadm
+ */
+/*--------------------------------------------------------------------------------*/
+uint_t XMLADMData::MergeFrame(XMLADMData& frameadm, std::vector<ADMAudioChannelFormat *>& channelformats)
+{
+  ADMOBJECTS_IT            it, it2;
+  std::vector<ADMObject *> added, existing;
+  std::vector<XMLValues>   addedreferences, existingreferences;
+  uint_t i, j, changed;
 
-  for (i = 0; i < NUMBEROF(paths); i++)
+  for (it = frameadm.admobjects.begin(); it != frameadm.admobjects.end(); ++it)
   {
-    if (filename != "") filename2 = EnhancedFile::catpath(paths[i], filename);
-    else                filename2 = EnhancedFile::catpath(paths[i], DefaultStandardDefinitionsFile);    // use default filename if none supplied
+    ADMObject             *frameobj = it->second;
+    ADMAudioChannelFormat *cf;
 
-    if (EnhancedFile::exists(filename2.c_str()))
+    if ((it2 = admobjects.find(it->first)) == admobjects.end())
     {
-      BBCDEBUG("Found standard definitions file '%s' as '%s'", filename.c_str(), filename2.c_str());
+      ADMObject *obj;
 
-      if (ReadXMLFromFile(filename2.c_str()))
+      // unconnected references are held in the values, they are moved out of the object before
+      // copying it so that they are only connected once all new objects have been added
+      addedreferences.resize(added.size() + 1);
+      addedreferences.back().swap(frameobj->GetValues());
+
+      if ((obj = CopyObject(frameobj)) != NULL)
       {
-        ADMOBJECTS_IT it;
+        ADMAudioTrack *track;
 
-        // set standard def flag on all loaded objects
-        for (it = admobjects.begin(); it != admobjects.end(); ++it)
+        // ensure track number of new track is not already in use
+        if ((track = dynamic_cast<ADMAudioTrack *>(obj)) != NULL)
         {
-          it->second->SetStandardDefinition();
+          for (j = 0; j < tracklist.size(); j++)
+          {
+            if ((tracklist[j] != track) && (tracklist[j]->GetTrackNum() == track->GetTrackNum()))
+            {
+              track->SetTrackNum(GetNextTrackNum());
+              break;
+            }
+          }
         }
 
-        success = true;
+        if ((cf = dynamic_cast<ADMAudioChannelFormat *>(obj)) != NULL) channelformats.push_back(cf);
+
+        added.push_back(obj);
+      }
+      else
+      {
+        BBCERROR("Failed to copy %s from frame", frameobj->ToString().c_str());
+        addedreferences.pop_back();
+      }
+    }
+    else if (!it2->second->IsStandardDefinition())
+    {
+      const ADMAudioChannelFormat *framecf;
+      const std::string&          type = it2->second->GetType();
+
+      // programmes, content and objects may gain references (e.g. tracks added to an object),
+      // the references of formats and tracks are fixed
+      if ((type == ADMAudioProgramme::Type) ||
+          (type == ADMAudioContent::Type) ||
+          (type == ADMAudioObject::Type))
+      {
+        existing.push_back(it2->second);
+        existingreferences.resize(existing.size());
+        existingreferences.back().swap(frameobj->GetValues());
       }
-      else BBCERROR("Failed to read standard definitions file '%s'", filename2.c_str());
-      break;
+      else if (((cf      = dynamic_cast<ADMAudioChannelFormat *>(it2->second)) != NULL) &&
+               ((framecf = dynamic_cast<const ADMAudioChannelFormat *>(frameobj)) != NULL) &&
+               cf->MergeBlockFormats(*framecf)) channelformats.push_back(cf);
     }
-    else BBCDEBUG2(("Standard definitions file '%s' doesn't exist (from '%s' and '%s')", filename2.c_str(), paths[i].c_str(), filename.c_str()));
   }
 
-  if (i == NUMBEROF(paths)) BBCERROR("Failed to find standard definitions file '%s'", filename.c_str());
+  // connect references of new objects
+  for (i = 0; i < added.size(); i++)
+  {
+    added[i]->GetValues().swap(addedreferences[i]);
+    added[i]->SetReferences();
+  }
 
-  return success;
+  // connect references of existing objects, any other values from the frame are discarded
+  changed = (uint_t)added.size();
+  for (i = 0; i < existing.size(); i++)
+  {
+    const ADMAudioObject *audioobject = dynamic_cast<const ADMAudioObject *>(existing[i]);
+    uint_t ntracks = audioobject ? (uint_t)audioobject->GetTrackRefs().size() : 0;
+
+    existing[i]->GetValues().swap(existingreferences[i]);
+    existing[i]->SetReferences();
+    existing[i]->GetValues().swap(existingreferences[i]);
+
+    if (audioobject && (audioobject->GetTrackRefs().size() != ntracks)) changed++;
+  }
+
+  return changed;
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Read ADM data from the chna RIFF chunk
+/** Remove block formats of channel formats superseded before t (for IngestFrame())
  *
- * @param data ptr to chna chunk data
- * @param len length of chna chunk
+ * @param channelformats channel formats to remove block formats from
+ * @param t time (ns)
  *
- * @return true if data read successfully
+ * @return number of block formats removed
  */
 /*--------------------------------------------------------------------------------*/
-bool XMLADMData::SetChna(const uint8_t *data, uint64_t len)
+uint_t XMLADMData::RemoveBlockFormatsBefore(const std::vector<ADMAudioChannelFormat *>& channelformats, uint64_t t)
 {
-  const CHNA_CHUNK& chna = *(const CHNA_CHUNK *)data;
-  uint_t maxuids = (uint_t)((len - sizeof(CHNA_CHUNK)) / sizeof(chna.UIDs[0]));   // calculate maximum number of UIDs given chunk length
-  std::string terminator;
-  bool success = true;
+  std::map<const ADMAudioChannelFormat *,uint64_t>::const_iterator it;
+  uint_t i, removed = 0;
+
+  if (!ingestoffsetsvalid)
+  {
+    std::vector<const ADMAudioObject *> objects;
 
-  // create string with a single 0 byte in it to detect terminators
-  terminator.push_back(0);
+    GetAudioObjectList(objects);
 
-  if (maxuids < chna.UIDCount) BBCERROR("Warning: chna specifies %u UIDs but chunk has only length for %u", (uint_t)chna.UIDCount, maxuids);
+    // block format times are relative to the start of their object, use a cursor for each
+    // track to find the object of each channel format
+    ingestoffsets.clear();
+    for (i = 0; i < tracklist.size(); i++)
+    {
+      ADMTrackCursor cursor(tracklist[i]->GetTrackNum());
+
+      cursor.Add(objects);
+      cursor.GetChannelFormatOffsets(ingestoffsets);
+    }
+
+    ingestoffsetsvalid = true;
+  }
 
-  uint16_t i;
-  for (i = 0; (i < chna.UIDCount) && (i < maxuids); i++)
+  for (i = 0; i < channelformats.size(); i++)
   {
-    // only handle non-zero track numbers
-    if (chna.UIDs[i].TrackNum)
+    uint64_t offset = ((it = ingestoffsets.find(channelformats[i])) != ingestoffsets.end()) ? it->second : 0;
+
+    if (t > offset) removed += channelformats[i]->RemoveBlockFormatsBefore(t - offset);
+  }
+
+  BBCDEBUG2(("Removed %u block formats superseded before %0.3lfs", removed, (double)t * 1.0e-9));
+
+  return removed;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Find the top-level ADM objects within XML
+ *
+ * @param data ptr to string containing ADM XML (MUST be terminated)
+ * @param fragments list to be populated with the location and hash of each object
+ * @param skeletonhash hash of the XML outside of the objects (ignoring whitespace)
+ *
+ * @return true if XML was split successfully and every object has an ID
+ *
+ * @note ADM objects do not contain elements of their own type so the end of each object
+ * @note is simply the next matching end tag
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::SplitXML(const char *data, std::vector<XMLFRAGMENT>& fragments, uint64_t& skeletonhash) const
+{
+  const char *p = data, *last = data;
+  uint64_t hash = HashXML(NULL, NULL);
+  bool     success = true;
+
+  fragments.clear();
+
+  while (success && ((p = strchr(p, '<')) != NULL))
+  {
+    const char *end = NULL;
+
+    if      (strncmp(p, "<!--", 4) == 0)      {if ((end = strstr(p + 4, "-->")) != NULL) end += 3;}
+    else if (strncmp(p, "<![CDATA[", 9) == 0) {if ((end = strstr(p + 9, "]]>")) != NULL) end += 3;}
+    else if ((p[1] == '?') || (p[1] == '!') || (p[1] == '/')) end = p + 1;
+    else
     {
-      ADMAudioTrack *track;
-      std::string id;
+      XMLFRAGMENT fragment;
+      const char  *p1 = p + 1;
 
-      id.assign(chna.UIDs[i].UID, sizeof(chna.UIDs[i].UID));
-      id = id.substr(0, id.find(terminator));
+      // read element name
+      while (*p1 && !IsWhiteSpace(*p1) && (*p1 != '/') && (*p1 != '>')) p1++;
+      fragment.type.assign(p + 1, p1 - (p + 1));
 
-      if ((track = dynamic_cast<ADMAudioTrack *>(Create(ADMAudioTrack::Type, id, ""))) != NULL)
+      if (ValidType(fragment.type))
       {
-        XMLValue tvalue, pvalue;
+        std::string idattr = (fragment.type == ADMAudioTrack::Type) ? "UID" : fragment.type + "ID";
 
-        track->SetTrackNum(chna.UIDs[i].TrackNum - 1);
+        // read attributes, looking for the ID
+        while (success && *p1 && (*p1 != '/') && (*p1 != '>'))
+        {
+          if (IsWhiteSpace(*p1)) p1++;
+          else
+          {
+            const char *name = p1;
 
-        tvalue.attr = false;
-        tvalue.name = ADMAudioTrackFormat::Reference;
-        tvalue.value.assign(chna.UIDs[i].TrackRef, sizeof(chna.UIDs[i].TrackRef));
-        // trim any zero bytes off the end of the string
-        tvalue.value = tvalue.value.substr(0, tvalue.value.find(terminator));
-        track->AddValue(tvalue);
+            while (*p1 && !IsWhiteSpace(*p1) && (*p1 != '=') && (*p1 != '/') && (*p1 != '>')) p1++;
 
-        pvalue.attr = false;
-        pvalue.name = ADMAudioPackFormat::Reference;
-        pvalue.value.assign(chna.UIDs[i].PackRef, sizeof(chna.UIDs[i].PackRef));
-        // trim any zero bytes off the end of the string
-        pvalue.value = pvalue.value.substr(0, pvalue.value.find(terminator));
-        track->AddValue(pvalue);
+            std::string attr(name, p1 - name);
 
-        track->SetValues();
+            while (IsWhiteSpace(*p1)) p1++;
 
-        BBCDEBUG2(("Track %u/%u: Index %u UID '%s' TrackFormatRef '%s' PackFormatRef '%s'",
-                i, (uint_t)tracklist.size(),
-                track->GetTrackNum() + 1,
-                track->GetID().c_str(),
-                tvalue.value.c_str(),
-                pvalue.value.c_str()));
+            if (*p1 == '=')
+            {
+              const char *value;
+
+              p1++;
+              while (IsWhiteSpace(*p1)) p1++;
+
+              if (((*p1 == '"') || (*p1 == '\'')) && ((value = strchr(p1 + 1, *p1)) != NULL))
+              {
+                if (attr == idattr) fragment.id = fragment.type + "/" + std::string(p1 + 1, value - (p1 + 1));
+                p1 = value + 1;
+              }
+              else success = false;
+            }
+            else success = false;
+          }
+        }
+
+        if (!success) BBCERROR("Malformed start tag for '%s'", fragment.type.c_str());
+        else if (*p1 == '>')
+        {
+          std::string endtag = "</" + fragment.type;
+          const char  *p2    = p1 + 1;
+
+          // find matching end tag
+          while (((p2 = strstr(p2, endtag.c_str())) != NULL) &&
+                 (p2[endtag.size()] != '>') && !IsWhiteSpace(p2[endtag.size()])) p2 += endtag.size();
+
+          if ((p2 != NULL) && ((end = strchr(p2, '>')) != NULL)) end++;
+        }
+        else if ((*p1 == '/') && (p1[1] == '>')) end = p1 + 2;
+
+        if (end)
+        {
+          if (fragment.id.empty())
+          {
+            BBCDEBUG2(("No ID for '%s' object", fragment.type.c_str()));
+            success = false;
+          }
+
+          fragment.start = p;
+          fragment.end   = end;
+          fragment.hash  = HashXML(p, end);
+          fragments.push_back(fragment);
+
+          // add XML before object to skeleton hash
+          hash = HashXML(last, p, hash, true);
+          last = end;
+        }
       }
-      else BBCERROR("Failed to create AudioTrack for UID %u", i);
+      else end = p1;
+    }
+
+    if (end) p = end;
+    else
+    {
+      if (success) BBCERROR("Unterminated XML at offset %lu", (ulong_t)(p - data));
+      success = false;
     }
   }
 
-  SortTracks();
+  // add remainder of XML to skeleton hash
+  skeletonhash = HashXML(last, last + strlen(last), hash, true);
 
   return success;
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Read ADM data from the axml RIFF chunk
+/** Update (FNV-1a) hash with XML text
  *
- * @param data ptr to axml chunk data (MUST be terminated!)
+ * @param start start of text
+ * @param end end of text
+ * @param hash hash to update
+ * @param skipwhitespace true to ignore whitespace
  *
- * @return true if data read successfully
+ * @return updated hash
  */
 /*--------------------------------------------------------------------------------*/
-bool XMLADMData::SetAxml(const char *data)
+uint64_t XMLADMData::HashXML(const char *start, const char *end, uint64_t hash, bool skipwhitespace)
 {
-  bool success = false;
-
-  BBCDEBUG3(("Read XML:\n%s", data));
-
-  if (TranslateXML(data))
+  for (; start < end; start++)
   {
-    Finalise();
-
-    success = true;
+    if (!skipwhitespace || !IsWhiteSpace(*start))
+    {
+      hash ^= (uint8_t)*start;
+      hash *= (uint64_t)0x100000001b3;
+    }
   }
 
-  return success;
+  return hash;
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Read ADM data from explicit XML
+/** Read ADM from binary form generated by GetBinary()
  *
- * @param data XML data stored as a string
+ * @param data binary data
+ * @param len length of data
+ * @param sourcehash hash of the data the binary form was stored with
  *
  * @return true if data read successfully
+ *
+ * @note as no XML is read, a subsequent UpdateAxml() will fail
  */
 /*--------------------------------------------------------------------------------*/
-bool XMLADMData::SetAxml(const std::string& data)
+bool XMLADMData::SetBinary(const uint8_t *data, uint64_t len, uint64_t sourcehash)
 {
   bool success = false;
 
-  BBCDEBUG3(("Read XML:\n%s", data.c_str()));
-
-  if (TranslateXML(data.c_str()))
+  if (ADMData::SetBinary(data, len, sourcehash))
   {
-    Finalise();
+    // ADM has been read but there are no hashes of its XML to compare against
+    ClearXMLHashes(true);
 
     success = true;
   }
@@ -476,6 +1576,86 @@ uint64_t XMLADMData::GetAxmlBuffer(uint8_t *buf, uint64_t buflen, const std::str
   return ADMXMLGenerator::GetAxmlBuffer(this, buf, buflen, ebuxmlmode, indent, eol, ind_level);
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Create XML representation of ADM, writing it to a sink in chunks as it is generated
+ *
+ * @param sink sink to write XML to (e.g. ADMXMLGenerator::FileSink, FDSink or CallbackSink)
+ * @param indent indentation for each level of objects
+ * @param eol end-of-line string
+ * @param ind_level initial indentation level
+ *
+ * @return true if all XML was written to the sink successfully
+ *
+ * @note the XML is never held in memory in its entirety
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::WriteAxml(ADMXMLGenerator::Sink& sink, const std::string& indent, const std::string& eol, uint_t ind_level) const
+{
+  return ADMXMLGenerator::WriteAxml(this, sink, ebuxmlmode, indent, eol, ind_level);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return exact length of XML representation of ADM without generating all of it
+ *
+ * @param indent indentation for each level of objects
+ * @param eol end-of-line string
+ * @param ind_level initial indentation level
+ *
+ * @return length of XML (identical to the length of GetAxml())
+ *
+ * @note once called, channel formats maintain the lengths of their block formats so
+ * @note that subsequent calls only measure block formats added or modified since
+ */
+/*--------------------------------------------------------------------------------*/
+uint64_t XMLADMData::GetAxmlLength(const std::string& indent, const std::string& eol, uint_t ind_level) const
+{
+  return ADMXMLGenerator::GetAxmlLength(this, ebuxmlmode, indent, eol, ind_level);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Sink callback to compress XML as it is generated
+ *
+ * @param data XML data
+ * @param len length of data
+ * @param context GZipCompressor object
+ *
+ * @return true if successful
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::CompressXML(const char *data, uint_t len, void *context)
+{
+  return ((GZipCompressor *)context)->Add(data, len);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Create gzip compressed XML representation of ADM (e.g. for a bxml chunk)
+ *
+ * @param data buffer to be populated with compressed XML
+ * @param level compression level (1 = fastest .. 9 = best)
+ * @param indent indentation for each level of objects
+ * @param eol end-of-line string
+ * @param ind_level initial indentation level
+ *
+ * @return true if successful
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLADMData::GetCompressedAxml(std::vector<uint8_t>& data, int level, const std::string& indent, const std::string& eol, uint_t ind_level) const
+{
+  GZipCompressor compressor(level);
+  ADMXMLGenerator::CallbackSink sink(&CompressXML, &compressor);
+
+  // XML is compressed as it is generated so only the compressed form is ever held in memory
+  bool success = WriteAxml(sink, indent, eol, ind_level);
+
+  if (success && compressor.End())
+  {
+    data.swap(compressor.GetData());
+  }
+  else success = false;
+
+  return success;
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Create an ADM capable of decoding supplied XML as axml chunk
  */
@@ -497,15 +1677,20 @@ XMLADMData *XMLADMData::CreateADM(const std::string& standarddefinitionsfile)
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Register a provider for the above
+/** Register a provider for CreateADM()
+ *
+ * @param fn creator function
+ * @param context context passed to fn
+ * @param preferred true to use this provider in preference to those already registered
  */
 /*--------------------------------------------------------------------------------*/
-void XMLADMData::RegisterProvider(CREATOR fn, void *context)
+void XMLADMData::RegisterProvider(CREATOR fn, void *context, bool preferred)
 {
   std::vector<PROVIDER>& providerlist = GetProviderList();
   PROVIDER provider = {fn, context};
 
-  providerlist.push_back(provider);
+  if (preferred) providerlist.insert(providerlist.begin(), provider);
+  else           providerlist.push_back(provider);
 }
 
 /*--------------------------------------------------------------------------------*/
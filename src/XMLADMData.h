@@ -2,6 +2,8 @@
 #define __XML_ADM_DATA__
 
 #include "ADMData.h"
+#include "ADMStandardDefinitions.h"
+#include "ADMXMLGenerator.h"
 
 BBC_AUDIOTOOLBOX_START
 
@@ -23,6 +25,12 @@ public:
   XMLADMData(const XMLADMData& obj);
   virtual ~XMLADMData();
 
+  /*--------------------------------------------------------------------------------*/
+  /** Delete all objects within this ADM
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void Delete();
+
   /*--------------------------------------------------------------------------------*/
   /** Read ADM data from the chna and axml RIFF chunks
    *
@@ -68,6 +76,131 @@ public:
   /*--------------------------------------------------------------------------------*/
   bool SetAxml(const std::string& data);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Read ADM data from XML held in a shared buffer
+   *
+   * @param data buffer holding XML
+   *
+   * @return true if data read successfully
+   *
+   * @note the ADM may keep a reference to the buffer instead of copying the XML (e.g.
+   * @note SAXADMData decoding block formats lazily) so it MUST NOT be modified afterwards
+   * @note an existing string can be handed over without copying it by swapping it into the buffer
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool SetAxml(const RefCount<std::string>& data);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read ADM data from XML supplied in pieces
+   *
+   * StartAxml() MUST be called first, followed by any number of calls to AddAxml()
+   * and finally EndAxml() which completes the ADM
+   *
+   * @return true if successful
+   *
+   * @note this base implementation collects the XML and decodes it in EndAxml(),
+   * @note providers that parse incrementally (e.g. SAXADMData) need never hold all of the XML
+   * @note but as they do not retain it, a subsequent UpdateAxml() will fail
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool StartAxml();
+  virtual bool AddAxml(const char *data, uint_t len);
+  virtual bool EndAxml();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read ADM data from gzip compressed XML (e.g. from a bxml chunk)
+   *
+   * @param data compressed data
+   * @param len length of compressed data
+   *
+   * @return true if data read successfully
+   *
+   * @note the XML is decompressed in blocks and passed to AddAxml()
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool SetCompressedAxml(const uint8_t *data, uint64_t len);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Update ADM from XML that shares most of its content with the XML last read
+   *
+   * @param data ptr to string containing ADM XML (MUST be terminated)
+   *
+   * @return true if ADM updated successfully
+   *
+   * Top-level ADM objects are matched by ID and a hash of their XML: only new or changed
+   * objects are re-parsed and only references to changed or removed objects are re-linked,
+   * all other objects are retained as they are
+   *
+   * @note if no XML has been read, this is equivalent to SetAxml() with incremental updates
+   * @note enabled, otherwise they MUST have been enabled (see EnableIncrementalUpdates()) before
+   * @note the XML last read was read
+   * @note if the XML outside of the ADM objects has changed or any audioTrackUID has changed
+   * @note (tracks also hold chna information), false is returned and the ADM is left unchanged,
+   * @note the XML should then be read into a new ADM
+   * @note the new and changed objects are parsed into a separate ADM (from CreateADM()) first so
+   * @note that if they fail to parse (or no provider is available), false is returned and the ADM
+   * @note is left unchanged
+   * @note changed and removed objects are deleted so any external pointers to them (e.g. held
+   * @note by track cursors) are invalid after the update
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool UpdateAxml(const char *data);
+  bool UpdateAxml(const std::string& data) {return UpdateAxml(data.c_str());}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Merge a Serial ADM (ITU-R BS.2125) frame into this ADM
+   *
+   * @param data ptr to string containing frame XML (MUST be terminated)
+   *
+   * @return true if frame merged successfully
+   *
+   * Objects not already in this ADM are added, block formats of existing channel formats
+   * are merged (see ADMAudioChannelFormat::MergeBlockFormats()), new references from existing
+   * programmes, content and objects are added and all other changes to existing objects are
+   * ignored.  Full, divided and intermediate frames are all merged in the same way since
+   * each only ever adds to the ADM
+   *
+   * If a horizon is set (see SetIngestHorizon()), block formats superseded more than the
+   * horizon before the end of the frame are then removed so that the memory used by a
+   * continuous stream of frames remains bounded
+   *
+   * @note only frames with a 'total' time reference are supported
+   * @note track cursors using this ADM continue to work across frames but MUST NOT be used
+   * @note from other threads whilst a frame is merged; objects added by a frame must be
+   * @note added to existing cursors using ADMTrackCursor::Add()
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool IngestFrame(const char *data);
+  bool IngestFrame(const std::string& data) {return IngestFrame(data.c_str());}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set and get how long (ns) block formats are retained by IngestFrame() after they have
+   * been superseded (0 to retain all block formats)
+   */
+  /*--------------------------------------------------------------------------------*/
+  void     SetIngestHorizon(uint64_t horizon) {ingesthorizon = horizon;}
+  uint64_t GetIngestHorizon() const {return ingesthorizon;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return end time (ns) of the latest frame passed to IngestFrame()
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint64_t GetIngestedTime() const {return ingestedtime;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read ADM from binary form generated by GetBinary()
+   *
+   * @param data binary data
+   * @param len length of data
+   * @param sourcehash hash of the data the binary form was stored with
+   *
+   * @return true if data read successfully
+   *
+   * @note as no XML is read, a subsequent UpdateAxml() will fail
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool SetBinary(const uint8_t *data, uint64_t len, uint64_t sourcehash = 0);
+
   /*--------------------------------------------------------------------------------*/
   /** Load CHNA data from file
    *
@@ -124,6 +257,50 @@ public:
   /*--------------------------------------------------------------------------------*/
   uint64_t GetAxmlBuffer(uint8_t *buf, uint64_t buflen, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0) const;
 
+  /*--------------------------------------------------------------------------------*/
+  /** Create XML representation of ADM, writing it to a sink in chunks as it is generated
+   *
+   * @param sink sink to write XML to (e.g. ADMXMLGenerator::FileSink, FDSink or CallbackSink)
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param ind_level initial indentation level
+   *
+   * @return true if all XML was written to the sink successfully
+   *
+   * @note the XML is never held in memory in its entirety
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool WriteAxml(ADMXMLGenerator::Sink& sink, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return exact length of XML representation of ADM without generating all of it
+   *
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param ind_level initial indentation level
+   *
+   * @return length of XML (identical to the length of GetAxml())
+   *
+   * @note once called, channel formats maintain the lengths of their block formats so
+   * @note that subsequent calls only measure block formats added or modified since
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint64_t GetAxmlLength(const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Create gzip compressed XML representation of ADM (e.g. for a bxml chunk)
+   *
+   * @param data buffer to be populated with compressed XML
+   * @param level compression level (1 = fastest .. 9 = best)
+   * @param indent indentation for each level of objects
+   * @param eol end-of-line string
+   * @param ind_level initial indentation level
+   *
+   * @return true if successful
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool GetCompressedAxml(std::vector<uint8_t>& data, int level = 6, const std::string& indent = "\t", const std::string& eol = "\n", uint_t ind_level = 0) const;
+
   /*--------------------------------------------------------------------------------*/
   /** Set default EBU XML output mode
    */
@@ -142,16 +319,105 @@ public:
   /*--------------------------------------------------------------------------------*/
   void SetEBUXMLMode(bool enable = true) {ebuxmlmode = enable;}
 
+  /*--------------------------------------------------------------------------------*/
+  /** Enable hashing of the objects of XML as it is read so that UpdateAxml() can later
+   * update the ADM incrementally
+   *
+   * @note MUST be enabled before the XML to be updated from is read (UpdateAxml() enables it
+   * @note itself when it is used to read the first XML)
+   * @note disabled by default since the hashing is an extra pass over the XML
+   */
+  /*--------------------------------------------------------------------------------*/
+  void EnableIncrementalUpdates(bool enable = true) {incrementalupdates = enable;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return whether objects of XML are hashed as it is read (see EnableIncrementalUpdates())
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool IncrementalUpdatesEnabled() const {return incrementalupdates;}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Update (FNV-1a) hash with XML text (or any other data)
+   *
+   * @param start start of text
+   * @param end end of text
+   * @param hash hash to update
+   * @param skipwhitespace true to ignore whitespace
+   *
+   * @return updated hash
+   */
+  /*--------------------------------------------------------------------------------*/
+  static uint64_t HashXML(const char *start, const char *end, uint64_t hash = (uint64_t)0xcbf29ce484222325, bool skipwhitespace = false);
+
   static const std::string DefaultStandardDefinitionsFile;
   static XMLADMData *CreateADM(const std::string& standarddefinitionsfile = "");
+
+  /*--------------------------------------------------------------------------------*/
+  /** Delete all standard definitions held in the process-wide library
+   *
+   * @note the next ADM created will re-read its standard definitions file
+   * @note ADMs already created are unaffected
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void ClearStandardDefinitionsLibrary();
+
+  /*--------------------------------------------------------------------------------*/
+  /** Set whether the compiled-in standard definitions are used when no standard definitions
+   * file is explicitly specified (default true)
+   *
+   * @note if disabled, the standard definitions file is searched for and parsed as before
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void SetUseCompiledStandardDefinitions(bool enable = true) {usecompiledstandarddefinitions = enable;}
   
 protected:
   /*--------------------------------------------------------------------------------*/
   /** Load standard definitions file into ADM
+   *
+   * @note each standard definitions file is only parsed once per process, the parsed
+   * @note objects are kept in a library and copied (sharing block formats) into each ADM
    */
   /*--------------------------------------------------------------------------------*/
   virtual bool LoadStandardDefinitions(const std::string& filename);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Load standard definitions from a list of compiled-in records (see ADMStandardDefinitions.h)
+   *
+   * @param records list of records
+   * @param n number of records
+   *
+   * @return true if all records were handled
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool LoadStandardDefinitions(const ADMSTANDARDDEFINITIONSRECORD *records, uint_t n);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read attributes and values of an object or block from a list of records
+   *
+   * @param records list of records
+   * @param i index of first record after the object or block record
+   * @param n number of records
+   * @param type object type - necessary to prevent object name and ID being added
+   * @param values list of XML values to be populated
+   *
+   * @return index of next unused record
+   */
+  /*--------------------------------------------------------------------------------*/
+  static uint_t ReadRecordValues(const ADMSTANDARDDEFINITIONSRECORD *records, uint_t i, uint_t n, const std::string& type, XMLValues& values);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read a value (and its attributes and sub-values) from a list of records
+   *
+   * @param records list of records
+   * @param i index of value record
+   * @param n number of records
+   * @param value value to be populated
+   *
+   * @return index of next unused record
+   */
+  /*--------------------------------------------------------------------------------*/
+  static uint_t ReadRecordValue(const ADMSTANDARDDEFINITIONSRECORD *records, uint_t i, uint_t n, XMLValue& value);
+
   typedef struct
   {
     std::string type;
@@ -159,6 +425,114 @@ protected:
     std::string name;
   } ADMHEADER;
 
+  /*--------------------------------------------------------------------------------*/
+  /** Location and hash of the XML of a top-level ADM object
+   */
+  /*--------------------------------------------------------------------------------*/
+  typedef struct
+  {
+    std::string type;
+    std::string id;                     ///< map entry ID (<type>/<id>)
+    const char  *start, *end;           ///< XML of object (including start and end tags)
+    uint64_t    hash;
+  } XMLFRAGMENT;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return length of fixed width chna field (which is terminated only if shorter than its width)
+   */
+  /*--------------------------------------------------------------------------------*/
+  static uint_t GetChnaFieldLength(const char *field, uint_t width);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Sink callback to compress XML as it is generated
+   *
+   * @param data XML data
+   * @param len length of data
+   * @param context GZipCompressor object
+   *
+   * @return true if successful
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool CompressXML(const char *data, uint_t len, void *context);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Find the top-level ADM objects within XML
+   *
+   * @param data ptr to string containing ADM XML (MUST be terminated)
+   * @param fragments list to be populated with the location and hash of each object
+   * @param skeletonhash hash of the XML outside of the objects (ignoring whitespace)
+   *
+   * @return true if XML was split successfully and every object has an ID
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool SplitXML(const char *data, std::vector<XMLFRAGMENT>& fragments, uint64_t& skeletonhash) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if c is XML whitespace
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool IsWhiteSpace(char c) {return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Record hashes of objects in XML just read (for UpdateAxml())
+   *
+   * @note hashes are only recorded if incremental updates are enabled
+   */
+  /*--------------------------------------------------------------------------------*/
+  void RecordXMLHashes(const char *data);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Clear hashes of objects in XML (UpdateAxml() then fails unless no ADM has been read)
+   *
+   * @param read true if an ADM has been read by means other than SetAxml()
+   */
+  /*--------------------------------------------------------------------------------*/
+  void ClearXMLHashes(bool read);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Read start and duration (ns) of a frame from its frameHeader
+   *
+   * @param frameadm ADM into which the frame has been translated
+   * @param start variable to be set to the start of the frame
+   * @param duration variable to be set to the duration of the frame
+   *
+   * @return true if the frame header is valid and supported
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool ReadFrameHeader(const XMLADMData& frameadm, uint64_t& start, uint64_t& duration);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Merge objects and block formats of a translated frame into this ADM (for IngestFrame())
+   *
+   * @param frameadm ADM into which the frame has been translated
+   * @param channelformats list to be populated with the channel formats whose block formats have been merged
+   *
+   * @return number of objects added or whose tracks have changed
+   *
+   * @note new references from existing programmes, content and objects are added (e.g. tracks
+   * @note added to an object), all other changes to existing objects are ignored
+   * @note the values of objects are moved out of frameadm
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t MergeFrame(XMLADMData& frameadm, std::vector<ADMAudioChannelFormat *>& channelformats);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Remove block formats of channel formats superseded before t (for IngestFrame())
+   *
+   * @param channelformats channel formats to remove block formats from
+   * @param t time (ns)
+   *
+   * @return number of block formats removed
+   */
+  /*--------------------------------------------------------------------------------*/
+  uint_t RemoveBlockFormatsBefore(const std::vector<ADMAudioChannelFormat *>& channelformats, uint64_t t);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Discard any XML supplied by AddAxml() that has not been decoded
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual void ResetAxml();
+
   /*--------------------------------------------------------------------------------*/
   /** Decode XML string as ADM
    *
@@ -169,6 +543,19 @@ protected:
   /*--------------------------------------------------------------------------------*/
   virtual bool TranslateXML(const char *data) = 0;
 
+  /*--------------------------------------------------------------------------------*/
+  /** Decode XML held in a shared buffer as ADM
+   *
+   * @param data buffer holding ADM XML
+   *
+   * @return true if XML decoded correctly
+   *
+   * @note providers that would otherwise copy the XML should override this to keep a
+   * @note reference to the buffer instead
+   */
+  /*--------------------------------------------------------------------------------*/
+  virtual bool TranslateSharedXML(const RefCount<std::string>& data) {return TranslateXML(data->c_str());}
+
   virtual ADMObject *Parse(const std::string& type, void *userdata);
 
   /*--------------------------------------------------------------------------------*/
@@ -209,11 +596,43 @@ protected:
   /*--------------------------------------------------------------------------------*/
   static std::vector<PROVIDER>& GetProviderList();
 
-  static void RegisterProvider(CREATOR fn, void *context = NULL);
+  /*--------------------------------------------------------------------------------*/
+  /** Register a provider for CreateADM()
+   *
+   * @param fn creator function
+   * @param context context passed to fn
+   * @param preferred true to use this provider in preference to those already registered
+   */
+  /*--------------------------------------------------------------------------------*/
+  static void RegisterProvider(CREATOR fn, void *context = NULL, bool preferred = false);
+
+  typedef struct
+  {
+    ThreadLockObject                     tlock;
+    std::map<std::string,const ADMData *> definitions;   ///< parsed standard definitions, keyed by requested filename (the compiled-in definitions use a key of their own)
+  } STANDARDDEFINITIONSLIBRARY;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return process-wide standard definitions library, creating as necessary
+   */
+  /*--------------------------------------------------------------------------------*/
+  static STANDARDDEFINITIONSLIBRARY& GetStandardDefinitionsLibrary();
 
 protected:
+  std::string streamxml;                        ///< XML supplied to AddAxml() but not yet decoded
+  std::map<std::string,uint64_t> xmlhashes;     ///< map entry ID -> hash of XML of each object in the XML last read
+  uint64_t    xmlskeletonhash;                  ///< hash of the XML last read outside of the objects
+  bool        xmlread;                          ///< true if XML has been read (excluding standard definitions)
+  bool        xmlhashesvalid;                   ///< false if the XML last read could not be split into objects
+  bool        incrementalupdates;               ///< true to record hashes of XML as it is read (for UpdateAxml())
   bool        ebuxmlmode;
+  XMLADMData  *ingestadm;                       ///< ADM each frame supplied to IngestFrame() is translated into
+  uint64_t    ingesthorizon;                    ///< time block formats are retained after being superseded (0 = forever)
+  uint64_t    ingestedtime;                     ///< end time of latest frame supplied to IngestFrame()
+  std::map<const ADMAudioChannelFormat *,uint64_t> ingestoffsets;  ///< start times of the objects of channel formats
+  bool        ingestoffsetsvalid;               ///< false if ingestoffsets must be regenerated
   static bool defaultebuxmlmode;
+  static bool usecompiledstandarddefinitions;
 };
 
 BBC_AUDIOTOOLBOX_END
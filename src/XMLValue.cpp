@@ -2,6 +2,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <locale.h>
+
+#include <algorithm>
 
 #include "XMLValue.h"
 
@@ -40,6 +43,33 @@ XMLValue& XMLValue::operator = (const XMLValue& obj)
   return *this;
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Comparison operator (names, values, attributes and sub-values must all match)
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLValue::operator == (const XMLValue& obj) const
+{
+  return ((attr  == obj.attr)  &&
+          (name  == obj.name)  &&
+          (value == obj.value) &&
+          (attrs == obj.attrs) &&
+          ((subvalues == NULL) == (obj.subvalues == NULL)) &&
+          (!subvalues || (*subvalues == *obj.subvalues)));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Swap contents with another value without copying any strings or sub-values
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLValue::swap(XMLValue& obj)
+{
+  std::swap(attr, obj.attr);
+  name.swap(obj.name);
+  value.swap(obj.value);
+  attrs.swap(obj.attrs);
+  std::swap(subvalues, obj.subvalues);
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Set subvalues list
  */
@@ -88,6 +118,34 @@ void XMLValue::AddSubValues(const XMLValues& _subvalues)
   }
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Move a set of sub values to the list without copying them
+ *
+ * @note _subvalues is left empty
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLValue::MoveSubValues(XMLValues& _subvalues)
+{
+  if (_subvalues.size())
+  {
+    if (!subvalues)
+    {
+      // take the entire list
+      if ((subvalues = new XMLValues) != NULL) subvalues->swap(_subvalues);
+    }
+    else
+    {
+      uint_t i;
+      for (i = 0; i < _subvalues.size(); i++)
+      {
+        subvalues->MoveValue(_subvalues[i]);
+      }
+    }
+
+    _subvalues.clear();
+  }
+}
+
 /*--------------------------------------------------------------------------------*/
 /** Add a single sub value to the lsit
  */
@@ -167,28 +225,166 @@ const std::string *XMLValue::GetAttribute(const std::string& _name) const
 /*--------------------------------------------------------------------------------*/
 void XMLValues::AddValue(const XMLValue& value)
 {
-  push_back(value);
+  std::vector<XMLValue>::push_back(value);
+
+  // note: value may have been an item in this list so use the new item
+  if (indexvalid && (indexsize == (size() - 1)))
+  {
+    index.insert(std::upper_bound(index.begin(), index.end(), back().name, IndexCompare(*this)), indexsize++);
+  }
 }
 
 /*--------------------------------------------------------------------------------*/
-/** Return ptr to value with specified name or NULL
+/** Move a value to the end of the internal list without copying it
+ *
+ * @note value is left empty and MUST NOT be an item of this list
  */
 /*--------------------------------------------------------------------------------*/
-const XMLValue* XMLValues::GetValue(const std::string& name) const
+void XMLValues::MoveValue(XMLValue& value)
+{
+  std::vector<XMLValue>::push_back(XMLValue());
+  back().swap(value);
+
+  if (indexvalid && (indexsize == (size() - 1)))
+  {
+    index.insert(std::upper_bound(index.begin(), index.end(), back().name, IndexCompare(*this)), indexsize++);
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Erase value, maintaining the index
+ *
+ * @note subsequent values are moved using XMLValue::swap() rather than being copied
+ */
+/*--------------------------------------------------------------------------------*/
+XMLValues::iterator XMLValues::erase(iterator it)
+{
+  uint_t i, n = (uint_t)(it - begin());
+
+  if (n < size())
+  {
+    RemoveFromIndex(n);
+
+    for (i = n + 1; i < size(); i++) operator[](i - 1).swap(operator[](i));
+    pop_back();
+  }
+
+  return begin() + n;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Erase range of values
+ *
+ * @note subsequent values are moved using XMLValue::swap() rather than being copied
+ * @note the index is rebuilt on the next lookup
+ */
+/*--------------------------------------------------------------------------------*/
+XMLValues::iterator XMLValues::erase(iterator first, iterator last)
+{
+  uint_t i, n = (uint_t)(first - begin()), m = (uint_t)(last - begin());
+
+  if (n < m)
+  {
+    for (i = m; i < size(); i++) operator[](n + i - m).swap(operator[](i));
+    std::vector<XMLValue>::erase(begin() + (size() - (m - n)), end());
+
+    indexvalid = false;
+  }
+
+  return begin() + n;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** (Re)build index
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLValues::BuildIndex() const
 {
-  const XMLValue *value = NULL;
   uint_t i;
 
-  // simple search and compare
-  // (MUST use a list because there can be MULTIPLE values of the same name)
-  for (i = 0; i < size(); i++)
+  index.resize(size());
+  for (i = 0; i < size(); i++) index[i] = i;
+  std::sort(index.begin(), index.end(), IndexCompare(*this));
+
+  indexsize  = (uint_t)size();
+  indexvalid = true;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Remove value n from index
+ */
+/*--------------------------------------------------------------------------------*/
+void XMLValues::RemoveFromIndex(uint_t n)
+{
+  if (indexvalid && (indexsize == size()))
   {
-    if (operator[](i).name == name)
+    std::vector<uint_t>::iterator it;
+
+    if (((it = std::lower_bound(index.begin(), index.end(), n, IndexCompare(*this))) != index.end()) && (*it == n))
     {
-      value = &operator[](i);
-      break;
+      uint_t i;
+
+      index.erase(it);
+
+      // all subsequent values move down by one
+      for (i = 0; i < index.size(); i++)
+      {
+        if (index[i] > n) index[i]--;
+      }
+
+      indexsize--;
     }
+    // value has been renamed: rebuild on next lookup
+    else indexvalid = false;
   }
+  else indexvalid = false;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return index of first value with specified name or -1
+ */
+/*--------------------------------------------------------------------------------*/
+sint_t XMLValues::Find(const std::string& name) const
+{
+  std::vector<uint_t>::const_iterator it;
+  sint_t n = -1;
+
+  if (size() < IndexThreshold)
+  {
+    // short lists are quicker to search than to index
+    uint_t i;
+
+    for (i = 0; (i < size()) && (n < 0); i++)
+    {
+      if (operator[](i).name == name) n = (sint_t)i;
+    }
+  }
+  else
+  {
+    if (!indexvalid || (indexsize != size())) BuildIndex();
+
+    // first value with the name is the first in the index
+    if (((it = std::lower_bound(index.begin(), index.end(), name, IndexCompare(*this))) != index.end()) &&
+        (operator[](*it).name == name))
+    {
+      n = (sint_t)*it;
+    }
+  }
+
+  return n;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return ptr to value with specified name or NULL
+ */
+/*--------------------------------------------------------------------------------*/
+const XMLValue* XMLValues::GetValue(const std::string& name) const
+{
+  const XMLValue *value = NULL;
+  sint_t n;
+
+  // (MUST use a list because there can be MULTIPLE values of the same name)
+  if ((n = Find(name)) >= 0) value = &operator[](n);
 
   if (!value) BBCDEBUG4(("No value named '%s'!", name.c_str()));
 
@@ -205,18 +401,10 @@ const XMLValue* XMLValues::GetValue(const std::string& name) const
 /*--------------------------------------------------------------------------------*/
 void XMLValues::EraseValue(const XMLValue *value)
 {
-  iterator it;
-    
-  for (it = begin(); it != end(); ++it)
+  // note address comparison not value comparison!
+  if (size() && (value >= &front()) && (value <= &back()))
   {
-    const XMLValue& value1 = *it;
-
-    // note address comparison not value comparison!
-    if (value == &value1)
-    {
-      erase(it);
-      break;
-    }
+    erase(begin() + (value - &front()));
   }
 }
 
@@ -264,7 +452,7 @@ bool XMLValues::SetValue(double& res, const std::string& name)
 
   if ((value = GetValue(name)) != NULL)
   {
-    success = (sscanf(value->value.c_str(), "%lf", &res) > 0);
+    success = ParseNumber(value->value.c_str(), res);
     EraseValue(value);
   }
 
@@ -290,9 +478,7 @@ bool XMLValues::SetValue(uint_t& res, const std::string& name, bool hex)
 
   if ((value = GetValue(name)) != NULL)
   {
-    if (hex) success = (sscanf(value->value.c_str(), "%x", &res) > 0);
-    else     success = (sscanf(value->value.c_str(), "%u", &res) > 0);
-
+    success = ParseNumber(value->value.c_str(), res, hex);
     EraseValue(value);
   }
 
@@ -317,8 +503,7 @@ bool XMLValues::SetValue(ulong_t& res, const std::string& name, bool hex)
 
   if ((value = GetValue(name)) != NULL)
   {
-    if (hex) success = (sscanf(value->value.c_str(), "%lx", &res) > 0);
-    else     success = (sscanf(value->value.c_str(), "%lu", &res) > 0);
+    success = ParseNumber(value->value.c_str(), res, hex);
     EraseValue(value);
   }
 
@@ -344,8 +529,7 @@ bool XMLValues::SetValue(sint_t& res, const std::string& name, bool hex)
 
   if ((value = GetValue(name)) != NULL)
   {
-    if (hex) success = (sscanf(value->value.c_str(), "%x", (uint_t *)&res) > 0);
-    else     success = (sscanf(value->value.c_str(), "%d", &res) > 0);
+    success = ParseNumber(value->value.c_str(), res, hex);
     EraseValue(value);
   }
 
@@ -371,8 +555,7 @@ bool XMLValues::SetValue(slong_t& res, const std::string& name, bool hex)
 
   if ((value = GetValue(name)) != NULL)
   {
-    if (hex) success = (sscanf(value->value.c_str(), "%lx", (ulong_t *)&res) > 0);
-    else     success = (sscanf(value->value.c_str(), "%ld", &res) > 0);
+    success = ParseNumber(value->value.c_str(), res, hex);
     EraseValue(value);
   }
 
@@ -423,12 +606,390 @@ bool XMLValues::SetValueTime(uint64_t& res, const std::string& name)
 
   if ((value = GetValue(name)) != NULL)
   {
-    success = CalcTime(res, value->value);
+    success = ParseTime(value->value.c_str(), res);
     EraseValue(value);
   }
 
   return success;
 }
 
+/*--------------------------------------------------------------------------------*/
+/** Parse decimal or hex digits at p, updating p
+ *
+ * @return true if at least one digit was found and the value did not overflow
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLValues::ParseDigits(const char *& p, uint64_t& res, bool hex)
+{
+  const uint64_t base = hex ? 16 : 10;
+  const char *p1 = p;
+  uint64_t val = 0;
+  bool     overflow = false;
+
+  while (true)
+  {
+    uint_t d;
+
+    if      ((*p >= '0') && (*p <= '9'))         d = *p - '0';
+    else if (hex && (*p >= 'a') && (*p <= 'f'))  d = *p - 'a' + 10;
+    else if (hex && (*p >= 'A') && (*p <= 'F'))  d = *p - 'A' + 10;
+    else break;
+
+    if (val > ((~(uint64_t)0 - d) / base)) overflow = true;
+    val = val * base + d;
+    p++;
+  }
+
+  res = val;
+
+  return ((p != p1) && !overflow);
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Return true if only whitespace remains at p
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLValues::IsEndOfNumber(const char *p)
+{
+  while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+
+  return !*p;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Parse optionally signed integer, skipping leading and trailing whitespace
+ *
+ * @return true if the whole string was a valid integer that did not overflow
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLValues::ParseInteger(const char *str, uint64_t& res, bool& neg, bool hex)
+{
+  const char *p = str;
+
+  while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+
+  neg = false;
+  if      (*p == '-') {neg = true; p++;}
+  else if (*p == '+') p++;
+
+  // optional 0x prefix for hex values
+  if (hex && (p[0] == '0') && ((p[1] == 'x') || (p[1] == 'X'))) p += 2;
+
+  return (ParseDigits(p, res, hex) && IsEndOfNumber(p));
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Locale independent number parsing
+ *
+ * @param str string to parse (leading and trailing whitespace is skipped)
+ * @param res variable to be set (unchanged if the string is not a valid number)
+ *
+ * @return true if the whole string was a valid number
+ *
+ * @note decimal numbers whose mantissa fits in 53 bits with a power-of-ten exponent
+ * @note of at most 22 are converted exactly with a single multiply or divide, without
+ * @note allocating memory; other decimal numbers (and inf and nan) are converted by strtod()
+ * @note with the decimal point translated to that of the current locale
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLValues::ParseNumber(const char *str, double& res)
+{
+  static const double powers[] = {
+    1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+    1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+    1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22,
+  };
+  const char *p = str, *start;
+  uint64_t mantissa = 0;
+  sint_t   exponent = 0;
+  uint_t   digits = 0, sigdigits = 0;
+  bool     neg = false, exact = true, success = false;
+
+  while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+
+  start = p;
+
+  if      (*p == '-') {neg = true; p++;}
+  else if (*p == '+') p++;
+
+  // integer part
+  for (; (*p >= '0') && (*p <= '9'); p++, digits++)
+  {
+    if (mantissa || (*p != '0')) sigdigits++;
+    if (sigdigits <= 19) mantissa = mantissa * 10 + (*p - '0');
+    else exact = false;
+  }
+
+  // fractional part
+  if (*p == '.')
+  {
+    for (p++; (*p >= '0') && (*p <= '9'); p++, digits++)
+    {
+      if (mantissa || (*p != '0')) sigdigits++;
+      if (sigdigits <= 19)
+      {
+        mantissa = mantissa * 10 + (*p - '0');
+        exponent--;
+      }
+      else exact = false;
+    }
+  }
+
+  // exponent (only consumed if followed by at least one digit)
+  if (digits && ((*p == 'e') || (*p == 'E')))
+  {
+    const char *p1 = p + 1;
+    uint64_t e;
+    bool     eneg = false;
+
+    if      (*p1 == '-') {eneg = true; p1++;}
+    else if (*p1 == '+') p1++;
+
+    if ((*p1 >= '0') && (*p1 <= '9'))
+    {
+      if (ParseDigits(p1, e) && (e <= 1000)) exponent += eneg ? -(sint_t)e : (sint_t)e;
+      else exact = false;
+      p = p1;
+    }
+  }
+
+  if (!digits)
+  {
+    // no digits: only inf and nan (which do not depend on the locale) are accepted
+    if (((*p | 0x20) == 'i') || ((*p | 0x20) == 'n'))
+    {
+      char   *end;
+      double val = strtod(start, &end);
+
+      if ((end != start) && IsEndOfNumber(end))
+      {
+        res     = val;
+        success = true;
+      }
+    }
+  }
+  // anything after the number other than whitespace makes the value invalid
+  else if (!IsEndOfNumber(p)) success = false;
+  else if (exact && (mantissa <= ((uint64_t)1 << 53)) && (exponent >= -22) && (exponent <= 22))
+  {
+    double val = (double)mantissa;
+
+    if (exponent < 0) val /= powers[-exponent];
+    else              val *= powers[exponent];
+
+    res     = neg ? -val : val;
+    success = true;
+  }
+  else
+  {
+    // out of range or too many digits: strtod() uses the locale's decimal point so translate it
+    std::string num(start, p - start);
+    const char  *dp = localeconv()->decimal_point;
+    char        *end;
+    double      val;
+    size_t      pos;
+
+    if (((pos = num.find('.')) < std::string::npos) && (strcmp(dp, ".") != 0)) num.replace(pos, 1, dp);
+
+    val = strtod(num.c_str(), &end);
+    if (end == (num.c_str() + num.size()))
+    {
+      res     = val;
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+bool XMLValues::ParseNumber(const char *str, float& res)
+{
+  double val;
+  bool   success = false;
+
+  if (ParseNumber(str, val))
+  {
+    res     = (float)val;
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Locale independent, allocation free number parsing
+ *
+ * @param str string to parse (leading and trailing whitespace is skipped)
+ * @param res variable to be set (unchanged if the string is not a valid number)
+ * @param hex true if value is expected to be hexidecimal
+ *
+ * @return true if the whole string was a valid number
+ *
+ * @note out of range values fall back to sscanf() (whose integer conversions do not depend on the locale)
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLValues::ParseNumber(const char *str, uint_t& res, bool hex)
+{
+  uint64_t val;
+  uint_t   val2;
+  int      n = 0;
+  bool     neg, success = false;
+
+  if (ParseInteger(str, val, neg, hex) && !neg && (val <= 0xffffffff))
+  {
+    res     = (uint_t)val;
+    success = true;
+  }
+  else if ((hex ? (sscanf(str, "%x%n", &val2, &n) > 0) : (sscanf(str, "%u%n", &val2, &n) > 0)) && IsEndOfNumber(str + n))
+  {
+    res     = val2;
+    success = true;
+  }
+
+  return success;
+}
+
+bool XMLValues::ParseNumber(const char *str, ulong_t& res, bool hex)
+{
+  uint64_t val;
+  ulong_t  val2;
+  int      n = 0;
+  bool     neg, success = false;
+
+  if (ParseInteger(str, val, neg, hex) && !neg && (val <= (uint64_t)(~(ulong_t)0)))
+  {
+    res     = (ulong_t)val;
+    success = true;
+  }
+  else if ((hex ? (sscanf(str, "%lx%n", &val2, &n) > 0) : (sscanf(str, "%lu%n", &val2, &n) > 0)) && IsEndOfNumber(str + n))
+  {
+    res     = val2;
+    success = true;
+  }
+
+  return success;
+}
+
+bool XMLValues::ParseNumber(const char *str, sint_t& res, bool hex)
+{
+  uint64_t val;
+  sint_t   val2;
+  int      n = 0;
+  bool     neg, success = false;
+
+  // hex values are read as unsigned and converted
+  if (ParseInteger(str, val, neg, hex) && !neg && hex && (val <= 0xffffffff))
+  {
+    res     = (sint_t)(uint_t)val;
+    success = true;
+  }
+  else if (!hex && ParseInteger(str, val, neg, hex) && (val <= (neg ? 0x80000000 : 0x7fffffff)))
+  {
+    res     = neg ? (sint_t)(0 - (uint_t)val) : (sint_t)val;
+    success = true;
+  }
+  else if ((hex ? (sscanf(str, "%x%n", (uint_t *)&val2, &n) > 0) : (sscanf(str, "%d%n", &val2, &n) > 0)) && IsEndOfNumber(str + n))
+  {
+    res     = val2;
+    success = true;
+  }
+
+  return success;
+}
+
+bool XMLValues::ParseNumber(const char *str, slong_t& res, bool hex)
+{
+  const uint64_t maxval = (uint64_t)(~(ulong_t)0 >> 1);
+  uint64_t val;
+  slong_t  val2;
+  int      n = 0;
+  bool     neg, success = false;
+
+  // hex values are read as unsigned and converted
+  if (ParseInteger(str, val, neg, hex) && !neg && hex && (val <= (uint64_t)(~(ulong_t)0)))
+  {
+    res     = (slong_t)(ulong_t)val;
+    success = true;
+  }
+  else if (!hex && ParseInteger(str, val, neg, hex) && (val <= (neg ? maxval + 1 : maxval)))
+  {
+    res     = neg ? (slong_t)(0 - (ulong_t)val) : (slong_t)val;
+    success = true;
+  }
+  else if ((hex ? (sscanf(str, "%lx%n", (ulong_t *)&val2, &n) > 0) : (sscanf(str, "%ld%n", &val2, &n) > 0)) && IsEndOfNumber(str + n))
+  {
+    res     = val2;
+    success = true;
+  }
+
+  return success;
+}
+
+/*--------------------------------------------------------------------------------*/
+/** Allocation free time parsing
+ *
+ * @param str string to parse
+ * @param res time in ns
+ *
+ * @return true if time was parsed
+ *
+ * @note handles 'hh:mm:ss.fffff' and 'hh:mm:ss.nnnnnSddddd' (nnnnn samples at ddddd Hz) directly,
+ * @note falling back to CalcTime() for anything else
+ */
+/*--------------------------------------------------------------------------------*/
+bool XMLValues::ParseTime(const char *str, uint64_t& res)
+{
+  const char *p = str;
+  uint64_t hr, mn, s, samples = 0, ns = 0, rate;
+  uint_t   digits = 0, n;
+  bool     success = false;
+
+  while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+
+  if (ParseDigits(p, hr) && (hr < 1000000) && (*p++ == ':') &&
+      ParseDigits(p, mn) && (mn < 1000000) && (*p++ == ':') &&
+      ParseDigits(p, s)  && (s  < 1000000) && (*p++ == '.'))
+  {
+    // read fractional part both as (up to 9 digits of) ns and as an integer (for sample based times)
+    for (; (*p >= '0') && (*p <= '9'); p++, digits++)
+    {
+      if (digits < 18) samples = samples * 10 + (*p - '0');
+      if (digits < 9)  ns      = ns      * 10 + (*p - '0');
+    }
+    for (n = digits; n < 9; n++) ns *= 10;
+
+    if (digits)
+    {
+      uint64_t t = (hr * 3600 + mn * 60 + s) * 1000000000;
+
+      if (*p == 'S')
+      {
+        // fraction is number of samples at given sample rate
+        p++;
+        if ((digits <= 18) && ParseDigits(p, rate) && rate && (rate <= 0xffffffff))
+        {
+          t += (samples / rate) * 1000000000 + ((samples % rate) * 1000000000 + (rate >> 1)) / rate;
+          success = true;
+        }
+      }
+      else
+      {
+        t += ns;
+        success = true;
+      }
+
+      while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+
+      // any trailing characters are left to CalcTime() to handle
+      if (success && !*p) res = t;
+      else success = false;
+    }
+  }
+
+  if (!success) success = CalcTime(res, str);
+
+  return success;
+}
+
 
 BBC_AUDIOTOOLBOX_END
@@ -23,6 +23,19 @@ public:
   /*--------------------------------------------------------------------------------*/
   XMLValue& operator = (const XMLValue& obj);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Comparison operators (names, values, attributes and sub-values must all match)
+   */
+  /*--------------------------------------------------------------------------------*/
+  bool operator == (const XMLValue& obj) const;
+  bool operator != (const XMLValue& obj) const {return !operator == (obj);}
+
+  /*--------------------------------------------------------------------------------*/
+  /** Swap contents with another value without copying any strings or sub-values
+   */
+  /*--------------------------------------------------------------------------------*/
+  void swap(XMLValue& obj);
+
   /*--------------------------------------------------------------------------------*/
   /** Set subvalues list
    */
@@ -35,6 +48,14 @@ public:
   /*--------------------------------------------------------------------------------*/
   void AddSubValues(const XMLValues& _subvalues);
 
+  /*--------------------------------------------------------------------------------*/
+  /** Move a set of sub values to the list without copying them
+   *
+   * @note _subvalues is left empty
+   */
+  /*--------------------------------------------------------------------------------*/
+  void MoveSubValues(XMLValues& _subvalues);
+
   /*--------------------------------------------------------------------------------*/
   /** Add a single sub value to the lsit
    */
@@ -118,18 +139,68 @@ protected:
   XMLValues *subvalues;   // list of sub-values  
 };
 
+/*--------------------------------------------------------------------------------*/
+/** List of XML values
+ *
+ * Short lists are searched directly, longer ones (see IndexThreshold) are looked up by name
+ * using a sorted index which is built on first lookup and then maintained as values are added
+ * and erased
+ *
+ * @note erase() is O(n) so loops removing many values should instead move the values kept
+ * @note to the front of the list (using XMLValue::swap()) and erase the rest with a single
+ * @note call to erase(first, last)
+ *
+ * @note the index is maintained by the functions below and is rebuilt if the list is
+ * @note modified via std::vector<XMLValue> directly; values MUST NOT be renamed in place
+ * @note once the list has been searched
+ *
+ * @note because the index is built by const lookups, the same list MUST NOT be searched
+ * @note from multiple threads simultaneously
+ */
+/*--------------------------------------------------------------------------------*/
 class XMLValues : public std::vector<XMLValue>
 {
 public:
-  XMLValues() : std::vector<XMLValue>() {}
+  XMLValues() : std::vector<XMLValue>(),
+                indexsize(0),
+                indexvalid(false) {}
+  XMLValues(const XMLValues& obj) : std::vector<XMLValue>(obj),
+                                    indexsize(0),
+                                    indexvalid(false) {}
   ~XMLValues() {}
 
+  /*--------------------------------------------------------------------------------*/
+  /** Assignment operator (the index is NOT copied)
+   */
+  /*--------------------------------------------------------------------------------*/
+  XMLValues& operator = (const XMLValues& obj) {std::vector<XMLValue>::operator = (obj); indexvalid = false; return *this;}
+
   /*--------------------------------------------------------------------------------*/
   /** Add a value to the internal list
    */
   /*--------------------------------------------------------------------------------*/
   void AddValue(const XMLValue& value);
-  
+
+  /*--------------------------------------------------------------------------------*/
+  /** Move a value to the end of the internal list without copying it
+   *
+   * @note value is left empty and MUST NOT be an item of this list
+   */
+  /*--------------------------------------------------------------------------------*/
+  void MoveValue(XMLValue& value);
+
+  /*--------------------------------------------------------------------------------*/
+  /** std::vector<> modifiers which maintain the index
+   *
+   * @note erase() moves subsequent values using XMLValue::swap() rather than copying them
+   */
+  /*--------------------------------------------------------------------------------*/
+  void     push_back(const XMLValue& value) {AddValue(value);}
+  iterator erase(iterator it);
+  iterator erase(iterator first, iterator last);
+  void     clear() {std::vector<XMLValue>::clear(); std::vector<uint_t>().swap(index); indexvalid = false;}
+  void     swap(XMLValues& obj) {std::vector<XMLValue>::swap(obj); indexvalid = obj.indexvalid = false;}
+
   /*--------------------------------------------------------------------------------*/
   /** Return ptr to value with specified name or NULL
    */
@@ -166,6 +237,110 @@ public:
   bool SetValue(slong_t& res, const std::string& name, bool hex = false);
   bool SetValue(bool& res, const std::string& name);
   bool SetValueTime(uint64_t& res, const std::string& name);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Locale independent number parsing
+   *
+   * @param str string to parse (leading and trailing whitespace is skipped)
+   * @param res variable to be set (unchanged if the string is not a valid number)
+   * @param hex true if value is expected to be hexidecimal
+   *
+   * @return true if the whole string was a valid number
+   *
+   * @note plain decimal (and hex) numbers are handled directly without allocating memory,
+   * @note anything else (exponents out of range, too many digits, inf and nan) falls back to
+   * @note strtod() or sscanf() without depending on the locale
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool ParseNumber(const char *str, double& res);
+  static bool ParseNumber(const char *str, float& res);
+  static bool ParseNumber(const char *str, uint_t& res, bool hex = false);
+  static bool ParseNumber(const char *str, ulong_t& res, bool hex = false);
+  static bool ParseNumber(const char *str, sint_t& res, bool hex = false);
+  static bool ParseNumber(const char *str, slong_t& res, bool hex = false);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Allocation free time parsing
+   *
+   * @param str string to parse
+   * @param res time in ns
+   *
+   * @return true if time was parsed
+   *
+   * @note handles 'hh:mm:ss.fffff' and 'hh:mm:ss.nnnnnSddddd' (nnnnn samples at ddddd Hz) directly,
+   * @note falling back to CalcTime() for anything else
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool ParseTime(const char *str, uint64_t& res);
+
+protected:
+  /*--------------------------------------------------------------------------------*/
+  /** Parse decimal or hex digits at p, updating p
+   *
+   * @return true if at least one digit was found and the value did not overflow
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool ParseDigits(const char *& p, uint64_t& res, bool hex = false);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return true if only whitespace remains at p
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool IsEndOfNumber(const char *p);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Parse optionally signed integer, skipping leading and trailing whitespace
+   *
+   * @return true if the whole string was a valid integer that did not overflow
+   */
+  /*--------------------------------------------------------------------------------*/
+  static bool ParseInteger(const char *str, uint64_t& res, bool& neg, bool hex);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Return index of first value with specified name or -1
+   */
+  /*--------------------------------------------------------------------------------*/
+  sint_t Find(const std::string& name) const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** (Re)build index
+   */
+  /*--------------------------------------------------------------------------------*/
+  void BuildIndex() const;
+
+  /*--------------------------------------------------------------------------------*/
+  /** Remove value n from index
+   */
+  /*--------------------------------------------------------------------------------*/
+  void RemoveFromIndex(uint_t n);
+
+  /*--------------------------------------------------------------------------------*/
+  /** Orders index entries by name of value then position
+   */
+  /*--------------------------------------------------------------------------------*/
+  class IndexCompare
+  {
+  public:
+    IndexCompare(const XMLValues& _values) : values(_values) {}
+
+    bool operator () (uint_t a, uint_t b) const
+    {
+      int res = values[a].name.compare(values[b].name);
+      return (res < 0) || ((res == 0) && (a < b));
+    }
+    bool operator () (uint_t a, const std::string& name) const {return (values[a].name < name);}
+    bool operator () (const std::string& name, uint_t b) const {return (name < values[b].name);}
+
+  protected:
+    const XMLValues& values;
+  };
+
+protected:
+  mutable std::vector<uint_t> index;    // positions of values ordered by name (then position)
+  mutable uint_t              indexsize;        // size of list when index was last valid
+  mutable bool                indexvalid;
+
+  static const uint_t IndexThreshold = 16;      // lists shorter than this are not indexed
 };
 
 BBC_AUDIOTOOLBOX_END